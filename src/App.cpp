@@ -22,12 +22,16 @@
  */
 
 
+#include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
 #include <uv.h>
 
 
 #include "api/Api.h"
+#include "api/ApiCommand.h"
 #include "App.h"
+#include "Cgroup.h"
 #include "Console.h"
 #include "Cpu.h"
 #include "crypto/CryptoNight.h"
@@ -36,10 +40,16 @@
 #include "log/Log.h"
 #include "Mem.h"
 #include "net/Network.h"
+#include "net/Url.h"
 #include "Options.h"
 #include "Platform.h"
+#include "Startup.h"
+#include "State.h"
 #include "Summary.h"
+#include "Topology.h"
 #include "version.h"
+#include "workers/Governor.h"
+#include "workers/Hashrate.h"
 #include "workers/Workers.h"
 
 
@@ -55,6 +65,39 @@
 App *App::m_self = nullptr;
 
 
+/**
+ * @brief Identity of executable and CPU, cached self-test result valid only while it stays the same.
+ */
+static void buildId(char *out, size_t size)
+{
+    uint64_t hash = 0xcbf29ce484222325ULL;
+    auto add = [&hash](const void *data, size_t len) {
+        for (size_t i = 0; i < len; ++i) {
+            hash = (hash ^ static_cast<const uint8_t*>(data)[i]) * 0x100000001b3ULL;
+        }
+    };
+
+    add(APP_VERSION, sizeof(APP_VERSION));
+    add(Cpu::brand(), strlen(Cpu::brand()));
+
+    char path[512];
+    size_t len = sizeof(path);
+    uv_fs_t req;
+
+    if (uv_exepath(path, &len) == 0) {
+        if (uv_fs_stat(uv_default_loop(), &req, path, nullptr) == 0) {
+            add(&req.statbuf.st_size, sizeof(req.statbuf.st_size));
+            add(&req.statbuf.st_mtim.tv_sec, sizeof(req.statbuf.st_mtim.tv_sec));
+            add(&req.statbuf.st_mtim.tv_nsec, sizeof(req.statbuf.st_mtim.tv_nsec));
+        }
+
+        uv_fs_req_cleanup(&req);
+    }
+
+    snprintf(out, size, "%016llx", (unsigned long long) hash);
+}
+
+
 
 App::App(int argc, char **argv) :
     m_console(nullptr),
@@ -64,7 +107,11 @@ App::App(int argc, char **argv) :
 {
     m_self = this;
 
+    Startup::begin();
+
     Cpu::init();
+    Topology::init();
+    Cgroup::init();
     m_options = Options::parse(argc, argv);
     if (!m_options) {
         return;
@@ -120,32 +167,53 @@ int App::exec()
     uv_signal_start(&m_sigINT,  App::onSignal, SIGINT);
     uv_signal_start(&m_sigTERM, App::onSignal, SIGTERM);
 
+    if (m_options->verify()) {
+        return CryptoNight::verify() ? 0 : 1;
+    }
+
     background();
 
+    if (m_options->stateFile()) {
+        loadState();
+    }
+
+    // only DNS lookup (libuv threadpool) overlaps with self-test and memory setup,
+    // TCP connect, login and first job are handled once event loop starts.
+    if (!m_options->benchmark()) {
+        m_network->connect();
+    }
+
     if (!CryptoNight::init(m_options->algo(), m_options->algoVariant())) {
         LOG_ERR("\"%s\" hash self-test failed.", m_options->algoName());
         return 1;
     }
 
+    Startup::mark(Startup::SelfTest);
+
     Mem::allocate(m_options->algo(), m_options->threads(), m_options->doubleHash(), m_options->hugePages());
+    Startup::mark(Startup::Memory);
+
     Summary::print();
 
+    Workers::start(m_options->affinity(), m_options->priority(), m_options->benchmark());
+    Governor::start(m_options->loadTarget());
+
 #   ifndef XMRIG_NO_API
     if (m_options->apiPort())
-        Api::start();
+        Api::start(this);
 #   endif
 
 #   ifndef XMRIG_NO_HTTPD
-    m_httpd = new Httpd(m_options->apiPort(), m_options->apiToken());
+    m_httpd = new Httpd(m_options->apiPort(), m_options->apiToken(), m_options->apiRestricted());
     m_httpd->start();
 #   endif
 
-    Workers::start(m_options->affinity(), m_options->priority(), m_options->benchmark());
-
     if (m_options->benchmark())
         LOG_NOTICE(m_options->colors() ? "\x1B[01;33mBENCHMARK MODE!" : "BENCHMARK MODE!");
-    else
-        m_network->connect();
+
+    if (m_options->stateFile()) {
+        restoreState();
+    }
 
     const int r = uv_run(uv_default_loop(), UV_RUN_DEFAULT);
     uv_loop_close(uv_default_loop());
@@ -160,6 +228,57 @@ int App::exec()
 }
 
 
+void App::onApiCommand(const ApiCommand &command)
+{
+    switch (command.type) {
+    case ApiCommand::Pause:
+        if (Workers::isEnabled()) {
+            LOG_INFO(m_options->colors() ? "\x1B[01;33mpaused\x1B[0m by API" : "paused by API");
+            Workers::setEnabled(false);
+        }
+        break;
+
+    case ApiCommand::Resume:
+        if (!Workers::isEnabled()) {
+            LOG_INFO(m_options->colors() ? "\x1B[01;32mresumed\x1B[0m by API" : "resumed by API");
+            Workers::setEnabled(true);
+        }
+        break;
+
+    case ApiCommand::SetPool:
+        if (m_network->setPool(command.value)) {
+            LOG_INFO("switch to pool #%d requested by API", command.value);
+        }
+        else {
+            LOG_WARN("pool #%d can't be selected", command.value);
+        }
+        break;
+
+    case ApiCommand::SetThreads:
+        Workers::setThreads(command.value);
+        LOG_INFO("threads: %d", Workers::threads());
+        break;
+
+    case ApiCommand::SetThreadEnabled:
+        Workers::setThreadEnabled(command.index, command.value != 0);
+        LOG_INFO("thread #%d %s by API", command.index, command.value ? "enabled" : "disabled");
+        break;
+
+    case ApiCommand::SetAlgoVariant:
+        if (Workers::setAlgoVariant(command.value)) {
+            LOG_INFO("algo variant changed to %d", command.value);
+        }
+        else {
+            LOG_ERR("algo variant %d self-test failed, keep %d", command.value, m_options->algoVariant());
+        }
+        break;
+
+    default:
+        break;
+    }
+}
+
+
 void App::onConsoleCommand(char command)
 {
     switch (command) {
@@ -202,13 +321,125 @@ void App::onConsoleCommand(char command)
 
 void App::close()
 {
+    if (m_options->stateFile()) {
+        saveState();
+        uv_timer_stop(&m_stateTimer);
+    }
+
     m_network->stop();
+    Governor::stop();
     Workers::stop();
 
+#   ifndef XMRIG_NO_API
+    Api::stop();
+#   endif
+
     uv_stop(uv_default_loop());
 }
 
 
+/**
+ * @brief Load state file before self-test and memory allocation, tuning results applied to options.
+ */
+void App::loadState()
+{
+    buildId(m_state.build, sizeof(m_state.build));
+    snprintf(m_state.cpu, sizeof(m_state.cpu), "%s", Cpu::brand());
+    m_state.algo    = m_options->algo();
+    m_state.av      = m_options->algoVariant();
+    m_state.threads = m_options->threads();
+
+    State::Data saved;
+    if (!State::load(m_options->stateFile(), saved)) {
+        return;
+    }
+
+    if (saved.isTuned(m_state.algo, m_state.cpu, m_state.av, m_state.threads)) {
+        // same restrictions as runtime change from API.
+        const bool doubleHash = saved.tunedAv == Options::AV2_AESNI_DOUBLE || saved.tunedAv == Options::AV4_SOFT_AES_DOUBLE;
+
+        if (saved.tunedAv < Options::AV_MAX && doubleHash == m_options->doubleHash() && (saved.tunedAv > Options::AV2_AESNI_DOUBLE || Cpu::hasAES())) {
+            m_options->setAlgoVariant(saved.tunedAv);
+        }
+
+        if (saved.tunedThreads <= Cpu::threads() || saved.tunedThreads <= m_state.threads) {
+            const int limit = m_options->maxThreads();
+
+            m_options->setThreads((limit && saved.tunedThreads > limit) ? limit : saved.tunedThreads);
+        }
+    }
+
+    if (saved.verified && strcmp(saved.build, m_state.build) == 0) {
+        CryptoNight::setVerified(saved.verified);
+        LOG_INFO("use cached self-test result for build %s", m_state.build);
+    }
+
+    memcpy(m_state.pool, saved.pool, sizeof(m_state.pool));
+    m_state.average  = saved.average;
+    m_state.highest  = saved.highest;
+    m_state.topDiff  = saved.topDiff;
+    m_state.accepted = saved.accepted;
+    m_state.failures = saved.failures;
+    m_state.jobs     = saved.jobs;
+    m_state.rejected = saved.rejected;
+    m_state.total    = saved.total;
+
+    LOG_INFO("state loaded from \"%s\", av=%d, threads=%d", m_options->stateFile(), m_options->algoVariant(), m_options->threads());
+}
+
+
+/**
+ * @brief Counters applied after workers and network started, then state saved periodically.
+ */
+void App::restoreState()
+{
+    NetworkState &network = m_network->state();
+    network.accepted = m_state.accepted;
+    network.failures = m_state.failures;
+    network.jobs     = m_state.jobs;
+    network.rejected = m_state.rejected;
+    network.total    = m_state.total;
+    network.topDiff  = m_state.topDiff;
+
+    Workers::hashrate()->restore(m_state.highest, m_state.average);
+
+    // last pool is a hint only, failover order stays as configured.
+    if (m_state.pool[0] && !m_options->benchmark()) {
+        LOG_INFO("last active pool %s", m_state.pool);
+    }
+
+    uv_timer_init(uv_default_loop(), &m_stateTimer);
+    m_stateTimer.data = this;
+
+    uv_timer_start(&m_stateTimer, App::onStateTimer, State::kSaveInterval, State::kSaveInterval);
+}
+
+
+void App::saveState()
+{
+    const NetworkState &network = m_network->state();
+    const Hashrate *hashrate    = Workers::hashrate();
+
+    m_state.tunedAv      = m_options->algoVariant();
+    m_state.tunedThreads = Workers::threads();
+    m_state.average      = hashrate->average();
+    m_state.highest      = hashrate->highest();
+    m_state.accepted     = network.accepted;
+    m_state.failures     = network.failures;
+    m_state.jobs         = network.jobs;
+    m_state.rejected     = network.rejected;
+    m_state.total        = network.total;
+    m_state.topDiff      = network.topDiff;
+    m_state.verified     = CryptoNight::verified();
+
+    if (network.pool[0]) {
+        memcpy(m_state.pool, network.pool, sizeof(m_state.pool));
+    }
+
+    State::save(m_options->stateFile(), m_state);
+}
+
+
 void App::onSignal(uv_signal_t *handle, int signum)
 {
     switch (signum)
@@ -232,3 +463,9 @@ void App::onSignal(uv_signal_t *handle, int signum)
     uv_signal_stop(handle);
     m_self->close();
 }
+
+
+void App::onStateTimer(uv_timer_t *handle)
+{
+    static_cast<App*>(handle->data)->saveState();
+}
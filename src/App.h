@@ -28,7 +28,9 @@
 #include <uv.h>
 
 
+#include "interfaces/IApiListener.h"
 #include "interfaces/IConsoleListener.h"
+#include "State.h"
 
 
 class Console;
@@ -37,7 +39,7 @@ class Network;
 class Options;
 
 
-class App : public IConsoleListener
+class App : public IApiListener, public IConsoleListener
 {
 public:
   App(int argc, char **argv);
@@ -46,13 +48,18 @@ public:
   int exec();
 
 protected:
+  void onApiCommand(const ApiCommand &command) override;
   void onConsoleCommand(char command) override;
 
 private:
   void background();
   void close();
+  void loadState();
+  void restoreState();
+  void saveState();
 
   static void onSignal(uv_signal_t *handle, int signum);
+  static void onStateTimer(uv_timer_t *handle);
 
   static App *m_self;
 
@@ -60,9 +67,11 @@ private:
   Httpd *m_httpd;
   Network *m_network;
   Options *m_options;
+  State::Data m_state;
   uv_signal_t m_sigHUP;
   uv_signal_t m_sigINT;
   uv_signal_t m_sigTERM;
+  uv_timer_t m_stateTimer;
 };
 
 
@@ -36,7 +36,7 @@
 
 void App::background()
 {
-    if (m_options->affinity() != -1L) {
+    if (!m_options->affinity().isEmpty()) {
         Cpu::setAffinity(-1, m_options->affinity());
     }
 
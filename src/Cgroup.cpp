@@ -0,0 +1,292 @@
+/* XMRig
+ * Copyright 2010      Jeff Garzik <jgarzik@pobox.com>
+ * Copyright 2012-2014 pooler      <pooler@litecoinpool.org>
+ * Copyright 2014      Lucas Jones <https://github.com/lucasjones>
+ * Copyright 2014-2016 Wolf9466    <https://github.com/OhGodAPet>
+ * Copyright 2016      Jay D Dee   <jayddee246@gmail.com>
+ * Copyright 2016-2017 XMRig       <support@xmrig.com>
+ *
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#ifdef __linux__
+#   include <unistd.h>
+#endif
+
+
+#include "Cgroup.h"
+#include "Cpu.h"
+#include "CpuSet.h"
+
+
+char Cgroup::m_mount[CONTROLLER_MAX][64] = { { 0 } };
+char Cgroup::m_path[CONTROLLER_MAX][256] = { { 0 } };
+int Cgroup::m_cpus                       = -1;
+int Cgroup::m_version                    = 0;
+int64_t Cgroup::m_cpuQuota               = -1;
+int64_t Cgroup::m_hugetlbLimit           = -1;
+int64_t Cgroup::m_memoryLimit            = -1;
+int64_t Cgroup::m_memoryUsage            = -1;
+
+
+#ifdef __linux__
+static const char *kControllers[] = { "cpu", "cpuset", "memory", "hugetlb" };
+
+
+static bool readFile(const char *dir, const char *name, char *buf, size_t size)
+{
+    char path[384];
+    snprintf(path, sizeof(path), "%s/%s", dir, name);
+
+    FILE *fp = fopen(path, "r");
+    if (!fp) {
+        return false;
+    }
+
+    const size_t read = fread(buf, 1, size - 1, fp);
+    fclose(fp);
+
+    buf[read] = '\0';
+    return read > 0;
+}
+
+
+/**
+ * @brief Plain byte limit, "max" in v2 and huge page aligned LONG_MAX in v1 mean no limit.
+ */
+static int64_t readLimit(const char *dir, const char *name)
+{
+    char buf[32];
+    if (!readFile(dir, name, buf, sizeof(buf)) || strncmp(buf, "max", 3) == 0) {
+        return -1;
+    }
+
+    const int64_t value = strtoll(buf, nullptr, 10);
+    return value >= (1LL << 60) ? -1 : value;
+}
+
+
+static int64_t readCpuV1(const char *dir, const char *)
+{
+    char buf[32];
+    if (!readFile(dir, "cpu.cfs_quota_us", buf, sizeof(buf))) {
+        return -1;
+    }
+
+    const int64_t quota = strtoll(buf, nullptr, 10);
+    if (quota <= 0 || !readFile(dir, "cpu.cfs_period_us", buf, sizeof(buf))) {
+        return -1;
+    }
+
+    const int64_t period = strtoll(buf, nullptr, 10);
+    return period > 0 ? quota * 1000 / period : -1;
+}
+
+
+static int64_t readCpuV2(const char *dir, const char *)
+{
+    char buf[64];
+    if (!readFile(dir, "cpu.max", buf, sizeof(buf)) || strncmp(buf, "max", 3) == 0) {
+        return -1;
+    }
+
+    char *end = nullptr;
+    const int64_t quota  = strtoll(buf, &end, 10);
+    const int64_t period = strtoll(end, nullptr, 10);
+
+    return (quota > 0 && period > 0) ? quota * 1000 / period : -1;
+}
+
+
+static int64_t readCpus(const char *dir, const char *name)
+{
+    char buf[4096];
+    CpuSet set;
+
+    if (!readFile(dir, name, buf, sizeof(buf)) || !set.parseList(buf)) {
+        return -1;
+    }
+
+    return set.count();
+}
+
+
+#endif
+
+
+bool Cgroup::isLimited()
+{
+    return m_cpuQuota > 0 || m_memoryLimit >= 0 || m_hugetlbLimit >= 0 || (m_cpus > 0 && m_cpus < Cpu::threads());
+}
+
+
+/**
+ * @brief Whole CPUs available to the process, quota rounded down, 0 if not limited.
+ */
+int Cgroup::cpuLimit()
+{
+    int limit = m_cpus > 0 ? m_cpus : 0;
+
+    if (m_cpuQuota > 0) {
+        const int quota = m_cpuQuota < 1000 ? 1 : (int) (m_cpuQuota / 1000);
+        if (!limit || quota < limit) {
+            limit = quota;
+        }
+    }
+
+    return limit;
+}
+
+
+/**
+ * @brief Threads fitting into CPU and memory budget, one scratchpad reserved as in Mem::allocate, 0 if not limited.
+ */
+int Cgroup::maxThreads(size_t scratchpad)
+{
+    int limit = cpuLimit();
+
+    const int64_t available = memoryAvailable();
+    if (available >= 0) {
+        int64_t count = available / (int64_t) scratchpad - 1;
+        if (count < 1) {
+            count = 1;
+        }
+
+        if (!limit || count < limit) {
+            limit = (int) count;
+        }
+    }
+
+    return limit;
+}
+
+
+int64_t Cgroup::memoryAvailable()
+{
+    if (m_memoryLimit < 0) {
+        return -1;
+    }
+
+    const int64_t available = m_memoryLimit - (m_memoryUsage > 0 ? m_memoryUsage : 0);
+    return available > 0 ? available : 0;
+}
+
+
+void Cgroup::init()
+{
+#   ifdef __linux__
+    FILE *fp = fopen("/proc/self/cgroup", "r");
+    if (!fp) {
+        return;
+    }
+
+    m_version = access("/sys/fs/cgroup/cgroup.controllers", F_OK) == 0 ? 2 : 1;
+
+    char line[512];
+    while (fgets(line, sizeof(line), fp)) {
+        line[strcspn(line, "\n")] = '\0';
+
+        char *controllers = strchr(line, ':');
+        char *path        = controllers ? strchr(controllers + 1, ':') : nullptr;
+        if (!path) {
+            continue;
+        }
+
+        *controllers++ = '\0';
+        *path++        = '\0';
+
+        for (int i = 0; i < CONTROLLER_MAX; ++i) {
+            if (m_version == 2) {
+                if (strcmp(line, "0") == 0 && *controllers == '\0') {
+                    snprintf(m_mount[i], sizeof(m_mount[i]), "/sys/fs/cgroup");
+                    snprintf(m_path[i], sizeof(m_path[i]), "%s", path);
+                }
+
+                continue;
+            }
+
+            const size_t len = strlen(kControllers[i]);
+            for (const char *p = controllers; p && *p; p = strchr(p, ',') ? strchr(p, ',') + 1 : nullptr) {
+                if (strncmp(p, kControllers[i], len) == 0 && (p[len] == ',' || p[len] == '\0')) {
+                    snprintf(m_mount[i], sizeof(m_mount[i]), "/sys/fs/cgroup/%s", kControllers[i]);
+                    snprintf(m_path[i], sizeof(m_path[i]), "%s", path);
+                    break;
+                }
+            }
+        }
+    }
+
+    fclose(fp);
+
+    if (m_version == 2) {
+        m_cpuQuota     = walk(CPU,     "cpu.max", readCpuV2);
+        m_cpus         = (int) walk(CPUSET, "cpuset.cpus.effective", readCpus);
+        m_memoryLimit  = walk(MEMORY,  "memory.max", readLimit);
+        m_memoryUsage  = walk(MEMORY,  "memory.current", readLimit);
+        m_hugetlbLimit = walk(HUGETLB, "hugetlb.2MB.max", readLimit);
+    }
+    else {
+        m_cpuQuota     = walk(CPU,     "cpu.cfs_quota_us", readCpuV1);
+        m_cpus         = (int) walk(CPUSET, "cpuset.effective_cpus", readCpus);
+        m_memoryLimit  = walk(MEMORY,  "memory.limit_in_bytes", readLimit);
+        m_memoryUsage  = walk(MEMORY,  "memory.usage_in_bytes", readLimit);
+        m_hugetlbLimit = walk(HUGETLB, "hugetlb.2MB.limit_in_bytes", readLimit);
+
+        if (m_cpus < 0) {
+            m_cpus = (int) walk(CPUSET, "cpuset.cpus", readCpus);
+        }
+    }
+#   endif
+}
+
+
+/**
+ * @brief Smallest value reported by group and its ancestors up to mount root.
+ *
+ * Inside container namespace path is usually "/" and only mount root is checked.
+ */
+int64_t Cgroup::walk(Controller controller, const char *name, Reader reader)
+{
+    if (!m_mount[controller][0]) {
+        return -1;
+    }
+
+    char dir[sizeof(m_mount[0]) + sizeof(m_path[0])];
+    snprintf(dir, sizeof(dir), "%.63s%.255s", m_mount[controller], m_path[controller]);
+
+    const size_t root = strlen(m_mount[controller]);
+    int64_t result    = -1;
+
+    while (true) {
+        const int64_t value = reader(dir, name);
+        if (value >= 0 && (result < 0 || value < result)) {
+            result = value;
+        }
+
+        char *slash = strrchr(dir + root, '/');
+        if (!slash) {
+            break;
+        }
+
+        *slash = '\0';
+    }
+
+    return result;
+}
@@ -0,0 +1,77 @@
+/* XMRig
+ * Copyright 2010      Jeff Garzik <jgarzik@pobox.com>
+ * Copyright 2012-2014 pooler      <pooler@litecoinpool.org>
+ * Copyright 2014      Lucas Jones <https://github.com/lucasjones>
+ * Copyright 2014-2016 Wolf9466    <https://github.com/OhGodAPet>
+ * Copyright 2016      Jay D Dee   <jayddee246@gmail.com>
+ * Copyright 2016-2017 XMRig       <support@xmrig.com>
+ *
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef __CGROUP_H__
+#define __CGROUP_H__
+
+
+#include <stddef.h>
+#include <stdint.h>
+
+
+/**
+ * CPU and memory budget of control group the process runs in, cgroup v1 and v2.
+ *
+ * Limits of all ancestor groups are taken into account, -1 means unlimited.
+ */
+class Cgroup
+{
+public:
+    static bool isLimited();
+    static int cpuLimit();
+    static int maxThreads(size_t scratchpad);
+    static int64_t memoryAvailable();
+    static void init();
+
+    static inline int cpus()              { return m_cpus; }
+    static inline int version()           { return m_version; }
+    static inline int64_t cpuQuota()      { return m_cpuQuota; } /* 1/1000 of CPU */
+    static inline int64_t hugetlbLimit()  { return m_hugetlbLimit; }
+    static inline int64_t memoryLimit()   { return m_memoryLimit; }
+    static inline int64_t memoryUsage()   { return m_memoryUsage; }
+
+private:
+    enum Controller {
+        CPU,
+        CPUSET,
+        MEMORY,
+        HUGETLB,
+        CONTROLLER_MAX
+    };
+
+    typedef int64_t (*Reader)(const char *dir, const char *name);
+
+    static int64_t walk(Controller controller, const char *name, Reader reader);
+
+    static char m_mount[CONTROLLER_MAX][64];
+    static char m_path[CONTROLLER_MAX][256];
+    static int m_cpus;
+    static int m_version;
+    static int64_t m_cpuQuota;
+    static int64_t m_hugetlbLimit;
+    static int64_t m_memoryLimit;
+    static int64_t m_memoryUsage;
+};
+
+
+#endif /* __CGROUP_H__ */
@@ -27,6 +27,7 @@
 #include <string.h>
 
 #include "Cpu.h"
+#include "Topology.h"
 
 
 bool Cpu::m_l2_exclusive = false;
@@ -56,7 +57,10 @@ int Cpu::optimalThreadsCount(int algo, bool doubleHash, int maxCpuUsage)
     int count = 0;
     const int size = (algo ? 1024 : 2048) * (doubleHash ? 2 : 1);
 
-    if (cache) {
+    if (Topology::isAvailable()) {
+        count = Topology::optimalThreadsCount(size);
+    }
+    else if (cache) {
         count = cache / size;
     }
     else {
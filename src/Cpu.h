@@ -28,6 +28,9 @@
 #include <stdint.h>
 
 
+class CpuSet;
+
+
 class Cpu
 {
 public:
@@ -39,7 +42,7 @@ public:
 
     static int optimalThreadsCount(int algo, bool doubleHash, int maxCpuUsage);
     static void init();
-    static void setAffinity(int id, uint64_t mask);
+    static void setAffinity(int id, const CpuSet &cpus);
 
     static inline bool hasAES()       { return (m_flags & AES) != 0; }
     static inline bool isX64()        { return (m_flags & X86_64) != 0; }
@@ -0,0 +1,256 @@
+/* XMRig
+ * Copyright 2010      Jeff Garzik <jgarzik@pobox.com>
+ * Copyright 2012-2014 pooler      <pooler@litecoinpool.org>
+ * Copyright 2014      Lucas Jones <https://github.com/lucasjones>
+ * Copyright 2014-2016 Wolf9466    <https://github.com/OhGodAPet>
+ * Copyright 2016      Jay D Dee   <jayddee246@gmail.com>
+ * Copyright 2016-2017 XMRig       <support@xmrig.com>
+ *
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include <ctype.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+
+#include "CpuSet.h"
+
+
+bool CpuSet::parse(const char *str)
+{
+    clear();
+
+    if (!str || !*str) {
+        return false;
+    }
+
+    if (str[0] == '0' && (str[1] == 'x' || str[1] == 'X')) {
+        return parseMask(str + 2);
+    }
+
+    // plain decimal number is legacy mask format.
+    if (strspn(str, "0123456789") == strlen(str)) {
+        setMask(strtoull(str, nullptr, 10));
+        return true;
+    }
+
+    return parseList(str);
+}
+
+
+/**
+ * @brief Parse cpulist format, also used for lists read from sysfs.
+ */
+bool CpuSet::parseList(const char *str)
+{
+    const char *p = str;
+
+    while (*p) {
+        char *end = nullptr;
+        const long first = strtol(p, &end, 10);
+        if (end == p || first < 0 || first >= kMaxCpus) {
+            return false;
+        }
+
+        long last = first;
+        p = end;
+
+        if (*p == '-') {
+            last = strtol(p + 1, &end, 10);
+            if (end == p + 1 || last < first || last >= kMaxCpus) {
+                return false;
+            }
+
+            p = end;
+        }
+
+        for (long i = first; i <= last; ++i) {
+            set((int) i);
+        }
+
+        if (*p == ',') {
+            p++;
+            continue;
+        }
+
+        // sysfs lists end with newline.
+        return *p == '\0' || isspace(*p);
+    }
+
+    return !isEmpty();
+}
+
+
+bool CpuSet::isSet(int cpu) const
+{
+    if (cpu < 0 || (size_t) (cpu / 64) >= m_bits.size()) {
+        return false;
+    }
+
+    return (m_bits[cpu / 64] >> (cpu % 64)) & 1;
+}
+
+
+int CpuSet::count() const
+{
+    int count = 0;
+    for (uint64_t word : m_bits) {
+        while (word) {
+            word &= word - 1;
+            count++;
+        }
+    }
+
+    return count;
+}
+
+
+int CpuSet::first() const
+{
+    return nth(0);
+}
+
+
+int CpuSet::last() const
+{
+    for (size_t i = m_bits.size(); i > 0; --i) {
+        const uint64_t word = m_bits[i - 1];
+        if (!word) {
+            continue;
+        }
+
+        for (int bit = 63; bit >= 0; --bit) {
+            if ((word >> bit) & 1) {
+                return (int) ((i - 1) * 64) + bit;
+            }
+        }
+    }
+
+    return -1;
+}
+
+
+/**
+ * @brief CPU number of index-th CPU in set, -1 if set is smaller.
+ */
+int CpuSet::nth(int index) const
+{
+    const int end = (int) m_bits.size() * 64;
+
+    for (int cpu = 0; cpu < end; ++cpu) {
+        if (isSet(cpu) && index-- == 0) {
+            return cpu;
+        }
+    }
+
+    return -1;
+}
+
+
+/**
+ * @brief Write set in cpulist format, ranges collapsed, output truncated to buffer size.
+ */
+size_t CpuSet::toString(char *buf, size_t size) const
+{
+    size_t pos     = 0;
+    const int end  = last();
+    buf[0]         = '\0';
+
+    for (int cpu = 0; cpu <= end && pos < size; ++cpu) {
+        if (!isSet(cpu)) {
+            continue;
+        }
+
+        int range = cpu;
+        while (isSet(range + 1)) {
+            range++;
+        }
+
+        const int written = range > cpu ? snprintf(buf + pos, size - pos, pos ? ",%d-%d" : "%d-%d", cpu, range)
+                                         : snprintf(buf + pos, size - pos, pos ? ",%d" : "%d", cpu);
+        if (written < 0) {
+            break;
+        }
+
+        pos += written;
+        cpu  = range;
+    }
+
+    return pos < size ? pos : size - 1;
+}
+
+
+/**
+ * @brief First 64 CPUs as bit mask, for platforms with mask based affinity API.
+ */
+uint64_t CpuSet::mask() const
+{
+    return m_bits.empty() ? 0 : m_bits[0];
+}
+
+
+void CpuSet::clear()
+{
+    m_bits.clear();
+}
+
+
+void CpuSet::set(int cpu)
+{
+    if (cpu < 0 || cpu >= kMaxCpus) {
+        return;
+    }
+
+    if ((size_t) (cpu / 64) >= m_bits.size()) {
+        m_bits.resize(cpu / 64 + 1, 0);
+    }
+
+    m_bits[cpu / 64] |= 1ULL << (cpu % 64);
+}
+
+
+void CpuSet::setMask(uint64_t mask)
+{
+    clear();
+
+    if (mask) {
+        m_bits.push_back(mask);
+    }
+}
+
+
+bool CpuSet::parseMask(const char *str)
+{
+    const size_t len = strlen(str);
+    if (len == 0 || len > kMaxCpus / 4 || strspn(str, "0123456789abcdefABCDEF") != len) {
+        return false;
+    }
+
+    for (size_t i = 0; i < len; ++i) {
+        const char c    = str[len - 1 - i];
+        const int digit = isdigit(c) ? c - '0' : tolower(c) - 'a' + 10;
+
+        for (int bit = 0; bit < 4; ++bit) {
+            if (digit & (1 << bit)) {
+                set((int) (i * 4) + bit);
+            }
+        }
+    }
+
+    return true;
+}
@@ -0,0 +1,63 @@
+/* XMRig
+ * Copyright 2010      Jeff Garzik <jgarzik@pobox.com>
+ * Copyright 2012-2014 pooler      <pooler@litecoinpool.org>
+ * Copyright 2014      Lucas Jones <https://github.com/lucasjones>
+ * Copyright 2014-2016 Wolf9466    <https://github.com/OhGodAPet>
+ * Copyright 2016      Jay D Dee   <jayddee246@gmail.com>
+ * Copyright 2016-2017 XMRig       <support@xmrig.com>
+ *
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef __CPUSET_H__
+#define __CPUSET_H__
+
+
+#include <stddef.h>
+#include <stdint.h>
+#include <vector>
+
+
+/**
+ * Set of logical CPUs of any size, parsed from cpulist ("0-63,128-191") or hex mask ("0xFF").
+ */
+class CpuSet
+{
+public:
+    constexpr static int kMaxCpus = 1 << 16;
+
+    bool parse(const char *str);
+    bool parseList(const char *str);
+    bool isSet(int cpu) const;
+    int count() const;
+    int first() const;
+    int last() const;
+    int nth(int index) const;
+    size_t toString(char *buf, size_t size) const;
+    uint64_t mask() const;
+    void clear();
+    void set(int cpu);
+    void setMask(uint64_t mask);
+
+    inline bool isEmpty() const { return last() < 0; }
+
+private:
+    bool parseMask(const char *str);
+
+    std::vector<uint64_t> m_bits;
+};
+
+
+#endif /* __CPUSET_H__ */
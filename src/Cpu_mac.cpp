@@ -40,6 +40,6 @@ void Cpu::init()
 }
 
 
-void Cpu::setAffinity(int id, uint64_t mask)
+void Cpu::setAffinity(int id, const CpuSet &cpus)
 {
 }
@@ -31,10 +31,12 @@
 #   include <cpuid.h>
 #endif
 
+#include <math.h>
 #include <string.h>
 
 
 #include "Cpu.h"
+#include "Topology.h"
 
 
 #define VENDOR_ID                  (0)
@@ -110,6 +112,15 @@ int Cpu::m_totalThreads = 0;
 
 int Cpu::optimalThreadsCount(int algo, bool doubleHash, int maxCpuUsage)
 {
+    if (Topology::isAvailable()) {
+        int count = Topology::optimalThreadsCount((algo ? 1024 : 2048) * (doubleHash ? 2 : 1));
+        if (((float) count / m_totalThreads * 100) > maxCpuUsage) {
+            count = (int) ceil((float) m_totalThreads * (maxCpuUsage / 100.0));
+        }
+
+        return count < 1 ? 1 : count;
+    }
+
     int count = m_totalThreads / 2;
     return count < 1 ? 1 : count;
 }
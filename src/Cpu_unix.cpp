@@ -37,6 +37,7 @@
 
 
 #include "Cpu.h"
+#include "CpuSet.h"
 
 
 #ifdef __FreeBSD__
@@ -54,26 +55,51 @@ void Cpu::init()
 }
 
 
-void Cpu::setAffinity(int id, uint64_t mask)
+void Cpu::setAffinity(int id, const CpuSet &cpus)
 {
+    const int count = cpus.last() + 1;
+    if (count <= 0) {
+        return;
+    }
+
+#   ifdef __FreeBSD__
     cpu_set_t set;
     CPU_ZERO(&set);
 
-    for (int i = 0; i < m_totalThreads; i++) {
-        if (mask & (1UL << i)) {
+    for (int i = 0; i < count && i < CPU_SETSIZE; i++) {
+        if (cpus.isSet(i)) {
             CPU_SET(i, &set);
         }
     }
 
+    if (id != -1) {
+        pthread_setaffinity_np(pthread_self(), sizeof(set), &set);
+    }
+#   else
+    cpu_set_t *set    = CPU_ALLOC(count);
+    const size_t size = CPU_ALLOC_SIZE(count);
+    if (!set) {
+        return;
+    }
+
+    CPU_ZERO_S(size, set);
+
+    for (int i = 0; i < count; i++) {
+        if (cpus.isSet(i)) {
+            CPU_SET_S(i, size, set);
+        }
+    }
+
     if (id == -1) {
-#       ifndef __FreeBSD__
-        sched_setaffinity(0, sizeof(&set), &set);
-#       endif
+        sched_setaffinity(0, size, set);
     } else {
 #       ifndef __ANDROID__
-        pthread_setaffinity_np(pthread_self(), sizeof(&set), &set);
+        pthread_setaffinity_np(pthread_self(), size, set);
 #       else
-        sched_setaffinity(gettid(), sizeof(&set), &set);
+        sched_setaffinity(gettid(), size, set);
 #       endif
     }
+
+    CPU_FREE(set);
+#   endif
 }
@@ -26,6 +26,7 @@
 
 
 #include "Cpu.h"
+#include "CpuSet.h"
 
 
 void Cpu::init()
@@ -41,8 +42,14 @@ void Cpu::init()
 }
 
 
-void Cpu::setAffinity(int id, uint64_t mask)
+void Cpu::setAffinity(int id, const CpuSet &cpus)
 {
+    // without processor groups support only first 64 CPUs are addressable.
+    const DWORD_PTR mask = (DWORD_PTR) cpus.mask();
+    if (!mask) {
+        return;
+    }
+
     if (id == -1) {
         SetProcessAffinityMask(GetCurrentProcess(), mask);
     }
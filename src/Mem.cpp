@@ -34,12 +34,26 @@ bool Mem::m_doubleHash = false;
 int Mem::m_algo        = 0;
 int Mem::m_flags       = 0;
 int Mem::m_threads     = 0;
+std::atomic<int> Mem::m_lockFailures(0);
 uint8_t *Mem::m_memory = nullptr;
 uint32_t Mem::m_hugepages_errorcode = 0;
 
 
+/**
+ * @brief Returns context for thread, threads started after allocate() get own standalone scratchpad.
+ *
+ * Called from worker thread after affinity set, so scratchpad pages are faulted in parallel
+ * and placed on NUMA node of the thread (first touch).
+ */
 cryptonight_ctx *Mem::create(int threadId)
 {
+    if (threadId >= m_threads) {
+        return createExtra();
+    }
+
+    const int ratio = (m_doubleHash && m_algo != Options::ALGO_CRYPTONIGHT_LITE) ? 2 : 1;
+    prefault(&m_memory[MEMORY * (threadId * ratio + 1)], extraSize());
+
 #   ifndef XMRIG_NO_AEON
     if (m_algo == Options::ALGO_CRYPTONIGHT_LITE) {
         return createLite(threadId);
@@ -47,14 +61,38 @@ cryptonight_ctx *Mem::create(int threadId)
 #   endif
 
     cryptonight_ctx *ctx = reinterpret_cast<cryptonight_ctx *>(&m_memory[MEMORY - sizeof(cryptonight_ctx) * (threadId + 1)]);
-
-    const int ratio = m_doubleHash ? 2 : 1;
     ctx->memory = &m_memory[MEMORY * (threadId * ratio + 1)];
 
     return ctx;
 }
 
 
+void Mem::destroy(int threadId, cryptonight_ctx *ctx)
+{
+    if (threadId < m_threads || !ctx) {
+        return;
+    }
+
+    destroyExtra(ctx);
+}
+
+
+size_t Mem::extraSize()
+{
+    return MEMORY * ((m_doubleHash && m_algo != Options::ALGO_CRYPTONIGHT_LITE) ? 2 : 1);
+}
+
+
+void Mem::touch(uint8_t *memory, size_t size)
+{
+    volatile uint8_t *p = memory;
+
+    for (size_t i = 0; i < size; i += 4096) {
+        p[i] = 0;
+    }
+}
+
+
 #ifndef XMRIG_NO_AEON
 cryptonight_ctx *Mem::createLite(int threadId) {
     cryptonight_ctx *ctx;
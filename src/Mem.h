@@ -25,6 +25,7 @@
 #define __MEM_H__
 
 
+#include <atomic>
 #include <stddef.h>
 #include <stdint.h>
 
@@ -46,20 +47,29 @@ public:
 
     static bool allocate(int algo, int threads, bool doubleHash, bool enabled);
     static cryptonight_ctx *create(int threadId);
+    static void destroy(int threadId, cryptonight_ctx *ctx);
     static void release();
 
     static inline bool isDoubleHash()           { return m_doubleHash; }
     static inline bool isHugepagesAvailable()   { return (m_flags & HugepagesAvailable) != 0; }
     static inline bool isHugepagesEnabled()     { return (m_flags & HugepagesEnabled) != 0; }
+    static inline bool isLocked()               { return (m_flags & Lock) != 0 && m_lockFailures.load() == 0; }
     static inline uint32_t hugepagesErrorCode() { return m_hugepages_errorcode; }
     static inline int flags()                   { return m_flags; }
     static inline int threads()                 { return m_threads; }
 
 private:
+    static cryptonight_ctx *createExtra();
+    static size_t extraSize();
+    static void destroyExtra(cryptonight_ctx *ctx);
+    static void prefault(uint8_t *memory, size_t size);
+    static void touch(uint8_t *memory, size_t size);
+
     static bool m_doubleHash;
     static int m_algo;
     static int m_flags;
     static int m_threads;
+    static std::atomic<int> m_lockFailures;
     VAR_ALIGN(16, static uint8_t *m_memory);
     static uint32_t m_hugepages_errorcode;
 
@@ -33,6 +33,7 @@
 #endif
 
 
+#include "Cgroup.h"
 #include "crypto/CryptoNight.h"
 #include "log/Log.h"
 #include "Mem.h"
@@ -55,12 +56,18 @@ bool Mem::allocate(int algo, int threads, bool doubleHash, bool enabled)
 
     m_flags |= HugepagesAvailable;
 
+    // faulting huge pages above hugetlb cgroup limit kills process with SIGBUS.
+    if (Cgroup::hugetlbLimit() >= 0 && (int64_t) size > Cgroup::hugetlbLimit()) {
+        m_memory = static_cast<uint8_t*>(_mm_malloc(size, 16));
+        return true;
+    }
+
 #   if defined(__APPLE__)
     m_memory = static_cast<uint8_t*>(mmap(0, size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANON, VM_FLAGS_SUPERPAGE_SIZE_2MB, 0));
 #   elif defined(__FreeBSD__)
     m_memory = static_cast<uint8_t*>(mmap(0, size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_ALIGNED_SUPER | MAP_PREFAULT_READ, -1, 0));
 #   else
-    m_memory = static_cast<uint8_t*>(mmap(0, size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB | MAP_POPULATE, 0, 0));
+    m_memory = static_cast<uint8_t*>(mmap(0, size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, 0, 0));
 #   endif
     if (m_memory == MAP_FAILED) {
         m_memory = static_cast<uint8_t*>(_mm_malloc(size, 16));
@@ -73,20 +80,34 @@ bool Mem::allocate(int algo, int threads, bool doubleHash, bool enabled)
         LOG_ERR("madvise failed");
     }
 
-    if (mlock(m_memory, size) == 0) {
-        m_flags |= Lock;
-    }
+    // huge pages reserved by mmap, each worker faults and locks own scratchpad in prefault(),
+    // memory reported as locked only if every worker succeeded.
+    m_flags |= Lock;
 
     return true;
 }
 
 
+void Mem::prefault(uint8_t *memory, size_t size)
+{
+    if (m_flags & Lock) {
+        if (mlock(memory, size) == 0) {
+            return;
+        }
+
+        m_lockFailures++;
+    }
+
+    touch(memory, size);
+}
+
+
 void Mem::release()
 {
     const int size = MEMORY * (m_threads + 1);
 
     if (m_flags & HugepagesEnabled) {
-        if (m_flags & Lock) {
+        if (isLocked()) {
             munlock(m_memory, size);
         }
 
@@ -96,3 +117,41 @@ void Mem::release()
         _mm_free(m_memory);
     }
 }
+
+
+cryptonight_ctx *Mem::createExtra()
+{
+    const size_t size = extraSize();
+    void *memory      = MAP_FAILED;
+
+    if (m_flags & HugepagesEnabled) {
+#       if defined(__APPLE__)
+        memory = mmap(0, size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANON, VM_FLAGS_SUPERPAGE_SIZE_2MB, 0);
+#       elif defined(__FreeBSD__)
+        memory = mmap(0, size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_ALIGNED_SUPER | MAP_PREFAULT_READ, -1, 0);
+#       else
+        memory = mmap(0, size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB | MAP_POPULATE, 0, 0);
+#       endif
+    }
+
+    if (memory == MAP_FAILED) {
+        memory = mmap(0, size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANON, -1, 0);
+    }
+
+    if (memory == MAP_FAILED) {
+        LOG_ERR("failed to allocate scratchpad for new thread");
+        return nullptr;
+    }
+
+    cryptonight_ctx *ctx = static_cast<cryptonight_ctx*>(_mm_malloc(sizeof(cryptonight_ctx), 16));
+    ctx->memory = static_cast<uint8_t*>(memory);
+
+    return ctx;
+}
+
+
+void Mem::destroyExtra(cryptonight_ctx *ctx)
+{
+    munmap(ctx->memory, extraSize());
+    _mm_free(ctx);
+}
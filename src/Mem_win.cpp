@@ -175,6 +175,12 @@ bool Mem::allocate(int algo, int threads, bool doubleHash, bool enabled)
 }
 
 
+void Mem::prefault(uint8_t *memory, size_t size)
+{
+    touch(memory, size);
+}
+
+
 void Mem::release()
 {
     if (m_flags & HugepagesEnabled) {
@@ -184,3 +190,35 @@ void Mem::release()
         _mm_free(m_memory);
     }
 }
+
+
+cryptonight_ctx *Mem::createExtra()
+{
+    const size_t size = extraSize();
+    void *memory      = nullptr;
+
+    if (m_flags & HugepagesEnabled) {
+        memory = VirtualAlloc(NULL, size, MEM_COMMIT | MEM_RESERVE | MEM_LARGE_PAGES, PAGE_READWRITE);
+    }
+
+    if (!memory) {
+        memory = VirtualAlloc(NULL, size, MEM_COMMIT | MEM_RESERVE, PAGE_READWRITE);
+    }
+
+    if (!memory) {
+        LOG_ERR("failed to allocate scratchpad for new thread");
+        return nullptr;
+    }
+
+    cryptonight_ctx *ctx = static_cast<cryptonight_ctx*>(_mm_malloc(sizeof(cryptonight_ctx), 16));
+    ctx->memory = static_cast<uint8_t*>(memory);
+
+    return ctx;
+}
+
+
+void Mem::destroyExtra(cryptonight_ctx *ctx)
+{
+    VirtualFree(ctx->memory, 0, MEM_RELEASE);
+    _mm_free(ctx);
+}
@@ -38,7 +38,9 @@
 #endif
 
 
+#include "Cgroup.h"
 #include "Cpu.h"
+#include "crypto/CryptoNight.h"
 #include "donate.h"
 #include "net/Url.h"
 #include "Options.h"
@@ -46,6 +48,7 @@
 #include "rapidjson/document.h"
 #include "rapidjson/error/en.h"
 #include "rapidjson/filereadstream.h"
+#include "Topology.h"
 #include "version.h"
 
 
@@ -70,7 +73,9 @@ Options:\n\
   -k, --keepalive          send keepalived for prevent timeout (need pool support)\n\
   -r, --retries=N          number of times to retry before switch to backup server (default: 5)\n\
   -R, --retry-pause=N      time to pause between retries (default: 5)\n\
-      --cpu-affinity       set process affinity to CPU core(s), mask 0x3 for cores 0 and 1\n\
+      --standby=N          keep N backup pools logged in for instant failover (default: 0)\n\
+      --cpu-affinity       set process affinity to CPU core(s), mask 0x3 or list 0-1,8-9,\n\
+                           auto for placement by cache domains and SMT siblings\n\
       --cpu-priority       set process priority (0 idle, 2 normal to 5 highest)\n\
       --no-huge-pages      disable huge pages support\n\
       --no-color           disable colored output\n\
@@ -78,6 +83,7 @@ Options:\n\
       --user-agent         set custom user-agent string for pool\n\
   -B, --background         run the miner in the background\n\
       --benchmark          run the miner in offline benchmark mode\n\
+      --verify             run full hash self-test for all supported kernels and exit\n\
   -c, --config=FILE        load a JSON-format configuration file\n\
   -l, --log-file=FILE      log all output to a file\n"
 # ifdef HAVE_SYSLOG_H
@@ -86,12 +92,20 @@ Options:\n\
 # endif
 "\
       --max-cpu-usage=N    maximum CPU usage for automatic threads mode (default 75)\n\
+      --load-target=N      throttle threads to keep host CPU load below N%% (Linux only)\n\
       --safe               safe adjust threads and av settings for current CPU\n\
+      --state-file=FILE    keep counters, tuning and self-test results in FILE across restarts\n\
       --nicehash           enable nicehash/xmrig-proxy support\n\
+      --pool-strategy=S    failover (default) or adaptive, switch to pool with best latency and reject rate,\n\
+                           or split, mine on all pools at once with threads divided by pool weight\n\
+      --weight=N           share of threads for last pool in split strategy (default: 1)\n\
       --print-time=N       print hashrate report every N seconds\n\
+      --proxy-port=N       accept local miners on port N and forward their shares to the pool\n\
+      --recv-buffer=N      maximum size of pool message in KB (default 64)\n\
       --api-port=N         port for the miner API\n\
       --api-access-token=T access token for API\n\
       --api-worker-id=ID   custom worker-id for API\n\
+      --api-no-restricted  enable write access to API (requires access token)\n\
   -h, --help               display this help and exit\n\
   -V, --version            output version information and exit\n\
 ";
@@ -111,26 +125,35 @@ static struct option const options[] = {
     { "donate-level",     1, nullptr, 1003 },
     { "help",             0, nullptr, 'h'  },
     { "keepalive",        0, nullptr ,'k'  },
+    { "load-target",      1, nullptr, 1011 },
     { "log-file",         1, nullptr, 'l'  },
     { "max-cpu-usage",    1, nullptr, 1004 },
     { "nicehash",         0, nullptr, 1006 },
     { "no-color",         0, nullptr, 1002 },
     { "no-huge-pages",    0, nullptr, 1009 },
     { "pass",             1, nullptr, 'p'  },
+    { "pool-strategy",    1, nullptr, 1014 },
     { "print-time",       1, nullptr, 1007 },
+    { "proxy-port",       1, nullptr, 1016 },
+    { "recv-buffer",      1, nullptr, 1012 },
     { "retries",          1, nullptr, 'r'  },
     { "retry-pause",      1, nullptr, 'R'  },
     { "safe",             0, nullptr, 1005 },
+    { "standby",          1, nullptr, 1013 },
+    { "state-file",       1, nullptr, 1017 },
     { "syslog",           0, nullptr, 'S'  },
     { "threads",          1, nullptr, 't'  },
     { "url",              1, nullptr, 'o'  },
     { "user",             1, nullptr, 'u'  },
     { "user-agent",       1, nullptr, 1008 },
     { "userpass",         1, nullptr, 'O'  },
+    { "verify",           0, nullptr, 1018 },
     { "version",          0, nullptr, 'V'  },
+    { "weight",           1, nullptr, 1015 },
     { "api-port",         1, nullptr, 4000 },
     { "api-access-token", 1, nullptr, 4001 },
     { "api-worker-id",    1, nullptr, 4002 },
+    { "api-no-restricted", 0, nullptr, 4003 },
     { 0, 0, 0, 0 }
 };
 
@@ -145,12 +168,18 @@ static struct option const config_options[] = {
     { "cpu-priority",  1, nullptr, 1021 },
     { "donate-level",  1, nullptr, 1003 },
     { "huge-pages",    0, nullptr, 1009 },
+    { "load-target",   1, nullptr, 1011 },
     { "log-file",      1, nullptr, 'l'  },
     { "max-cpu-usage", 1, nullptr, 1004 },
+    { "pool-strategy", 1, nullptr, 1014 },
     { "print-time",    1, nullptr, 1007 },
+    { "proxy-port",    1, nullptr, 1016 },
+    { "recv-buffer",   1, nullptr, 1012 },
     { "retries",       1, nullptr, 'r'  },
     { "retry-pause",   1, nullptr, 'R'  },
     { "safe",          0, nullptr, 1005 },
+    { "standby",       1, nullptr, 1013 },
+    { "state-file",    1, nullptr, 1017 },
     { "syslog",        0, nullptr, 'S'  },
     { "threads",       1, nullptr, 't'  },
     { "user-agent",    1, nullptr, 1008 },
@@ -165,6 +194,7 @@ static struct option const pool_options[] = {
     { "userpass",      1, nullptr, 'O'  },
     { "keepalive",     0, nullptr ,'k'  },
     { "nicehash",      0, nullptr, 1006 },
+    { "weight",        1, nullptr, 1015 },
     { 0, 0, 0, 0 }
 };
 
@@ -173,6 +203,7 @@ static struct option const api_options[] = {
     { "port",          1, nullptr, 4000 },
     { "access-token",  1, nullptr, 4001 },
     { "worker-id",     1, nullptr, 4002 },
+    { "restricted",    0, nullptr, 4003 },
     { 0, 0, 0, 0 }
 };
 
@@ -185,6 +216,13 @@ static const char *algo_names[] = {
 };
 
 
+static const char *pool_strategy_names[] = {
+    "failover",
+    "adaptive",
+    "split"
+};
+
+
 Options *Options::parse(int argc, char **argv)
 {
     Options *options = new Options(argc, argv);
@@ -204,7 +242,32 @@ const char *Options::algoName() const
 }
 
 
+const char *Options::poolStrategyName() const
+{
+    return pool_strategy_names[m_poolStrategy];
+}
+
+
+/**
+ * @brief Thread limit from container budget, in safe mode also optimal count, 0 if unlimited.
+ */
+int Options::maxThreads() const
+{
+    // inside container CPU quota, cpuset and memory limit may be lower than host resources.
+    const int budget = Cgroup::maxThreads(MEMORY * ((m_doubleHash && m_algo != ALGO_CRYPTONIGHT_LITE) ? 2 : 1));
+    if (!m_safe) {
+        return budget;
+    }
+
+    const int count = Cpu::optimalThreadsCount(m_algo, m_doubleHash, m_maxCpuUsage);
+
+    return (budget && count > budget) ? budget : count;
+}
+
+
 Options::Options(int argc, char **argv) :
+    m_apiRestricted(true),
+    m_autoAffinity(false),
     m_background(false),
     m_benchmark(false),
     m_colors(true),
@@ -213,21 +276,27 @@ Options::Options(int argc, char **argv) :
     m_ready(false),
     m_safe(false),
     m_syslog(false),
+    m_verify(false),
     m_apiToken(nullptr),
     m_apiWorkerId(nullptr),
     m_logFile(nullptr),
+    m_stateFile(nullptr),
     m_userAgent(nullptr),
     m_algo(0),
     m_algoVariant(0),
     m_apiPort(0),
     m_donateLevel(kDonateLevel),
+    m_loadTarget(0),
     m_maxCpuUsage(75),
+    m_poolStrategy(POOL_FAILOVER),
     m_printTime(60),
     m_priority(-1),
+    m_proxyPort(0),
+    m_recvBuffer(64),
     m_retries(5),
     m_retryPause(5),
-    m_threads(0),
-    m_affinity(-1L)
+    m_standby(0),
+    m_threads(0)
 {
     m_pools.push_back(new Url());
 
@@ -249,29 +318,40 @@ Options::Options(int argc, char **argv) :
         return;
     }
 
-    if (!m_pools[0]->isValid() && !m_benchmark) {
+    if (!m_pools[0]->isValid() && !m_benchmark && !m_verify) {
         parseConfig(Platform::defaultConfigName());
     }
 
-    if (!m_pools[0]->isValid() && !m_benchmark) {
+    if (!m_pools[0]->isValid() && !m_benchmark && !m_verify) {
         fprintf(stderr, "No pool URL supplied. Exiting.\n");
         return;
     }
 
+    if (m_autoAffinity && !Topology::isAvailable()) {
+        m_autoAffinity = false;
+    }
+
+    if (m_autoAffinity && (m_algoVariant <= AV0_AUTO || m_algoVariant >= AV_MAX)) {
+        const bool doubleHash = Topology::ways(m_algo == ALGO_CRYPTONIGHT_LITE ? 1024 : 2048) == 2;
+        m_algoVariant = Cpu::hasAES() ? (doubleHash ? AV2_AESNI_DOUBLE : AV1_AESNI) : (doubleHash ? AV4_SOFT_AES_DOUBLE : AV3_SOFT_AES);
+    }
+
     m_algoVariant = getAlgoVariant();
     if (m_algoVariant == AV2_AESNI_DOUBLE || m_algoVariant == AV4_SOFT_AES_DOUBLE) {
         m_doubleHash = true;
     }
 
+    const int limit = maxThreads();
+
     if (!m_threads) {
         m_threads = Cpu::optimalThreadsCount(m_algo, m_doubleHash, m_maxCpuUsage);
-    }
-    else if (m_safe) {
-        const int count = Cpu::optimalThreadsCount(m_algo, m_doubleHash, m_maxCpuUsage);
-        if (m_threads > count) {
-            m_threads = count;
+        if (limit && m_threads > limit) {
+            m_threads = limit;
         }
     }
+    else if (m_safe && m_threads > limit) {
+        m_threads = limit;
+    }
 
     for (Url *url : m_pools) {
         url->applyExceptions();
@@ -324,6 +404,12 @@ bool Options::parseArg(int key, const char *arg)
         }
         break;
 
+    case 1014: /* --pool-strategy */
+        if (!setPoolStrategy(arg)) {
+            return false;
+        }
+        break;
+
     case 'o': /* --url */
         if (m_pools.size() > 1 || m_pools[0]->isValid()) {
             Url *url = new Url(arg);
@@ -363,6 +449,11 @@ bool Options::parseArg(int key, const char *arg)
         m_colors = false;
         break;
 
+    case 1017: /* --state-file */
+        free(m_stateFile);
+        m_stateFile = strdup(arg);
+        break;
+
     case 4001: /* --access-token */
         free(m_apiToken);
         m_apiToken = strdup(arg);
@@ -379,6 +470,11 @@ bool Options::parseArg(int key, const char *arg)
     case 1003: /* --donate-level */
     case 1004: /* --max-cpu-usage */
     case 1007: /* --print-time */
+    case 1011: /* --load-target */
+    case 1012: /* --recv-buffer */
+    case 1013: /* --standby */
+    case 1015: /* --weight */
+    case 1016: /* --proxy-port */
     case 1021: /* --cpu-priority */
     case 4000: /* --api-port */
         return parseArg(key, strtol(arg, nullptr, 10));
@@ -389,10 +485,12 @@ bool Options::parseArg(int key, const char *arg)
     case 1005: /* --safe */
     case 1006: /* --nicehash */
     case 1010: /* --benchmark */
+    case 1018: /* --verify */
         return parseBoolean(key, true);
 
     case 1002: /* --no-color */
     case 1009: /* --no-huge-pages */
+    case 4003: /* --api-no-restricted */
         return parseBoolean(key, false);
 
     case 't':  /* --threads */
@@ -416,8 +514,19 @@ bool Options::parseArg(int key, const char *arg)
         break;
 
     case 1020: { /* --cpu-affinity */
-            const char *p  = strstr(arg, "0x");
-            return parseArg(key, p ? strtoull(p, nullptr, 16) : strtoull(arg, nullptr, 10));
+            if (strcmp(arg, "auto") == 0) {
+                m_autoAffinity = true;
+                m_affinity.clear();
+                return true;
+            }
+
+            if (!m_affinity.parse(arg)) {
+                showUsage(1);
+                return false;
+            }
+
+            m_autoAffinity = false;
+            break;
         }
 
     case 1008: /* --user-agent */
@@ -499,9 +608,55 @@ bool Options::parseArg(int key, uint64_t arg)
         m_printTime = (int) arg;
         break;
 
+    case 1011: /* --load-target */
+        if (arg > 100) {
+            showUsage(1);
+            return false;
+        }
+
+        m_loadTarget = (int) arg;
+        break;
+
+    case 1012: /* --recv-buffer */
+        if (arg < 2 || arg > 16384) {
+            showUsage(1);
+            return false;
+        }
+
+        m_recvBuffer = (int) arg;
+        break;
+
+    case 1013: /* --standby */
+        if (arg > 15) {
+            showUsage(1);
+            return false;
+        }
+
+        m_standby = (int) arg;
+        break;
+
+    case 1015: /* --weight */
+        if (arg > 1000) {
+            showUsage(1);
+            return false;
+        }
+
+        m_pools.back()->setWeight((int) arg);
+        break;
+
+    case 1016: /* --proxy-port */
+        if (arg > 65535) {
+            showUsage(1);
+            return false;
+        }
+
+        m_proxyPort = (int) arg;
+        break;
+
     case 1020: /* --cpu-affinity */
         if (arg) {
-            m_affinity = arg;
+            m_affinity.setMask(arg);
+            m_autoAffinity = false;
         }
         break;
 
@@ -562,10 +717,18 @@ bool Options::parseBoolean(int key, bool enable)
         m_benchmark = enable;
         break;
 
+    case 1018: /* --verify */
+        m_verify = enable;
+        break;
+
     case 2000: /* colors */
         m_colors = enable;
         break;
 
+    case 4003: /* --api-no-restricted */
+        m_apiRestricted = enable;
+        break;
+
     default:
         break;
     }
@@ -686,6 +849,20 @@ void Options::showVersion()
 }
 
 
+bool Options::setPoolStrategy(const char *strategy)
+{
+    for (size_t i = 0; i < ARRAY_SIZE(pool_strategy_names); i++) {
+        if (!strcmp(strategy, pool_strategy_names[i])) {
+            m_poolStrategy = (int) i;
+            return true;
+        }
+    }
+
+    showUsage(1);
+    return false;
+}
+
+
 bool Options::setAlgo(const char *algo)
 {
     for (size_t i = 0; i < ARRAY_SIZE(algo_names); i++) {
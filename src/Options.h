@@ -29,6 +29,7 @@
 #include <vector>
 
 
+#include "CpuSet.h"
 #include "rapidjson/fwd.h"
 
 
@@ -44,6 +45,12 @@ public:
         ALGO_CRYPTONIGHT_LITE, /* CryptoNight-Lite (AEON) */
     };
 
+    enum PoolStrategy {
+        POOL_FAILOVER,
+        POOL_ADAPTIVE,
+        POOL_SPLIT
+    };
+
     enum AlgoVariant {
         AV0_AUTO,
         AV1_AESNI,
@@ -56,32 +63,45 @@ public:
     static inline Options* i() { return m_self; }
     static Options *parse(int argc, char **argv);
 
+    inline bool apiRestricted() const             { return m_apiRestricted; }
+    inline bool autoAffinity() const              { return m_autoAffinity; }
     inline bool background() const                { return m_background; }
     inline bool benchmark() const                 { return m_benchmark; }
     inline bool colors() const                    { return m_colors; }
     inline bool doubleHash() const                { return m_doubleHash; }
     inline bool hugePages() const                 { return m_hugePages; }
     inline bool syslog() const                    { return m_syslog; }
+    inline bool verify() const                    { return m_verify; }
     inline const char *apiToken() const           { return m_apiToken; }
     inline const char *apiWorkerId() const        { return m_apiWorkerId; }
     inline const char *logFile() const            { return m_logFile; }
+    inline const char *stateFile() const          { return m_stateFile; }
     inline const char *userAgent() const          { return m_userAgent; }
     inline const std::vector<Url*> &pools() const { return m_pools; }
     inline int algo() const                       { return m_algo; }
     inline int algoVariant() const                { return m_algoVariant; }
     inline int apiPort() const                    { return m_apiPort; }
     inline int donateLevel() const                { return m_donateLevel; }
+    inline int loadTarget() const                 { return m_loadTarget; }
     inline int printTime() const                  { return m_printTime; }
+    inline int poolStrategy() const               { return m_poolStrategy; }
     inline int priority() const                   { return m_priority; }
+    inline int proxyPort() const                  { return m_proxyPort; }
+    inline int recvBuffer() const                 { return m_recvBuffer; }
     inline int retries() const                    { return m_retries; }
     inline int retryPause() const                 { return m_retryPause; }
+    inline int standby() const                    { return m_standby; }
     inline int threads() const                    { return m_threads; }
-    inline int64_t affinity() const               { return m_affinity; }
+    inline const CpuSet &affinity() const         { return m_affinity; }
+    inline void setAlgoVariant(int av)            { m_algoVariant = av; }
     inline void setColors(bool colors)            { m_colors = colors; }
+    inline void setThreads(int threads)           { m_threads = threads; }
 
     inline static void release()                  { delete m_self; }
 
     const char *algoName() const;
+    const char *poolStrategyName() const;
+    int maxThreads() const;
 
 private:
     Options(int argc, char **argv);
@@ -102,12 +122,15 @@ private:
     void showVersion(void);
 
     bool setAlgo(const char *algo);
+    bool setPoolStrategy(const char *strategy);
 
     int getAlgoVariant() const;
 #   ifndef XMRIG_NO_AEON
     int getAlgoVariantLite() const;
 #   endif
 
+    bool m_apiRestricted;
+    bool m_autoAffinity;
     bool m_background;
     bool m_benchmark;
     bool m_colors;
@@ -116,21 +139,28 @@ private:
     bool m_ready;
     bool m_safe;
     bool m_syslog;
+    bool m_verify;
     char *m_apiToken;
     char *m_apiWorkerId;
     char *m_logFile;
+    char *m_stateFile;
     char *m_userAgent;
     int m_algo;
     int m_algoVariant;
     int m_apiPort;
     int m_donateLevel;
+    int m_loadTarget;
     int m_maxCpuUsage;
+    int m_poolStrategy;
     int m_printTime;
     int m_priority;
+    int m_proxyPort;
+    int m_recvBuffer;
     int m_retries;
     int m_retryPause;
+    int m_standby;
     int m_threads;
-    int64_t m_affinity;
+    CpuSet m_affinity;
     std::vector<Url*> m_pools;
 };
 
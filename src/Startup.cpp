@@ -0,0 +1,112 @@
+/* XMRig
+ * Copyright 2010      Jeff Garzik <jgarzik@pobox.com>
+ * Copyright 2012-2014 pooler      <pooler@litecoinpool.org>
+ * Copyright 2014      Lucas Jones <https://github.com/lucasjones>
+ * Copyright 2014-2016 Wolf9466    <https://github.com/OhGodAPet>
+ * Copyright 2016      Jay D Dee   <jayddee246@gmail.com>
+ * Copyright 2016-2017 XMRig       <support@xmrig.com>
+ *
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <uv.h>
+
+
+#include "log/Log.h"
+#include "Startup.h"
+
+
+bool Startup::m_printed                  = false;
+std::atomic<int> Startup::m_workers(0);
+std::atomic<uint64_t> Startup::m_prefault(0);
+std::atomic<uint64_t> Startup::m_ready(0);
+uint64_t Startup::m_start                = 0;
+uint64_t Startup::m_stages[StageMax]     = { 0 };
+
+
+void Startup::begin()
+{
+    m_start = uv_hrtime();
+}
+
+
+/**
+ * @brief Record stage completion, only first call counts, event loop thread only.
+ */
+void Startup::mark(Stage stage)
+{
+    if (m_stages[stage] != 0) {
+        return;
+    }
+
+    m_stages[stage] = elapsed();
+
+    if (stage == Share) {
+        LOG_INFO("first share accepted %u ms after start", (unsigned) m_stages[Share]);
+    }
+}
+
+
+/**
+ * @brief Called from worker thread once its scratchpad is faulted in.
+ */
+void Startup::onWorker(uint64_t elapsed)
+{
+    uint64_t prev = m_prefault.load(std::memory_order_relaxed);
+    while (elapsed > prev && !m_prefault.compare_exchange_weak(prev, elapsed)) {}
+
+    const uint64_t ready = Startup::elapsed();
+    prev = m_ready.load(std::memory_order_relaxed);
+    while (ready > prev && !m_ready.compare_exchange_weak(prev, ready)) {}
+
+    m_workers++;
+}
+
+
+/**
+ * @brief Print timeline when all threads are ready and first job received, called every second.
+ */
+void Startup::tick(int threads, bool benchmark)
+{
+    if (m_printed || m_workers.load(std::memory_order_relaxed) < threads) {
+        return;
+    }
+
+    m_stages[Workers] = m_ready.load();
+
+    if (!benchmark && m_stages[Job] == 0) {
+        return;
+    }
+
+    m_printed = true;
+
+    if (benchmark) {
+        LOG_INFO("startup timeline ms: self-test %u, memory %u, workers %u (slowest prefault %u)",
+                 (unsigned) m_stages[SelfTest], (unsigned) m_stages[Memory], (unsigned) m_stages[Workers], (unsigned) (m_prefault.load() / 1000000));
+        return;
+    }
+
+    LOG_INFO("startup timeline ms: self-test %u, memory %u, pool %u, job %u, workers %u (slowest prefault %u)",
+             (unsigned) m_stages[SelfTest], (unsigned) m_stages[Memory], (unsigned) m_stages[Pool],
+             (unsigned) m_stages[Job], (unsigned) m_stages[Workers], (unsigned) (m_prefault.load() / 1000000));
+}
+
+
+uint64_t Startup::elapsed()
+{
+    const uint64_t ms = (uv_hrtime() - m_start) / 1000000;
+
+    return ms > 0 ? ms : 1;
+}
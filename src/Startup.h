@@ -0,0 +1,72 @@
+/* XMRig
+ * Copyright 2010      Jeff Garzik <jgarzik@pobox.com>
+ * Copyright 2012-2014 pooler      <pooler@litecoinpool.org>
+ * Copyright 2014      Lucas Jones <https://github.com/lucasjones>
+ * Copyright 2014-2016 Wolf9466    <https://github.com/OhGodAPet>
+ * Copyright 2016      Jay D Dee   <jayddee246@gmail.com>
+ * Copyright 2016-2017 XMRig       <support@xmrig.com>
+ *
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef __STARTUP_H__
+#define __STARTUP_H__
+
+
+#include <atomic>
+#include <stdint.h>
+
+
+/**
+ * Startup timeline, milliseconds since process start for each stage.
+ *
+ * Pool DNS lookup is started before self-test, but connect and login complete only
+ * after event loop starts, so pool and job stages always follow memory setup.
+ * Workers fault own scratchpads while event loop already runs, so timeline is
+ * printed once all threads are ready.
+ */
+class Startup
+{
+public:
+    enum Stage {
+        SelfTest,
+        Memory,
+        Pool,
+        Job,
+        Workers,
+        Share,
+        StageMax
+    };
+
+    static void begin();
+    static void mark(Stage stage);
+    static void onWorker(uint64_t elapsed);
+    static void tick(int threads, bool benchmark);
+
+    static inline uint64_t at(Stage stage) { return m_stages[stage]; }
+
+private:
+    static uint64_t elapsed();
+
+    static bool m_printed;
+    static std::atomic<int> m_workers;
+    static std::atomic<uint64_t> m_prefault;
+    static std::atomic<uint64_t> m_ready;
+    static uint64_t m_start;
+    static uint64_t m_stages[StageMax];
+};
+
+
+#endif /* __STARTUP_H__ */
@@ -0,0 +1,279 @@
+/* XMRig
+ * Copyright 2010      Jeff Garzik <jgarzik@pobox.com>
+ * Copyright 2012-2014 pooler      <pooler@litecoinpool.org>
+ * Copyright 2014      Lucas Jones <https://github.com/lucasjones>
+ * Copyright 2014-2016 Wolf9466    <https://github.com/OhGodAPet>
+ * Copyright 2016      Jay D Dee   <jayddee246@gmail.com>
+ * Copyright 2016-2017 XMRig       <support@xmrig.com>
+ *
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include <uv.h>
+
+
+#include "log/Log.h"
+#include "rapidjson/document.h"
+#include "rapidjson/error/en.h"
+#include "rapidjson/filereadstream.h"
+#include "rapidjson/prettywriter.h"
+#include "rapidjson/stringbuffer.h"
+#include "State.h"
+#include "version.h"
+
+
+static uint64_t getUint64(const rapidjson::Value &object, const char *name)
+{
+    if (!object.IsObject() || !object.HasMember(name) || !object[name].IsUint64()) {
+        return 0;
+    }
+
+    return object[name].GetUint64();
+}
+
+
+static int getInt(const rapidjson::Value &object, const char *name)
+{
+    if (!object.IsObject() || !object.HasMember(name) || !object[name].IsInt()) {
+        return 0;
+    }
+
+    return object[name].GetInt();
+}
+
+
+static double getDouble(const rapidjson::Value &object, const char *name)
+{
+    if (!object.IsObject() || !object.HasMember(name) || !object[name].IsNumber()) {
+        return 0.0;
+    }
+
+    return object[name].GetDouble();
+}
+
+
+static void getString(const rapidjson::Value &object, const char *name, char *out, size_t size)
+{
+    out[0] = '\0';
+
+    if (object.IsObject() && object.HasMember(name) && object[name].IsString()) {
+        snprintf(out, size, "%s", object[name].GetString());
+    }
+}
+
+
+State::Data::Data() :
+    algo(0),
+    av(0),
+    threads(0),
+    tunedAv(0),
+    tunedThreads(0),
+    average(0.0),
+    highest(0.0),
+    topDiff { { } },
+    accepted(0),
+    failures(0),
+    jobs(0),
+    rejected(0),
+    total(0),
+    verified(0)
+{
+    memset(build, 0, sizeof(build));
+    memset(cpu, 0, sizeof(cpu));
+    memset(pool, 0, sizeof(pool));
+}
+
+
+/**
+ * @brief Tuning results apply only to the same CPU and algorithm and if options still resolve to the same defaults.
+ */
+bool State::Data::isTuned(int algo, const char *cpu, int av, int threads) const
+{
+    if (tunedAv <= 0 || tunedThreads <= 0) {
+        return false;
+    }
+
+    return this->algo == algo && strcmp(this->cpu, cpu) == 0 && this->av == av && this->threads == threads;
+}
+
+
+bool State::load(const char *fileName, Data &data)
+{
+    FILE *fp = fopen(fileName, "rb");
+    if (!fp) {
+        return false;
+    }
+
+    char buf[4096];
+    rapidjson::FileReadStream is(fp, buf, sizeof(buf));
+
+    rapidjson::Document doc;
+    doc.ParseStream(is);
+    fclose(fp);
+
+    if (doc.HasParseError() || !doc.IsObject()) {
+        LOG_WARN("state file \"%s\" ignored: %s", fileName, doc.HasParseError() ? rapidjson::GetParseError_En(doc.GetParseError()) : "not an object");
+        return false;
+    }
+
+    if (getInt(doc, "version") != kVersion) {
+        LOG_WARN("state file \"%s\" ignored: unsupported version", fileName);
+        return false;
+    }
+
+    getString(doc, "cpu", data.cpu, sizeof(data.cpu));
+    getString(doc, "pool", data.pool, sizeof(data.pool));
+    data.algo = getInt(doc, "algo");
+
+    if (doc.HasMember("tuning")) {
+        const rapidjson::Value &tuning = doc["tuning"];
+
+        data.av           = getInt(tuning, "av");
+        data.threads      = getInt(tuning, "threads");
+        data.tunedAv      = getInt(tuning, "tuned-av");
+        data.tunedThreads = getInt(tuning, "tuned-threads");
+    }
+
+    if (doc.HasMember("self-test")) {
+        getString(doc["self-test"], "build", data.build, sizeof(data.build));
+        data.verified = (uint32_t) getUint64(doc["self-test"], "kernels");
+    }
+
+    if (doc.HasMember("hashrate")) {
+        data.highest = getDouble(doc["hashrate"], "highest");
+        data.average = getDouble(doc["hashrate"], "average");
+    }
+
+    if (doc.HasMember("results")) {
+        const rapidjson::Value &results = doc["results"];
+
+        data.accepted = getUint64(results, "accepted");
+        data.rejected = getUint64(results, "rejected");
+        data.total    = getUint64(results, "hashes");
+        data.failures = getUint64(results, "failures");
+        data.jobs     = getUint64(results, "jobs");
+
+        if (results.IsObject() && results.HasMember("best") && results["best"].IsArray()) {
+            const rapidjson::Value &best = results["best"];
+
+            for (rapidjson::SizeType i = 0; i < best.Size() && i < data.topDiff.size(); ++i) {
+                data.topDiff[i] = best[i].IsUint64() ? best[i].GetUint64() : 0;
+            }
+        }
+    }
+
+    return true;
+}
+
+
+/**
+ * @brief Write to temporary file and rename, so crash during save never leaves truncated state.
+ */
+bool State::save(const char *fileName, const Data &data)
+{
+    rapidjson::StringBuffer buffer(0, 1024);
+    rapidjson::PrettyWriter<rapidjson::StringBuffer> writer(buffer);
+
+    writer.StartObject();
+    writer.Key("version");
+    writer.Int(kVersion);
+    writer.Key("app");
+    writer.String(APP_VERSION);
+    writer.Key("cpu");
+    writer.String(data.cpu);
+    writer.Key("algo");
+    writer.Int(data.algo);
+    writer.Key("pool");
+    writer.String(data.pool);
+
+    writer.Key("tuning");
+    writer.StartObject();
+    writer.Key("av");
+    writer.Int(data.av);
+    writer.Key("threads");
+    writer.Int(data.threads);
+    writer.Key("tuned-av");
+    writer.Int(data.tunedAv);
+    writer.Key("tuned-threads");
+    writer.Int(data.tunedThreads);
+    writer.EndObject();
+
+    writer.Key("self-test");
+    writer.StartObject();
+    writer.Key("build");
+    writer.String(data.build);
+    writer.Key("kernels");
+    writer.Uint(data.verified);
+    writer.EndObject();
+
+    writer.Key("hashrate");
+    writer.StartObject();
+    writer.Key("highest");
+    writer.Double(data.highest);
+    writer.Key("average");
+    writer.Double(data.average);
+    writer.EndObject();
+
+    writer.Key("results");
+    writer.StartObject();
+    writer.Key("accepted");
+    writer.Uint64(data.accepted);
+    writer.Key("rejected");
+    writer.Uint64(data.rejected);
+    writer.Key("hashes");
+    writer.Uint64(data.total);
+    writer.Key("failures");
+    writer.Uint64(data.failures);
+    writer.Key("jobs");
+    writer.Uint64(data.jobs);
+    writer.Key("best");
+    writer.StartArray();
+    for (uint64_t diff : data.topDiff) {
+        writer.Uint64(diff);
+    }
+    writer.EndArray();
+    writer.EndObject();
+
+    writer.EndObject();
+
+    char tmp[512];
+    snprintf(tmp, sizeof(tmp), "%s.tmp", fileName);
+
+    FILE *fp = fopen(tmp, "wb");
+    if (!fp) {
+        LOG_ERR("unable to write state file \"%s\"", tmp);
+        return false;
+    }
+
+    const bool written = fwrite(buffer.GetString(), 1, buffer.GetSize(), fp) == buffer.GetSize();
+    if (fclose(fp) != 0 || !written) {
+        LOG_ERR("unable to write state file \"%s\"", tmp);
+        remove(tmp);
+        return false;
+    }
+
+    uv_fs_t req;
+    const int rc = uv_fs_rename(uv_default_loop(), &req, tmp, fileName, nullptr);
+    uv_fs_req_cleanup(&req);
+
+    if (rc < 0) {
+        LOG_ERR("unable to replace state file \"%s\": \"%s\"", fileName, uv_strerror(rc));
+        return false;
+    }
+
+    return true;
+}
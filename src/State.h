@@ -0,0 +1,72 @@
+/* XMRig
+ * Copyright 2010      Jeff Garzik <jgarzik@pobox.com>
+ * Copyright 2012-2014 pooler      <pooler@litecoinpool.org>
+ * Copyright 2014      Lucas Jones <https://github.com/lucasjones>
+ * Copyright 2014-2016 Wolf9466    <https://github.com/OhGodAPet>
+ * Copyright 2016      Jay D Dee   <jayddee246@gmail.com>
+ * Copyright 2016-2017 XMRig       <support@xmrig.com>
+ *
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef __STATE_H__
+#define __STATE_H__
+
+
+#include <array>
+#include <stdint.h>
+
+
+/**
+ * Small JSON file with counters and tuning results, written periodically and on exit
+ * and loaded at startup so reporting continues across restarts and upgrades.
+ */
+class State
+{
+public:
+    constexpr static int kVersion           = 1;
+    constexpr static uint64_t kSaveInterval = 60 * 1000;
+
+    struct Data
+    {
+        Data();
+
+        bool isTuned(int algo, const char *cpu, int av, int threads) const;
+
+        char build[17];
+        char cpu[64];
+        char pool[256];
+        int algo;
+        int av;
+        int threads;
+        int tunedAv;
+        int tunedThreads;
+        double average;
+        double highest;
+        std::array<uint64_t, 10> topDiff;
+        uint64_t accepted;
+        uint64_t failures;
+        uint64_t jobs;
+        uint64_t rejected;
+        uint64_t total;
+        uint32_t verified;
+    };
+
+    static bool load(const char *fileName, Data &data);
+    static bool save(const char *fileName, const Data &data);
+};
+
+
+#endif /* __STATE_H__ */
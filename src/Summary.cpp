@@ -27,12 +27,14 @@
 #include <uv.h>
 
 
+#include "Cgroup.h"
 #include "Cpu.h"
 #include "log/Log.h"
 #include "Mem.h"
 #include "net/Url.h"
 #include "Options.h"
 #include "Summary.h"
+#include "Topology.h"
 #include "version.h"
 
 
@@ -96,11 +98,47 @@ static void print_cpu()
 }
 
 
+static void print_cgroup()
+{
+    if (!Cgroup::isLimited()) {
+        return;
+    }
+
+    char cpu[32]     = "unlimited";
+    char memory[32]  = "unlimited";
+    char hugetlb[32] = "unlimited";
+
+    if (Cgroup::cpuQuota() > 0) {
+        snprintf(cpu, sizeof(cpu), "%.2f", Cgroup::cpuQuota() / 1000.0);
+    }
+
+    if (Cgroup::memoryLimit() >= 0) {
+        snprintf(memory, sizeof(memory), "%" PRId64 " MB", Cgroup::memoryLimit() / 1048576);
+    }
+
+    if (Cgroup::hugetlbLimit() >= 0) {
+        snprintf(hugetlb, sizeof(hugetlb), "%" PRId64 " MB", Cgroup::hugetlbLimit() / 1048576);
+    }
+
+    Log::i()->text(Options::i()->colors() ? "\x1B[01;32m * \x1B[01;37mCGROUP:       \x1B[01;36mv%d\x1B[01;37m, cpu=%s, cpuset=%d, memory=%s, hugetlb=%s" : " * CGROUP:       v%d, cpu=%s, cpuset=%d, memory=%s, hugetlb=%s",
+                   Cgroup::version(),
+                   cpu,
+                   Cgroup::cpus() > 0 ? Cgroup::cpus() : Cpu::threads(),
+                   memory,
+                   hugetlb);
+}
+
+
 static void print_threads()
 {
-    char buf[32];
-    if (Options::i()->affinity() != -1L) {
-        snprintf(buf, 32, ", affinity=0x%" PRIX64, Options::i()->affinity());
+    char buf[96];
+    if (Options::i()->autoAffinity()) {
+        snprintf(buf, sizeof(buf), ", affinity=auto");
+    }
+    else if (!Options::i()->affinity().isEmpty()) {
+        char cpus[80];
+        Options::i()->affinity().toString(cpus, sizeof(cpus));
+        snprintf(buf, sizeof(buf), ", affinity=%s", cpus);
     }
     else {
         buf[0] = '\0';
@@ -116,6 +154,54 @@ static void print_threads()
 }
 
 
+static void print_placement()
+{
+    if (!Options::i()->autoAffinity()) {
+        return;
+    }
+
+    const std::vector<Topology::Slot> slots = Topology::place(Options::i()->threads(), (Options::i()->algo() == Options::ALGO_CRYPTONIGHT_LITE ? 1024 : 2048) * (Options::i()->doubleHash() ? 2 : 1));
+    const std::vector<Topology::Domain> &domains = Topology::domains();
+
+    for (size_t d = 0; d < domains.size(); ++d) {
+        char cpus[128] = { 0 };
+        size_t pos     = 0;
+        int count      = 0;
+        bool truncated = false;
+
+        for (const Topology::Slot &slot : slots) {
+            if (slot.domain != (int) d) {
+                continue;
+            }
+
+            count++;
+
+            // list shortened to fit, but every thread counted.
+            if (truncated) {
+                continue;
+            }
+
+            if (pos >= sizeof(cpus) - 8) {
+                pos += snprintf(cpus + pos, sizeof(cpus) - pos, ",...");
+                truncated = true;
+                continue;
+            }
+
+            pos += snprintf(cpus + pos, sizeof(cpus) - pos, count > 1 ? ",%d" : "%d", slot.cpu);
+        }
+
+        Log::i()->text(Options::i()->colors() ? "\x1B[01;32m * \x1B[01;37mL%d #%-2d        \x1B[01;36m%d KB\x1B[01;37m, cores=%d, threads=%d%s%s" : " * L%d #%-2d        %d KB, cores=%d, threads=%d%s%s",
+                       domains[d].level,
+                       (int) d,
+                       domains[d].cache,
+                       (int) domains[d].cores.size(),
+                       count,
+                       count ? ", cpu=" : "",
+                       cpus);
+    }
+}
+
+
 static void print_pools()
 {
     const std::vector<Url*> &pools = Options::i()->pools();
@@ -163,7 +249,9 @@ void Summary::print()
     print_versions();
     print_memory();
     print_cpu();
+    print_cgroup();
     print_threads();
+    print_placement();
     print_pools();
 
 #   ifndef XMRIG_NO_API
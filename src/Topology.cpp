@@ -0,0 +1,296 @@
+/* XMRig
+ * Copyright 2010      Jeff Garzik <jgarzik@pobox.com>
+ * Copyright 2012-2014 pooler      <pooler@litecoinpool.org>
+ * Copyright 2014      Lucas Jones <https://github.com/lucasjones>
+ * Copyright 2014-2016 Wolf9466    <https://github.com/OhGodAPet>
+ * Copyright 2016      Jay D Dee   <jayddee246@gmail.com>
+ * Copyright 2016-2017 XMRig       <support@xmrig.com>
+ *
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#ifdef __linux__
+#   include <sched.h>
+#endif
+
+
+#include "CpuSet.h"
+#include "Topology.h"
+
+
+std::vector<Topology::Core> Topology::m_cores;
+std::vector<Topology::Domain> Topology::m_domains;
+
+
+#ifdef __linux__
+static bool readFile(const char *path, char *buf, size_t size)
+{
+    FILE *fp = fopen(path, "r");
+    if (!fp) {
+        return false;
+    }
+
+    const size_t read = fread(buf, 1, size - 1, fp);
+    fclose(fp);
+
+    buf[read] = '\0';
+    return read > 0;
+}
+#endif
+
+
+/**
+ * @brief Threads a domain can feed from its cache, at least 1 and no more than its logical CPUs.
+ */
+int Topology::budget(const Domain &domain, int scratchpad)
+{
+    const int count = domain.cache / scratchpad;
+
+    if (count < 1) {
+        return 1;
+    }
+
+    return count > domain.cpus ? domain.cpus : count;
+}
+
+
+int Topology::optimalThreadsCount(int scratchpad)
+{
+    int count = 0;
+    for (const Domain &domain : m_domains) {
+        count += budget(domain, scratchpad);
+    }
+
+    return count;
+}
+
+
+/**
+ * @brief Hashes per thread: 2 when every core in every domain has cache for two scratchpads.
+ */
+int Topology::ways(int scratchpad)
+{
+    if (!isAvailable()) {
+        return 1;
+    }
+
+    for (const Domain &domain : m_domains) {
+        if (domain.cache / scratchpad < 2 * (int) domain.cores.size()) {
+            return 1;
+        }
+    }
+
+    return 2;
+}
+
+
+/**
+ * @brief Assign logical CPU to each thread.
+ *
+ * Threads are spread round-robin over cache domains, inside domain first SMT sibling of every core is used
+ * before second ones, up to number of scratchpads fitting in domain cache. If more threads requested
+ * remaining CPUs are used and then CPUs are reused.
+ */
+std::vector<Topology::Slot> Topology::place(int threads, int scratchpad)
+{
+    std::vector<Slot> slots;
+    if (!isAvailable() || threads <= 0) {
+        return slots;
+    }
+
+    fill(slots, scratchpad);
+    fill(slots, 0);
+
+    const size_t count = slots.size();
+    while (slots.size() < (size_t) threads) {
+        slots.push_back(slots[slots.size() - count]);
+    }
+
+    slots.resize(threads);
+    return slots;
+}
+
+
+void Topology::init()
+{
+#   ifdef __linux__
+    char buf[4096];
+    char path[128];
+
+    if (!readFile("/sys/devices/system/cpu/online", buf, sizeof(buf))) {
+        return;
+    }
+
+    CpuSet online;
+    if (!online.parseList(buf)) {
+        return;
+    }
+
+    const int count   = online.last() + 1;
+    cpu_set_t *allowed = CPU_ALLOC(count);
+    const size_t size = CPU_ALLOC_SIZE(count);
+    const bool hasMask = allowed && sched_getaffinity(0, size, allowed) == 0;
+
+    for (int cpu = 0; cpu < count; ++cpu) {
+        if (!online.isSet(cpu) || (hasMask && !CPU_ISSET_S(cpu, size, allowed))) {
+            continue;
+        }
+
+        CpuSet siblings;
+        snprintf(path, sizeof(path), "/sys/devices/system/cpu/cpu%d/topology/thread_siblings_list", cpu);
+        if (readFile(path, buf, sizeof(buf))) {
+            siblings.parseList(buf);
+        }
+
+        snprintf(path, sizeof(path), "/sys/devices/system/cpu/cpu%d/topology/physical_package_id", cpu);
+        const int package = readFile(path, buf, sizeof(buf)) ? atoi(buf) : 0;
+
+        int level    = 0;
+        int cache    = 0;
+        int domainId = cpu;
+
+        for (int index = 0; index < 10; ++index) {
+            snprintf(path, sizeof(path), "/sys/devices/system/cpu/cpu%d/cache/index%d/level", cpu, index);
+            if (!readFile(path, buf, sizeof(buf))) {
+                break;
+            }
+
+            const int value = atoi(buf);
+            if (value <= level) {
+                continue;
+            }
+
+            snprintf(path, sizeof(path), "/sys/devices/system/cpu/cpu%d/cache/index%d/type", cpu, index);
+            if (readFile(path, buf, sizeof(buf)) && strncmp(buf, "Instruction", 11) == 0) {
+                continue;
+            }
+
+            snprintf(path, sizeof(path), "/sys/devices/system/cpu/cpu%d/cache/index%d/size", cpu, index);
+            if (!readFile(path, buf, sizeof(buf))) {
+                continue;
+            }
+
+            char *unit = nullptr;
+            cache = (int) strtol(buf, &unit, 10);
+            if (*unit == 'M') {
+                cache *= 1024;
+            }
+
+            snprintf(path, sizeof(path), "/sys/devices/system/cpu/cpu%d/cache/index%d/shared_cpu_list", cpu, index);
+            if (readFile(path, buf, sizeof(buf))) {
+                domainId = atoi(buf);
+            }
+
+            level = value;
+        }
+
+        if (level == 0 || cache == 0) {
+            m_cores.clear();
+            m_domains.clear();
+            break;
+        }
+
+        size_t d = 0;
+        while (d < m_domains.size() && m_domains[d].id != domainId) {
+            d++;
+        }
+
+        if (d == m_domains.size()) {
+            m_domains.push_back(Domain { domainId, level, cache, 0, std::vector<int>() });
+        }
+
+        const int coreId = siblings.isEmpty() ? cpu : siblings.first();
+
+        size_t c = 0;
+        while (c < m_cores.size() && m_cores[c].id != coreId) {
+            c++;
+        }
+
+        if (c == m_cores.size()) {
+            m_cores.push_back(Core { coreId, package, (int) d, std::vector<int>() });
+            m_domains[d].cores.push_back((int) c);
+        }
+
+        m_cores[c].cpus.push_back(cpu);
+        m_domains[d].cpus++;
+    }
+
+    if (allowed) {
+        CPU_FREE(allowed);
+    }
+#   endif
+}
+
+
+/**
+ * @brief Append CPUs not yet used, domain by domain in turn; scratchpad 0 means no cache limit.
+ */
+void Topology::fill(std::vector<Slot> &slots, int scratchpad)
+{
+    std::vector<std::vector<Slot> > queues(m_domains.size());
+
+    for (size_t d = 0; d < m_domains.size(); ++d) {
+        const Domain &domain = m_domains[d];
+        const int limit      = scratchpad ? budget(domain, scratchpad) : domain.cpus;
+        std::vector<Slot> &queue = queues[d];
+
+        for (size_t round = 0; (int) queue.size() < limit; ++round) {
+            const size_t size = queue.size();
+
+            for (int c : domain.cores) {
+                if ((int) queue.size() < limit && round < m_cores[c].cpus.size()) {
+                    queue.push_back(Slot { m_cores[c].cpus[round], c, (int) d });
+                }
+            }
+
+            if (queue.size() == size) {
+                break;
+            }
+        }
+    }
+
+    for (size_t i = 0;; ++i) {
+        bool found = false;
+
+        for (const std::vector<Slot> &queue : queues) {
+            if (i >= queue.size()) {
+                continue;
+            }
+
+            found = true;
+
+            bool used = false;
+            for (const Slot &slot : slots) {
+                if (slot.cpu == queue[i].cpu) {
+                    used = true;
+                    break;
+                }
+            }
+
+            if (!used) {
+                slots.push_back(queue[i]);
+            }
+        }
+
+        if (!found) {
+            break;
+        }
+    }
+}
@@ -0,0 +1,81 @@
+/* XMRig
+ * Copyright 2010      Jeff Garzik <jgarzik@pobox.com>
+ * Copyright 2012-2014 pooler      <pooler@litecoinpool.org>
+ * Copyright 2014      Lucas Jones <https://github.com/lucasjones>
+ * Copyright 2014-2016 Wolf9466    <https://github.com/OhGodAPet>
+ * Copyright 2016      Jay D Dee   <jayddee246@gmail.com>
+ * Copyright 2016-2017 XMRig       <support@xmrig.com>
+ *
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef __TOPOLOGY_H__
+#define __TOPOLOGY_H__
+
+
+#include <vector>
+
+
+/**
+ * CPU topology: physical cores with their SMT siblings grouped by last level cache domain.
+ *
+ * Read from sysfs on Linux, not available on other platforms.
+ */
+class Topology
+{
+public:
+    struct Core
+    {
+        int id;                /* first logical CPU of the core */
+        int package;
+        int domain;
+        std::vector<int> cpus; /* SMT siblings */
+    };
+
+    struct Domain
+    {
+        int id;                /* first logical CPU sharing the cache */
+        int level;
+        int cache;             /* KB */
+        int cpus;
+        std::vector<int> cores;
+    };
+
+    struct Slot
+    {
+        int cpu;
+        int core;
+        int domain;
+    };
+
+    static int optimalThreadsCount(int scratchpad);
+    static int ways(int scratchpad);
+    static std::vector<Slot> place(int threads, int scratchpad);
+    static void init();
+
+    static inline bool isAvailable()                       { return !m_domains.empty(); }
+    static inline const std::vector<Core> &cores()         { return m_cores; }
+    static inline const std::vector<Domain> &domains()     { return m_domains; }
+
+private:
+    static int budget(const Domain &domain, int scratchpad);
+    static void fill(std::vector<Slot> &slots, int scratchpad);
+
+    static std::vector<Core> m_cores;
+    static std::vector<Domain> m_domains;
+};
+
+
+#endif /* __TOPOLOGY_H__ */
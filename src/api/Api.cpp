@@ -21,21 +21,56 @@
  *   along with this program. If not, see <http://www.gnu.org/licenses/>.
  */
 
+#include <stdio.h>
+#include <stdlib.h>
 #include <string.h>
+#include <thread>
 
 
 #include "api/Api.h"
+#include "api/ApiBuffer.h"
 #include "api/ApiState.h"
+#include "Cpu.h"
+#include "interfaces/IApiListener.h"
+#include "Options.h"
+#include "rapidjson/document.h"
+#include "workers/Workers.h"
+
+
+static const char *kRoutesList[] = { "/", "/hashrate", "/results", "/connection", "/config", "/threads", "/metrics" };
+static const size_t kMetricsRoute = 6;
+
+// compact variant of every route.
+static const uint32_t kCompactSlots = 0x1555;
+
+// routes which include network state: summary, results, connection and metrics.
+static const uint32_t kNetworkSlots = (3U << 0) | (3U << 4) | (3U << 6) | (3U << 12);
 
 
 ApiState *Api::m_state = nullptr;
+IApiListener *Api::m_listener = nullptr;
+std::list<ApiCommand> Api::m_commands;
+std::atomic<ApiBuffer*> Api::m_slots[kSlots];
+std::atomic<int> Api::m_readers(0);
+std::atomic<uint32_t> Api::m_requested(0);
+uint32_t Api::m_polled = 0;
+uv_async_t Api::m_async;
 uv_mutex_t Api::m_mutex;
 
 
-bool Api::start()
+bool Api::start(IApiListener *listener)
 {
+    for (size_t i = 0; i < kSlots; ++i) {
+        m_slots[i].store(nullptr);
+    }
+
+    m_state    = new ApiState();
+    m_listener = listener;
+
     uv_mutex_init(&m_mutex);
-    m_state = new ApiState();
+    uv_async_init(uv_default_loop(), &m_async, Api::onCommand);
+
+    render(kCompactSlots);
 
     return true;
 }
@@ -43,19 +78,128 @@ bool Api::start()
 
 void Api::release()
 {
+    for (size_t i = 0; i < kSlots; ++i) {
+        publish(i, nullptr);
+    }
+
     delete m_state;
 }
 
 
-char *Api::get(const char *url, int *status)
+void Api::stop()
 {
     if (!m_state) {
-        return nullptr;
+        return;
     }
 
     uv_mutex_lock(&m_mutex);
-    char *buf = m_state->get(url, status);
+    m_listener = nullptr;
+    uv_close(reinterpret_cast<uv_handle_t*>(&m_async), nullptr);
     uv_mutex_unlock(&m_mutex);
+}
+
+
+/**
+ * @brief Validate write request and queue it for the event loop thread, called from HTTP thread.
+ *
+ * Command is executed asynchronously, so successful response is 202 Accepted.
+ */
+ApiBuffer *Api::exec(const char *method, const char *url, const char *data)
+{
+    if (!m_state) {
+        return nullptr;
+    }
+
+    const bool post = strcmp(method, "POST") == 0;
+    const bool put  = strcmp(method, "PUT") == 0;
+    int value       = 0;
+
+    if (post && strcmp(url, "/pause") == 0) {
+        return enqueue(ApiCommand(ApiCommand::Pause), "pause");
+    }
+
+    if (post && strcmp(url, "/resume") == 0) {
+        return enqueue(ApiCommand(ApiCommand::Resume), "resume");
+    }
+
+    if (put && strcmp(url, "/pool") == 0) {
+        if (!parse(data, "index", &value) || value < 0 || value >= (int) Options::i()->pools().size()) {
+            return reply(400, "error", "invalid pool index");
+        }
+
+        return enqueue(ApiCommand(ApiCommand::SetPool, value), "pool");
+    }
+
+    if (put && strcmp(url, "/threads") == 0) {
+        if (!parse(data, "threads", &value) || value < 1 || value > Workers::maxThreads()) {
+            return reply(400, "error", "invalid threads count");
+        }
+
+        return enqueue(ApiCommand(ApiCommand::SetThreads, value), "threads");
+    }
+
+    if (put && strcmp(url, "/thread") == 0) {
+        int id = 0;
+        if (!parse(data, "id", &id) || id < 0 || id >= Workers::maxThreads()) {
+            return reply(400, "error", "invalid thread id");
+        }
+
+        if (!parse(data, "enabled", &value)) {
+            return reply(400, "error", "invalid enabled");
+        }
+
+        return enqueue(ApiCommand(ApiCommand::SetThreadEnabled, value, id), "thread");
+    }
+
+    if (put && strcmp(url, "/av") == 0) {
+        if (!parse(data, "av", &value) || value < Options::AV1_AESNI || value > Options::AV4_SOFT_AES_DOUBLE) {
+            return reply(400, "error", "invalid av");
+        }
+
+        // scratchpads allocated for single or double hash, so only AES implementation can be changed.
+        const bool doubleHash = value == Options::AV2_AESNI_DOUBLE || value == Options::AV4_SOFT_AES_DOUBLE;
+        if (doubleHash != Options::i()->doubleHash()) {
+            return reply(400, "error", "av change between single and double hash requires restart");
+        }
+
+        if (value <= Options::AV2_AESNI_DOUBLE && !Cpu::hasAES()) {
+            return reply(400, "error", "AES-NI not supported");
+        }
+
+        return enqueue(ApiCommand(ApiCommand::SetAlgoVariant, value), "av");
+    }
+
+    return reply(404, "error", "not found");
+}
+
+
+/**
+ * @brief Returns snapshot prepared by the event loop thread, called from HTTP thread.
+ *
+ * No lock and no serialization here, route marked as requested so event loop keeps it
+ * fresh on next ticks. Caller must release returned buffer.
+ */
+ApiBuffer *Api::get(const char *url, bool pretty)
+{
+    if (!m_state) {
+        return nullptr;
+    }
+
+    // unknown URLs served with full document, same as "/".
+    size_t slot = pretty ? 1 : 0;
+    for (size_t i = 0; i < kRoutes; ++i) {
+        if (strcmp(url, kRoutesList[i]) == 0) {
+            slot = i * 2 + ((pretty && i != kMetricsRoute) ? 1 : 0);
+            break;
+        }
+    }
+
+    m_requested.fetch_or(1U << slot);
+
+    ApiBuffer *buf = acquire(slot);
+    if (!buf && (slot & 1)) {
+        buf = acquire(slot - 1);
+    }
 
     return buf;
 }
@@ -67,9 +211,10 @@ void Api::tick(const Hashrate *hashrate)
         return;
     }
 
-    uv_mutex_lock(&m_mutex);
     m_state->tick(hashrate);
-    uv_mutex_unlock(&m_mutex);
+
+    m_polled = m_requested.exchange(0);
+    render(m_polled);
 }
 
 
@@ -79,7 +224,150 @@ void Api::tick(const NetworkState &network)
         return;
     }
 
-    uv_mutex_lock(&m_mutex);
     m_state->tick(network);
+    render((m_polled | m_requested.load()) & kNetworkSlots);
+}
+
+
+ApiBuffer *Api::acquire(size_t slot)
+{
+    m_readers.fetch_add(1);
+
+    ApiBuffer *buf = m_slots[slot].load();
+    if (buf) {
+        buf->retain();
+    }
+
+    m_readers.fetch_sub(1);
+    return buf;
+}
+
+
+ApiBuffer *Api::create(const char *url, bool pretty)
+{
+    char *buf = m_state->get(url, pretty);
+
+    return new ApiBuffer(buf, strlen(buf), 200, "application/json");
+}
+
+
+ApiBuffer *Api::enqueue(const ApiCommand &command, const char *name)
+{
+    uv_mutex_lock(&m_mutex);
+
+    if (!m_listener) {
+        uv_mutex_unlock(&m_mutex);
+        return reply(503, "error", "shutting down");
+    }
+
+    m_commands.push_back(command);
+    uv_async_send(&m_async);
+    uv_mutex_unlock(&m_mutex);
+
+    return reply(202, "command", name);
+}
+
+
+ApiBuffer *Api::reply(int status, const char *key, const char *value)
+{
+    char *buf = static_cast<char*>(malloc(256));
+    const int size = snprintf(buf, 256, "{\"status\":%d,\"%s\":\"%s\"}", status, key, value);
+
+    return new ApiBuffer(buf, size > 0 ? (size_t) size : 0, status, "application/json");
+}
+
+
+bool Api::parse(const char *data, const char *key, int *value)
+{
+    if (!data) {
+        return false;
+    }
+
+    rapidjson::Document doc;
+    doc.Parse(data);
+
+    if (doc.HasParseError() || !doc.IsObject() || !doc.HasMember(key)) {
+        return false;
+    }
+
+    const rapidjson::Value &member = doc[key];
+    if (member.IsBool()) {
+        *value = member.IsTrue() ? 1 : 0;
+        return true;
+    }
+
+    if (!member.IsInt()) {
+        return false;
+    }
+
+    *value = member.GetInt();
+    return true;
+}
+
+
+/**
+ * @brief Replace snapshot in slot, previous one released after all readers which might see it took own reference.
+ */
+void Api::publish(size_t slot, ApiBuffer *buffer)
+{
+    ApiBuffer *prev = m_slots[slot].exchange(buffer);
+    if (!prev) {
+        return;
+    }
+
+    while (m_readers.load() != 0) {
+        std::this_thread::yield();
+    }
+
+    prev->release();
+}
+
+
+/**
+ * @brief Serialize snapshots on event loop thread.
+ *
+ * Ticks render only routes polled since previous hashrate tick, so nothing serialized while nobody
+ * polls the API, until then the last snapshot served. Pretty printed variants rendered only if requested.
+ */
+void Api::render(uint32_t slots)
+{
+    for (size_t i = 0; i < kMetricsRoute; ++i) {
+        if (slots & (1U << (i * 2))) {
+            publish(i * 2, create(kRoutesList[i], false));
+        }
+
+        if (slots & (1U << (i * 2 + 1))) {
+            publish(i * 2 + 1, create(kRoutesList[i], true));
+        }
+    }
+
+    if (slots & (1U << (kMetricsRoute * 2))) {
+        size_t size = 0;
+        const char *data = m_state->metrics(&size);
+
+        char *buf = static_cast<char*>(malloc(size + 1));
+        memcpy(buf, data, size + 1);
+
+        publish(kMetricsRoute * 2, new ApiBuffer(buf, size, 200, "text/plain; version=0.0.4"));
+    }
+}
+
+
+void Api::onCommand(uv_async_t *handle)
+{
+    std::list<ApiCommand> commands;
+
+    uv_mutex_lock(&m_mutex);
+    commands.swap(m_commands);
+    IApiListener *listener = m_listener;
     uv_mutex_unlock(&m_mutex);
+
+    if (!listener) {
+        return;
+    }
+
+    for (const ApiCommand &command : commands) {
+        listener->onApiCommand(command);
+    }
 }
+
@@ -25,26 +25,57 @@
 #define __API_H__
 
 
+#include <atomic>
+#include <list>
+#include <stddef.h>
+#include <stdint.h>
 #include <uv.h>
 
 
+#include "api/ApiCommand.h"
+
+
+class ApiBuffer;
 class ApiState;
 class Hashrate;
+class IApiListener;
 class NetworkState;
 
 
 class Api
 {
 public:
-    static bool start();
+    static bool start(IApiListener *listener);
     static void release();
+    static void stop();
 
-    static char *get(const char *url, int *status);
+    static ApiBuffer *exec(const char *method, const char *url, const char *data);
+    static ApiBuffer *get(const char *url, bool pretty);
     static void tick(const Hashrate *hashrate);
     static void tick(const NetworkState &results);
 
 private:
+    constexpr static size_t kRoutes = 7;
+    constexpr static size_t kSlots  = kRoutes * 2;     // compact and pretty variant for each route.
+
+    static ApiBuffer *acquire(size_t slot);
+    static ApiBuffer *create(const char *url, bool pretty);
+    static ApiBuffer *enqueue(const ApiCommand &command, const char *name);
+    static ApiBuffer *reply(int status, const char *key, const char *value);
+    static bool parse(const char *data, const char *key, int *value);
+    static void publish(size_t slot, ApiBuffer *buffer);
+    static void render(uint32_t slots);
+
+    static void onCommand(uv_async_t *handle);
+
     static ApiState *m_state;
+    static IApiListener *m_listener;
+    static std::list<ApiCommand> m_commands;
+    static std::atomic<ApiBuffer*> m_slots[kSlots];
+    static std::atomic<int> m_readers;
+    static std::atomic<uint32_t> m_requested;
+    static uint32_t m_polled;
+    static uv_async_t m_async;
     static uv_mutex_t m_mutex;
 };
 
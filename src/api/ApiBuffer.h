@@ -0,0 +1,76 @@
+/* XMRig
+ * Copyright 2010      Jeff Garzik <jgarzik@pobox.com>
+ * Copyright 2012-2014 pooler      <pooler@litecoinpool.org>
+ * Copyright 2014      Lucas Jones <https://github.com/lucasjones>
+ * Copyright 2014-2016 Wolf9466    <https://github.com/OhGodAPet>
+ * Copyright 2016      Jay D Dee   <jayddee246@gmail.com>
+ * Copyright 2016-2017 XMRig       <support@xmrig.com>
+ *
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef __APIBUFFER_H__
+#define __APIBUFFER_H__
+
+
+#include <atomic>
+#include <stdlib.h>
+#include <string.h>
+
+
+/**
+ * Immutable reference counted response body.
+ *
+ * Created on the event loop thread and handed to HTTP thread without copy,
+ * last owner frees the memory.
+ */
+class ApiBuffer
+{
+public:
+    inline ApiBuffer(char *data, size_t size, int status, const char *contentType) :
+        m_contentType(contentType),
+        m_data(data),
+        m_status(status),
+        m_refs(1),
+        m_size(size)
+    {}
+
+
+    inline void release()
+    {
+        if (m_refs.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+            delete this;
+        }
+    }
+
+
+    inline const char *contentType() const { return m_contentType; }
+    inline const char *data() const        { return m_data; }
+    inline int status() const              { return m_status; }
+    inline size_t size() const             { return m_size; }
+    inline void retain()                   { m_refs.fetch_add(1, std::memory_order_relaxed); }
+
+
+private:
+    inline ~ApiBuffer() { free(m_data); }
+
+    const char *m_contentType;
+    char *m_data;
+    const int m_status;
+    std::atomic<int> m_refs;
+    const size_t m_size;
+};
+
+#endif /* __APIBUFFER_H__ */
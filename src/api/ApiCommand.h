@@ -0,0 +1,50 @@
+/* XMRig
+ * Copyright 2010      Jeff Garzik <jgarzik@pobox.com>
+ * Copyright 2012-2014 pooler      <pooler@litecoinpool.org>
+ * Copyright 2014      Lucas Jones <https://github.com/lucasjones>
+ * Copyright 2014-2016 Wolf9466    <https://github.com/OhGodAPet>
+ * Copyright 2016      Jay D Dee   <jayddee246@gmail.com>
+ * Copyright 2016-2017 XMRig       <support@xmrig.com>
+ *
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef __APICOMMAND_H__
+#define __APICOMMAND_H__
+
+
+/**
+ * Control request accepted by HTTP thread and executed on the event loop thread.
+ */
+class ApiCommand
+{
+public:
+    enum Type {
+        Pause,
+        Resume,
+        SetPool,
+        SetThreads,
+        SetAlgoVariant,
+        SetThreadEnabled
+    };
+
+    inline ApiCommand(Type type, int value = 0, int index = 0) : type(type), index(index), value(value) {}
+
+    Type type;
+    int index;
+    int value;
+};
+
+#endif /* __APICOMMAND_H__ */
@@ -21,7 +21,10 @@
  *   along with this program. If not, see <http://www.gnu.org/licenses/>.
  */
 
+#include <inttypes.h>
 #include <math.h>
+#include <stdarg.h>
+#include <stdio.h>
 #include <string.h>
 #include <uv.h>
 
@@ -33,16 +36,22 @@
 
 
 #include "api/ApiState.h"
+#include "Cgroup.h"
 #include "Cpu.h"
+#include "crypto/CryptoNight.h"
 #include "Mem.h"
 #include "net/Job.h"
+#include "net/Url.h"
 #include "Options.h"
 #include "Platform.h"
 #include "rapidjson/document.h"
 #include "rapidjson/stringbuffer.h"
 #include "rapidjson/prettywriter.h"
+#include "rapidjson/writer.h"
 #include "version.h"
+#include "workers/Governor.h"
 #include "workers/Hashrate.h"
+#include "workers/Workers.h"
 
 
 extern "C"
@@ -61,10 +70,67 @@ static inline double normalize(double d)
 }
 
 
+/**
+ * @brief Append formatted text, on overflow pos set to size and all following calls ignored.
+ */
+static void append(char *buf, size_t size, size_t &pos, const char *fmt, ...)
+{
+    if (pos >= size) {
+        return;
+    }
+
+    va_list args;
+    va_start(args, fmt);
+    const int rc = vsnprintf(buf + pos, size - pos, fmt, args);
+    va_end(args);
+
+    if (rc > 0) {
+        pos = (pos + rc) < size ? (pos + rc) : size;
+    }
+}
+
+
+/**
+ * @brief Escape label value per Prometheus text format: backslash, double quote and line feed.
+ */
+static const char *escapeLabel(const char *in, char *out, size_t size)
+{
+    size_t pos = 0;
+
+    for (; *in && pos + 2 < size; ++in) {
+        switch (*in) {
+        case '\\':
+        case '"':
+            out[pos++] = '\\';
+            out[pos++] = *in;
+            break;
+
+        case '\n':
+            out[pos++] = '\\';
+            out[pos++] = 'n';
+            break;
+
+        default:
+            out[pos++] = *in;
+            break;
+        }
+    }
+
+    out[pos] = '\0';
+    return out;
+}
+
+
+static const char *kIntervals[3] = { "2.5s", "60s", "15m" };
+
+
 ApiState::ApiState()
 {
-    m_threads  = Options::i()->threads();
-    m_hashrate = new double[m_threads * 3]();
+    m_threads  = 0;
+    m_hashrate = nullptr;
+    m_metrics  = nullptr;
+
+    resize(Options::i()->threads());
 
     memset(m_totalHashrate, 0, sizeof(m_totalHashrate));
     memset(m_workerId, 0, sizeof(m_workerId));
@@ -83,26 +149,181 @@ ApiState::ApiState()
 ApiState::~ApiState()
 {
     delete [] m_hashrate;
+    delete [] m_metrics;
 }
 
 
-char *ApiState::get(const char *url, int *status) const
+/**
+ * @brief Serialize state for requested URL.
+ *
+ * Known section URLs return only own section, so frequent polling of small sections like
+ * "/hashrate" not pay for whole document. "/" and any other URL return full document,
+ * as all URLs did before sections were added.
+ */
+char *ApiState::get(const char *url, bool pretty) const
 {
     rapidjson::Document doc;
     doc.SetObject();
 
-    getIdentify(doc);
-    getMiner(doc);
-    getHashrate(doc);
-    getResults(doc);
-    getConnection(doc);
+    if (strcmp(url, "/hashrate") == 0) {
+        getIdentify(doc);
+        getHashrate(doc);
+    }
+    else if (strcmp(url, "/results") == 0) {
+        getIdentify(doc);
+        getResults(doc);
+    }
+    else if (strcmp(url, "/connection") == 0) {
+        getIdentify(doc);
+        getConnection(doc);
+    }
+    else if (strcmp(url, "/config") == 0) {
+        getIdentify(doc);
+        getConfig(doc);
+    }
+    else if (strcmp(url, "/threads") == 0) {
+        getIdentify(doc);
+        getThreads(doc);
+    }
+    else {
+        getIdentify(doc);
+        getMiner(doc);
+        getHashrate(doc);
+        getResults(doc);
+        getConnection(doc);
+    }
+
+    return finalize(doc, pretty);
+}
+
+
+/**
+ * @brief Render state in Prometheus text exposition format.
+ *
+ * Output is written into buffer allocated once in constructor, no DOM is involved.
+ * If buffer is too small it doubled and output rendered again, so exposition never truncated.
+ */
+const char *ApiState::metrics(size_t *size)
+{
+    size_t pos = writeMetrics(m_metrics, m_metricsSize);
+
+    while (pos >= m_metricsSize) {
+        delete [] m_metrics;
+
+        m_metricsSize *= 2;
+        m_metrics      = new char[m_metricsSize];
 
-    return finalize(doc);
+        pos = writeMetrics(m_metrics, m_metricsSize);
+    }
+
+    *size = pos;
+    return m_metrics;
+}
+
+
+size_t ApiState::writeMetrics(char *buf, size_t sz) const
+{
+    size_t pos = 0;
+    char pool[sizeof(NetworkState::PoolStats::name) * 2];
+
+    append(buf, sz, pos, "# HELP xmrig_info Miner information.\n# TYPE xmrig_info gauge\n");
+    append(buf, sz, pos, "xmrig_info{version=\"%s\",kind=\"%s\",algo=\"%s\",av=\"%d\"} 1\n", APP_VERSION, APP_KIND, Options::i()->algoName(), Options::i()->algoVariant());
+
+    append(buf, sz, pos, "# HELP xmrig_hashrate Total hashrate in H/s.\n# TYPE xmrig_hashrate gauge\n");
+    for (int i = 0; i < 3; ++i) {
+        append(buf, sz, pos, "xmrig_hashrate{interval=\"%s\"} %.2f\n", kIntervals[i], normalize(m_totalHashrate[i]));
+    }
+
+    append(buf, sz, pos, "# HELP xmrig_hashrate_highest Highest total hashrate in H/s.\n# TYPE xmrig_hashrate_highest gauge\n");
+    append(buf, sz, pos, "xmrig_hashrate_highest %.2f\n", normalize(m_highestHashrate));
+
+    append(buf, sz, pos, "# HELP xmrig_thread_hashrate Per thread hashrate in H/s.\n# TYPE xmrig_thread_hashrate gauge\n");
+    for (int i = 0; i < m_threads; ++i) {
+        for (int j = 0; j < 3; ++j) {
+            append(buf, sz, pos, "xmrig_thread_hashrate{thread=\"%d\",interval=\"%s\"} %.2f\n", i, kIntervals[j], normalize(m_hashrate[i * 3 + j]));
+        }
+    }
+
+    append(buf, sz, pos, "# HELP xmrig_thread_resume_latency_max_microseconds Longest delay between resume request and thread resumed.\n# TYPE xmrig_thread_resume_latency_max_microseconds gauge\n");
+    for (int i = 0; i < m_threads; ++i) {
+        append(buf, sz, pos, "xmrig_thread_resume_latency_max_microseconds{thread=\"%d\"} %" PRIu64 "\n", i, Workers::control(i).latencyMax());
+    }
+
+    append(buf, sz, pos, "# HELP xmrig_shares_accepted_total Shares accepted by pool.\n# TYPE xmrig_shares_accepted_total counter\n");
+    append(buf, sz, pos, "xmrig_shares_accepted_total %" PRIu64 "\n", m_network.accepted);
+
+    append(buf, sz, pos, "# HELP xmrig_shares_rejected_total Shares rejected by pool.\n# TYPE xmrig_shares_rejected_total counter\n");
+    append(buf, sz, pos, "xmrig_shares_rejected_total %" PRIu64 "\n", m_network.rejected);
+
+    append(buf, sz, pos, "# HELP xmrig_hashes_total Sum of difficulty of accepted shares.\n# TYPE xmrig_hashes_total counter\n");
+    append(buf, sz, pos, "xmrig_hashes_total %" PRIu64 "\n", m_network.total);
+
+    append(buf, sz, pos, "# HELP xmrig_pool_shares_accepted_total Shares accepted per pool.\n# TYPE xmrig_pool_shares_accepted_total counter\n");
+    for (const NetworkState::PoolStats &stats : m_network.poolStats()) {
+        append(buf, sz, pos, "xmrig_pool_shares_accepted_total{pool=\"%s\"} %" PRIu64 "\n", escapeLabel(stats.name, pool, sizeof(pool)), stats.accepted);
+    }
+
+    append(buf, sz, pos, "# HELP xmrig_pool_shares_rejected_total Shares rejected per pool.\n# TYPE xmrig_pool_shares_rejected_total counter\n");
+    for (const NetworkState::PoolStats &stats : m_network.poolStats()) {
+        append(buf, sz, pos, "xmrig_pool_shares_rejected_total{pool=\"%s\"} %" PRIu64 "\n", escapeLabel(stats.name, pool, sizeof(pool)), stats.rejected);
+    }
+
+    append(buf, sz, pos, "# HELP xmrig_difficulty Current job difficulty.\n# TYPE xmrig_difficulty gauge\n");
+    append(buf, sz, pos, "xmrig_difficulty %u\n", m_network.diff);
+
+    append(buf, sz, pos, "# HELP xmrig_job_switches_total Jobs received from pool and passed to workers.\n# TYPE xmrig_job_switches_total counter\n");
+    append(buf, sz, pos, "xmrig_job_switches_total %" PRIu64 "\n", m_network.jobs);
+
+    append(buf, sz, pos, "# HELP xmrig_pool_latency_milliseconds Median share submit round trip time.\n# TYPE xmrig_pool_latency_milliseconds gauge\n");
+    append(buf, sz, pos, "xmrig_pool_latency_milliseconds %u\n", m_network.latency());
+
+    static const double quantiles[] = { 0.5, 0.9, 0.99 };
+
+    append(buf, sz, pos, "# HELP xmrig_pool_submit_latency_milliseconds Share submit round trip time per pool.\n# TYPE xmrig_pool_submit_latency_milliseconds summary\n");
+    for (const NetworkState::PoolStats &stats : m_network.poolStats()) {
+        escapeLabel(stats.name, pool, sizeof(pool));
+
+        for (double q : quantiles) {
+            append(buf, sz, pos, "xmrig_pool_submit_latency_milliseconds{pool=\"%s\",quantile=\"%g\"} %u\n", pool, q, stats.latency.quantile(q));
+        }
+
+        append(buf, sz, pos, "xmrig_pool_submit_latency_milliseconds_sum{pool=\"%s\"} %" PRIu64 "\n", pool, stats.latency.sum());
+        append(buf, sz, pos, "xmrig_pool_submit_latency_milliseconds_count{pool=\"%s\"} %" PRIu64 "\n", pool, stats.latency.count());
+    }
+
+    append(buf, sz, pos, "# HELP xmrig_pool_uptime_seconds Current pool connection uptime.\n# TYPE xmrig_pool_uptime_seconds gauge\n");
+    append(buf, sz, pos, "xmrig_pool_uptime_seconds %u\n", m_network.connectionTime());
+
+    append(buf, sz, pos, "# HELP xmrig_pool_failures_total Pool connection failures.\n# TYPE xmrig_pool_failures_total counter\n");
+    append(buf, sz, pos, "xmrig_pool_failures_total %" PRIu64 "\n", m_network.failures);
+
+    append(buf, sz, pos, "# HELP xmrig_hugepages_available Huge pages available.\n# TYPE xmrig_hugepages_available gauge\n");
+    append(buf, sz, pos, "xmrig_hugepages_available %d\n", Mem::isHugepagesAvailable() ? 1 : 0);
+
+    append(buf, sz, pos, "# HELP xmrig_hugepages_enabled Huge pages used for scratchpads.\n# TYPE xmrig_hugepages_enabled gauge\n");
+    append(buf, sz, pos, "xmrig_hugepages_enabled %d\n", Mem::isHugepagesEnabled() ? 1 : 0);
+
+    append(buf, sz, pos, "# HELP xmrig_threads Number of mining threads.\n# TYPE xmrig_threads gauge\n");
+    append(buf, sz, pos, "xmrig_threads %d\n", m_threads);
+
+    if (Governor::isEnabled()) {
+        append(buf, sz, pos, "# HELP xmrig_governor_host_load Host CPU load in percent.\n# TYPE xmrig_governor_host_load gauge\n");
+        append(buf, sz, pos, "xmrig_governor_host_load %.2f\n", normalize(Governor::load()));
+
+        append(buf, sz, pos, "# HELP xmrig_governor_duty Share of time mining threads allowed to run.\n# TYPE xmrig_governor_duty gauge\n");
+        append(buf, sz, pos, "xmrig_governor_duty %.2f\n", normalize(Governor::duty()));
+    }
+
+    return pos;
 }
 
 
 void ApiState::tick(const Hashrate *hashrate)
 {
+    if (hashrate->threads() != m_threads) {
+        resize(hashrate->threads());
+    }
+
     for (int i = 0; i < m_threads; ++i) {
         m_hashrate[i * 3]     = hashrate->calc((size_t) i, Hashrate::ShortInterval);
         m_hashrate[i * 3 + 1] = hashrate->calc((size_t) i, Hashrate::MediumInterval);
@@ -122,12 +343,20 @@ void ApiState::tick(const NetworkState &network)
 }
 
 
-char *ApiState::finalize(rapidjson::Document &doc) const
+char *ApiState::finalize(rapidjson::Document &doc, bool pretty) const
 {
     rapidjson::StringBuffer buffer(0, 4096);
-    rapidjson::PrettyWriter<rapidjson::StringBuffer> writer(buffer);
-    writer.SetMaxDecimalPlaces(10);
-    doc.Accept(writer);
+
+    if (pretty) {
+        rapidjson::PrettyWriter<rapidjson::StringBuffer> writer(buffer);
+        writer.SetMaxDecimalPlaces(10);
+        doc.Accept(writer);
+    }
+    else {
+        rapidjson::Writer<rapidjson::StringBuffer> writer(buffer);
+        writer.SetMaxDecimalPlaces(10);
+        doc.Accept(writer);
+    }
 
     return strdup(buffer.GetString());
 }
@@ -166,6 +395,71 @@ void ApiState::genId()
 }
 
 
+void ApiState::getConfig(rapidjson::Document &doc) const
+{
+    auto &allocator = doc.GetAllocator();
+    const Options *options = Options::i();
+
+    rapidjson::Value config(rapidjson::kObjectType);
+    config.AddMember("algo",          rapidjson::StringRef(options->algoName()), allocator);
+    config.AddMember("av",            options->algoVariant(), allocator);
+    config.AddMember("background",    options->background(), allocator);
+    config.AddMember("colors",        options->colors(), allocator);
+
+    if (options->autoAffinity()) {
+        config.AddMember("cpu-affinity", "auto", allocator);
+    }
+    else if (!options->affinity().isEmpty()) {
+        char affinity[512];
+        options->affinity().toString(affinity, sizeof(affinity));
+        config.AddMember("cpu-affinity", rapidjson::Value(affinity, allocator), allocator);
+    }
+    else {
+        config.AddMember("cpu-affinity", rapidjson::Value(rapidjson::kNullType), allocator);
+    }
+
+    config.AddMember("cpu-priority",  options->priority() != -1 ? rapidjson::Value(options->priority()) : rapidjson::Value(rapidjson::kNullType), allocator);
+    config.AddMember("donate-level",  options->donateLevel(), allocator);
+    config.AddMember("huge-pages",    options->hugePages(), allocator);
+    config.AddMember("load-target",   options->loadTarget(), allocator);
+    config.AddMember("pool-strategy", rapidjson::StringRef(options->poolStrategyName()), allocator);
+    config.AddMember("print-time",    options->printTime(), allocator);
+    config.AddMember("proxy-port",    options->proxyPort(), allocator);
+    config.AddMember("recv-buffer",   options->recvBuffer(), allocator);
+    config.AddMember("retries",       options->retries(), allocator);
+    config.AddMember("retry-pause",   options->retryPause(), allocator);
+    config.AddMember("standby",       options->standby(), allocator);
+    config.AddMember("threads",       options->threads(), allocator);
+
+    rapidjson::Value pools(rapidjson::kArrayType);
+    char url[300];
+
+    for (const Url *pool : options->pools()) {
+        snprintf(url, sizeof(url), "%s:%d", pool->host(), pool->port());
+
+        rapidjson::Value value(rapidjson::kObjectType);
+        value.AddMember("url",       rapidjson::Value(url, allocator), allocator);
+        value.AddMember("user",      rapidjson::StringRef(pool->user()), allocator);
+        value.AddMember("keepalive", pool->isKeepAlive(), allocator);
+        value.AddMember("nicehash",  pool->isNicehash(), allocator);
+        value.AddMember("weight",    pool->weight(), allocator);
+
+        pools.PushBack(value, allocator);
+    }
+
+    config.AddMember("pools", pools, allocator);
+
+    rapidjson::Value api(rapidjson::kObjectType);
+    api.AddMember("port",      options->apiPort(), allocator);
+    api.AddMember("worker-id", rapidjson::StringRef(m_workerId), allocator);
+    api.AddMember("restricted", options->apiRestricted(), allocator);
+
+    config.AddMember("api", api, allocator);
+
+    doc.AddMember("config", config, allocator);
+}
+
+
 void ApiState::getConnection(rapidjson::Document &doc) const
 {
     auto &allocator = doc.GetAllocator();
@@ -175,12 +469,57 @@ void ApiState::getConnection(rapidjson::Document &doc) const
     connection.AddMember("uptime",    m_network.connectionTime(), allocator);
     connection.AddMember("ping",      m_network.latency(), allocator);
     connection.AddMember("failures",  m_network.failures, allocator);
-    connection.AddMember("error_log", rapidjson::Value(rapidjson::kArrayType), allocator);
+
+    rapidjson::Value latency(rapidjson::kObjectType);
+    getLatency(doc, latency, m_network.connectionLatency());
+    connection.AddMember("latency", latency, allocator);
+
+    rapidjson::Value window(rapidjson::kObjectType);
+    getLatency(doc, window, m_network.windowLatency());
+    connection.AddMember("latency_window", window, allocator);
+
+    rapidjson::Value errors(rapidjson::kArrayType);
+    getErrorLog(doc, errors, m_network.connectionErrors());
+
+    connection.AddMember("error_log", errors, allocator);
+
+    const WriteQueue::Stats &queue = m_network.writeQueue;
+
+    rapidjson::Value writeQueue(rapidjson::kObjectType);
+    writeQueue.AddMember("depth",     (uint64_t) queue.depth, allocator);
+    writeQueue.AddMember("peak",      (uint64_t) queue.peak, allocator);
+    writeQueue.AddMember("bytes",     (uint64_t) queue.bytes, allocator);
+    writeQueue.AddMember("direct",    queue.direct, allocator);
+    writeQueue.AddMember("batches",   queue.batches, allocator);
+    writeQueue.AddMember("coalesced", queue.coalesced, allocator);
+    writeQueue.AddMember("partial",   queue.partial, allocator);
+    writeQueue.AddMember("overflows", queue.overflows, allocator);
+
+    connection.AddMember("write_queue", writeQueue, allocator);
 
     doc.AddMember("connection", connection, allocator);
 }
 
 
+void ApiState::getErrorLog(rapidjson::Document &doc, rapidjson::Value &out, const ErrorLog &log) const
+{
+    auto &allocator = doc.GetAllocator();
+
+    for (size_t i = 0; i < log.size(); ++i) {
+        const ErrorLog::Entry &entry = log.at(i);
+
+        rapidjson::Value error(rapidjson::kObjectType);
+        error.AddMember("time",    entry.time, allocator);
+        error.AddMember("pool",    rapidjson::StringRef(entry.pool), allocator);
+        error.AddMember("job_id",  entry.jobId[0] ? rapidjson::Value(rapidjson::StringRef(entry.jobId)) : rapidjson::Value(rapidjson::kNullType), allocator);
+        error.AddMember("diff",    entry.diff, allocator);
+        error.AddMember("message", rapidjson::StringRef(entry.message), allocator);
+
+        out.PushBack(error, allocator);
+    }
+}
+
+
 void ApiState::getHashrate(rapidjson::Document &doc) const
 {
     auto &allocator = doc.GetAllocator();
@@ -216,6 +555,18 @@ void ApiState::getIdentify(rapidjson::Document &doc) const
 }
 
 
+void ApiState::getLatency(rapidjson::Document &doc, rapidjson::Value &out, const LatencyHistogram &histogram) const
+{
+    auto &allocator = doc.GetAllocator();
+
+    out.AddMember("count", histogram.count(), allocator);
+    out.AddMember("p50",   histogram.quantile(0.5), allocator);
+    out.AddMember("p90",   histogram.quantile(0.9), allocator);
+    out.AddMember("p99",   histogram.quantile(0.99), allocator);
+    out.AddMember("max",   histogram.max(), allocator);
+}
+
+
 void ApiState::getMiner(rapidjson::Document &doc) const
 {
     auto &allocator = doc.GetAllocator();
@@ -226,16 +577,80 @@ void ApiState::getMiner(rapidjson::Document &doc) const
     cpu.AddMember("x64",     Cpu::isX64(), allocator);
     cpu.AddMember("sockets", Cpu::sockets(), allocator);
 
+    rapidjson::Value cgroup(rapidjson::kObjectType);
+    cgroup.AddMember("version",       Cgroup::version(), allocator);
+    cgroup.AddMember("cpu_quota",     Cgroup::cpuQuota() > 0 ? rapidjson::Value(Cgroup::cpuQuota() / 1000.0) : rapidjson::Value(rapidjson::kNullType), allocator);
+    cgroup.AddMember("cpus",          Cgroup::cpus() > 0 ? rapidjson::Value(Cgroup::cpus()) : rapidjson::Value(rapidjson::kNullType), allocator);
+    cgroup.AddMember("memory_limit",  Cgroup::memoryLimit() >= 0 ? rapidjson::Value(Cgroup::memoryLimit()) : rapidjson::Value(rapidjson::kNullType), allocator);
+    cgroup.AddMember("hugetlb_limit", Cgroup::hugetlbLimit() >= 0 ? rapidjson::Value(Cgroup::hugetlbLimit()) : rapidjson::Value(rapidjson::kNullType), allocator);
+    cgroup.AddMember("max_threads",   Cgroup::maxThreads(MEMORY * (Options::i()->doubleHash() && Options::i()->algo() != Options::ALGO_CRYPTONIGHT_LITE ? 2 : 1)), allocator);
+
     doc.AddMember("version",      APP_VERSION, allocator);
     doc.AddMember("kind",         APP_KIND, allocator);
     doc.AddMember("ua",           rapidjson::StringRef(Platform::userAgent()), allocator);
     doc.AddMember("cpu",          cpu, allocator);
+    doc.AddMember("cgroup",       cgroup, allocator);
     doc.AddMember("algo",         rapidjson::StringRef(Options::i()->algoName()), allocator);
     doc.AddMember("hugepages",    Mem::isHugepagesEnabled(), allocator);
     doc.AddMember("donate_level", Options::i()->donateLevel(), allocator);
 }
 
 
+void ApiState::getThreads(rapidjson::Document &doc) const
+{
+    auto &allocator = doc.GetAllocator();
+
+    rapidjson::Value threads(rapidjson::kArrayType);
+
+    for (int i = 0; i < m_threads; ++i) {
+        rapidjson::Value hashrate(rapidjson::kArrayType);
+        hashrate.PushBack(normalize(m_hashrate[i * 3]),     allocator);
+        hashrate.PushBack(normalize(m_hashrate[i * 3 + 1]), allocator);
+        hashrate.PushBack(normalize(m_hashrate[i * 3 + 2]), allocator);
+
+        const ThreadControl &control = Workers::control(i);
+
+        rapidjson::Value latency(rapidjson::kObjectType);
+        latency.AddMember("last", control.latencyLast(), allocator);
+        latency.AddMember("avg",  control.latencyAvg(), allocator);
+        latency.AddMember("max",  control.latencyMax(), allocator);
+
+        rapidjson::Value thread(rapidjson::kObjectType);
+        thread.AddMember("id",             i, allocator);
+        thread.AddMember("enabled",        !control.isDisabled(), allocator);
+        thread.AddMember("throttled",      control.isThrottled(), allocator);
+
+        const Topology::Slot *slot = Workers::placement(i);
+        if (slot) {
+            thread.AddMember("cpu",    slot->cpu, allocator);
+            thread.AddMember("domain", slot->domain, allocator);
+        }
+        else {
+            thread.AddMember("cpu",    rapidjson::Value(rapidjson::kNullType), allocator);
+            thread.AddMember("domain", rapidjson::Value(rapidjson::kNullType), allocator);
+        }
+
+        thread.AddMember("hashrate",       hashrate, allocator);
+        thread.AddMember("resume_latency", latency, allocator);
+
+        threads.PushBack(thread, allocator);
+    }
+
+    doc.AddMember("av",          Options::i()->algoVariant(), allocator);
+    doc.AddMember("double_hash", Mem::isDoubleHash(), allocator);
+    doc.AddMember("paused",      !Workers::isEnabled(), allocator);
+
+    rapidjson::Value governor(rapidjson::kObjectType);
+    governor.AddMember("target",   Governor::target(), allocator);
+    governor.AddMember("load",     normalize(Governor::load()), allocator);
+    governor.AddMember("pressure", normalize(Governor::pressure()), allocator);
+    governor.AddMember("duty",     normalize(Governor::duty()), allocator);
+
+    doc.AddMember("governor", governor, allocator);
+    doc.AddMember("threads",     threads, allocator);
+}
+
+
 void ApiState::getResults(rapidjson::Document &doc) const
 {
     auto &allocator = doc.GetAllocator();
@@ -253,8 +668,42 @@ void ApiState::getResults(rapidjson::Document &doc) const
         best.PushBack(m_network.topDiff[i], allocator);
     }
 
+    rapidjson::Value errors(rapidjson::kArrayType);
+    getErrorLog(doc, errors, m_network.rejects());
+
+    rapidjson::Value pools(rapidjson::kArrayType);
+    for (const NetworkState::PoolStats &stats : m_network.poolStats()) {
+        rapidjson::Value pool(rapidjson::kObjectType);
+        pool.AddMember("pool",        rapidjson::StringRef(stats.name), allocator);
+        pool.AddMember("accepted",    stats.accepted, allocator);
+        pool.AddMember("rejected",    stats.rejected, allocator);
+        pool.AddMember("reject_rate", normalize(stats.rejectRate() * 100.0), allocator);
+
+        rapidjson::Value latency(rapidjson::kObjectType);
+        getLatency(doc, latency, stats.latency);
+        pool.AddMember("latency", latency, allocator);
+
+        pools.PushBack(pool, allocator);
+    }
+
     results.AddMember("best",      best, allocator);
-    results.AddMember("error_log", rapidjson::Value(rapidjson::kArrayType), allocator);
+    results.AddMember("error_log", errors, allocator);
+    results.AddMember("pools",     pools, allocator);
 
     doc.AddMember("results", results, allocator);
 }
+
+
+/**
+ * @brief Reallocate per thread storage after thread count changed, called on the event loop thread only.
+ */
+void ApiState::resize(int threads)
+{
+    delete [] m_hashrate;
+    delete [] m_metrics;
+
+    m_threads     = threads;
+    m_hashrate    = new double[m_threads * 3]();
+    m_metricsSize = 4096 + m_threads * 4 * 80 + NetworkState::kMaxPools * 6 * 192;
+    m_metrics     = new char[m_metricsSize];
+}
@@ -29,7 +29,9 @@
 #include "rapidjson/fwd.h"
 
 
+class ErrorLog;
 class Hashrate;
+class LatencyHistogram;
 
 
 class ApiState
@@ -38,26 +40,35 @@ public:
     ApiState();
     ~ApiState();
 
-    char *get(const char *url, int *status) const;
+    char *get(const char *url, bool pretty) const;
+    const char *metrics(size_t *size);
     void tick(const Hashrate *hashrate);
     void tick(const NetworkState &results);
 
 private:
-    char *finalize(rapidjson::Document &doc) const;
+    char *finalize(rapidjson::Document &doc, bool pretty) const;
     void genId();
+    void getErrorLog(rapidjson::Document &doc, rapidjson::Value &out, const ErrorLog &log) const;
+    void getConfig(rapidjson::Document &doc) const;
     void getConnection(rapidjson::Document &doc) const;
     void getHashrate(rapidjson::Document &doc) const;
     void getIdentify(rapidjson::Document &doc) const;
+    void getLatency(rapidjson::Document &doc, rapidjson::Value &out, const LatencyHistogram &histogram) const;
     void getMiner(rapidjson::Document &doc) const;
     void getResults(rapidjson::Document &doc) const;
+    void getThreads(rapidjson::Document &doc) const;
+    size_t writeMetrics(char *buf, size_t sz) const;
+    void resize(int threads);
 
     char m_id[17];
     char m_workerId[128];
+    char *m_metrics;
     double *m_hashrate;
     double m_highestHashrate;
     double m_totalHashrate[3];
     int m_threads;
     NetworkState m_network;
+    size_t m_metricsSize;
 };
 
 #endif /* __APISTATE_H__ */
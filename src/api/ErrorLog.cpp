@@ -0,0 +1,56 @@
+/* XMRig
+ * Copyright 2010      Jeff Garzik <jgarzik@pobox.com>
+ * Copyright 2012-2014 pooler      <pooler@litecoinpool.org>
+ * Copyright 2014      Lucas Jones <https://github.com/lucasjones>
+ * Copyright 2014-2016 Wolf9466    <https://github.com/OhGodAPet>
+ * Copyright 2016      Jay D Dee   <jayddee246@gmail.com>
+ * Copyright 2016-2017 XMRig       <support@xmrig.com>
+ *
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include <string.h>
+#include <time.h>
+
+
+#include "api/ErrorLog.h"
+
+
+static inline void copy(char *dst, const char *src, size_t size)
+{
+    if (!src) {
+        dst[0] = '\0';
+        return;
+    }
+
+    strncpy(dst, src, size - 1);
+    dst[size - 1] = '\0';
+}
+
+
+void ErrorLog::add(const char *pool, const char *jobId, uint32_t diff, const char *message)
+{
+    Entry &entry = m_entries[m_count % kSize];
+
+    copy(entry.pool,    pool,    sizeof(entry.pool));
+    copy(entry.jobId,   jobId,   sizeof(entry.jobId));
+    copy(entry.message, message, sizeof(entry.message));
+
+    entry.diff = diff;
+    entry.time = static_cast<uint64_t>(time(nullptr));
+
+    m_count++;
+}
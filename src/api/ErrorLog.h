@@ -0,0 +1,63 @@
+/* XMRig
+ * Copyright 2010      Jeff Garzik <jgarzik@pobox.com>
+ * Copyright 2012-2014 pooler      <pooler@litecoinpool.org>
+ * Copyright 2014      Lucas Jones <https://github.com/lucasjones>
+ * Copyright 2014-2016 Wolf9466    <https://github.com/OhGodAPet>
+ * Copyright 2016      Jay D Dee   <jayddee246@gmail.com>
+ * Copyright 2016-2017 XMRig       <support@xmrig.com>
+ *
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef __ERRORLOG_H__
+#define __ERRORLOG_H__
+
+
+#include <array>
+#include <stddef.h>
+#include <stdint.h>
+
+
+/**
+ * Fixed size ring buffer of recent errors, oldest entries overwritten.
+ */
+class ErrorLog
+{
+public:
+    constexpr static size_t kSize = 16;
+
+    struct Entry
+    {
+        char jobId[64];
+        char message[128];
+        char pool[128];
+        uint32_t diff;
+        uint64_t time;
+    };
+
+    inline ErrorLog() : m_count(0) {}
+
+    inline const Entry &at(size_t index) const { return m_entries[(m_count - 1 - index) % kSize]; } // 0 is newest entry
+    inline size_t size() const                 { return m_count < kSize ? m_count : kSize; }
+    inline uint64_t count() const              { return m_count; }
+
+    void add(const char *pool, const char *jobId, uint32_t diff, const char *message);
+
+private:
+    std::array<Entry, kSize> m_entries;
+    uint64_t m_count;
+};
+
+#endif /* __ERRORLOG_H__ */
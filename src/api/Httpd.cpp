@@ -27,11 +27,43 @@
 
 
 #include "api/Api.h"
+#include "api/ApiBuffer.h"
 #include "api/Httpd.h"
 #include "log/Log.h"
 
 
-Httpd::Httpd(int port, const char *accessToken) :
+/**
+ * Per request state, holds uploaded body of write requests and response buffer until request completed.
+ */
+class HttpContext
+{
+public:
+    constexpr static size_t kMaxBody = 1024;
+
+    inline HttpContext() : buffer(nullptr), overflow(false), size(0) { body[0] = '\0'; }
+    inline ~HttpContext()
+    {
+        if (buffer) {
+            buffer->release();
+        }
+    }
+
+    ApiBuffer *buffer;
+    bool overflow;
+    char body[kMaxBody + 1];
+    size_t size;
+};
+
+
+static void onRequestCompleted(void *cls, MHD_Connection *connection, void **con_cls, MHD_RequestTerminationCode toe)
+{
+    delete static_cast<HttpContext*>(*con_cls);
+    *con_cls = nullptr;
+}
+
+
+Httpd::Httpd(int port, const char *accessToken, bool restricted) :
+    m_restricted(restricted),
     m_accessToken(accessToken),
     m_port(port),
     m_daemon(nullptr)
@@ -45,7 +77,9 @@ bool Httpd::start()
         return false;
     }
 
-    m_daemon = MHD_start_daemon(MHD_USE_SELECT_INTERNALLY, m_port, nullptr, nullptr, &Httpd::handler, this, MHD_OPTION_END);
+    m_daemon = MHD_start_daemon(MHD_USE_SELECT_INTERNALLY, m_port, nullptr, nullptr, &Httpd::handler, this,
+                                MHD_OPTION_NOTIFY_COMPLETED, onRequestCompleted, nullptr,
+                                MHD_OPTION_END);
     if (!m_daemon) {
         LOG_ERR("HTTP Daemon failed to start.");
         return false;
@@ -55,8 +89,12 @@ bool Httpd::start()
 }
 
 
-int Httpd::auth(const char *header)
+int Httpd::auth(const char *header, bool write) const
 {
+    if (write && (m_restricted || !m_accessToken)) {
+        return MHD_HTTP_FORBIDDEN;
+    }
+
     if (!m_accessToken) {
         return MHD_HTTP_OK;
     }
@@ -74,16 +112,16 @@ int Httpd::auth(const char *header)
 }
 
 
-int Httpd::done(MHD_Connection *connection, int status, MHD_Response *rsp)
+int Httpd::done(MHD_Connection *connection, int status, MHD_Response *rsp, const char *contentType)
 {
     if (!rsp) {
         rsp = MHD_create_response_from_buffer(0, nullptr, MHD_RESPMEM_PERSISTENT);
     }
 
-    MHD_add_response_header(rsp, "Content-Type", "application/json");
+    MHD_add_response_header(rsp, "Content-Type", contentType);
     MHD_add_response_header(rsp, "Access-Control-Allow-Origin", "*");
-    MHD_add_response_header(rsp, "Access-Control-Allow-Methods", "GET");
-    MHD_add_response_header(rsp, "Access-Control-Allow-Headers", "Authorization");
+    MHD_add_response_header(rsp, "Access-Control-Allow-Methods", "GET, PUT, POST");
+    MHD_add_response_header(rsp, "Access-Control-Allow-Headers", "Authorization, Content-Type");
 
     const int ret = MHD_queue_response(connection, status, rsp);
     MHD_destroy_response(rsp);
@@ -97,20 +135,61 @@ int Httpd::handler(void *cls, struct MHD_Connection *connection, const char *url
         return done(connection, MHD_HTTP_OK, nullptr);
     }
 
-    if (strcmp(method, "GET") != 0) {
+    const bool write = strcmp(method, "PUT") == 0 || strcmp(method, "POST") == 0;
+    if (!write && strcmp(method, "GET") != 0) {
         return MHD_NO;
     }
 
-    int status = static_cast<Httpd*>(cls)->auth(MHD_lookup_connection_value(connection, MHD_HEADER_KIND, "Authorization"));
-    if (status != MHD_HTTP_OK) {
-        return done(connection, status, nullptr);
+    auto ctx = static_cast<HttpContext*>(*con_cls);
+    if (!ctx) {
+        ctx = new HttpContext();
+        *con_cls = ctx;
+
+        const int status = static_cast<Httpd*>(cls)->auth(MHD_lookup_connection_value(connection, MHD_HEADER_KIND, "Authorization"), write);
+        if (status != MHD_HTTP_OK) {
+            return done(connection, status, nullptr);
+        }
+
+        // write request body delivered by next calls.
+        if (write) {
+            return MHD_YES;
+        }
+    }
+
+    ApiBuffer *buf = nullptr;
+
+    if (write) {
+        if (*upload_data_size) {
+            if (ctx->size + *upload_data_size > HttpContext::kMaxBody) {
+                ctx->overflow = true;
+            }
+            else {
+                memcpy(ctx->body + ctx->size, upload_data, *upload_data_size);
+                ctx->size += *upload_data_size;
+                ctx->body[ctx->size] = '\0';
+            }
+
+            *upload_data_size = 0;
+            return MHD_YES;
+        }
+
+        if (ctx->overflow) {
+            return done(connection, MHD_HTTP_REQUEST_ENTITY_TOO_LARGE, nullptr);
+        }
+
+        buf = Api::exec(method, url, ctx->body);
+    }
+    else {
+        const char *pretty = MHD_lookup_connection_value(connection, MHD_GET_ARGUMENT_KIND, "pretty");
+        buf = Api::get(url, pretty && strcmp(pretty, "1") == 0);
     }
 
-    char *buf = Api::get(url, &status);
     if (buf == nullptr) {
         return MHD_NO;
     }
 
-    MHD_Response *rsp = MHD_create_response_from_buffer(strlen(buf), (void*) buf, MHD_RESPMEM_MUST_FREE);
-    return done(connection, status, rsp);
+    ctx->buffer = buf;
+
+    MHD_Response *rsp = MHD_create_response_from_buffer(buf->size(), (void*) buf->data(), MHD_RESPMEM_PERSISTENT);
+    return done(connection, buf->status(), rsp, buf->contentType());
 }
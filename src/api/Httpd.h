@@ -36,15 +36,16 @@ struct MHD_Response;
 class Httpd
 {
 public:
-    Httpd(int port, const char *accessToken);
+    Httpd(int port, const char *accessToken, bool restricted);
     bool start();
 
 private:
-    int auth(const char *header);
+    int auth(const char *header, bool write) const;
 
-    static int done(MHD_Connection *connection, int status, MHD_Response *rsp);
+    static int done(MHD_Connection *connection, int status, MHD_Response *rsp, const char *contentType = "application/json");
     static int handler(void *cls, MHD_Connection *connection, const char *url, const char *method, const char *version, const char *upload_data, size_t *upload_data_size, void **con_cls);
 
+    const bool m_restricted;
     const char *m_accessToken;
     const int m_port;
     MHD_Daemon *m_daemon;
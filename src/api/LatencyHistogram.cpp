@@ -0,0 +1,150 @@
+/* XMRig
+ * Copyright 2010      Jeff Garzik <jgarzik@pobox.com>
+ * Copyright 2012-2014 pooler      <pooler@litecoinpool.org>
+ * Copyright 2014      Lucas Jones <https://github.com/lucasjones>
+ * Copyright 2014-2016 Wolf9466    <https://github.com/OhGodAPet>
+ * Copyright 2016      Jay D Dee   <jayddee246@gmail.com>
+ * Copyright 2016-2017 XMRig       <support@xmrig.com>
+ *
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <math.h>
+#include <string.h>
+
+
+#include "api/LatencyHistogram.h"
+
+
+LatencyHistogram::LatencyHistogram()
+{
+    reset();
+}
+
+
+/**
+ * @brief Value at quantile q (0.0 - 1.0), middle of the bucket but never above max seen value.
+ */
+uint32_t LatencyHistogram::quantile(double q) const
+{
+    if (m_count == 0) {
+        return 0;
+    }
+
+    uint64_t rank = (uint64_t) ceil(q * m_count);
+    if (rank == 0) {
+        rank = 1;
+    }
+
+    uint64_t seen = 0;
+    for (size_t i = 0; i < kBuckets; ++i) {
+        seen += m_buckets[i];
+
+        if (seen >= rank) {
+            const uint32_t result = value(i);
+            return result < m_max ? result : m_max;
+        }
+    }
+
+    return m_max;
+}
+
+
+void LatencyHistogram::add(uint32_t value)
+{
+    if (value > kMaxValue) {
+        value = kMaxValue;
+    }
+
+    // saturated bucket would skew quantiles, halve all buckets instead.
+    uint32_t &bucket = m_buckets[index(value)];
+    if (bucket == UINT32_MAX) {
+        m_count = 0;
+        m_sum  /= 2;
+
+        for (uint32_t &b : m_buckets) {
+            b /= 2;
+            m_count += b;
+        }
+    }
+
+    bucket++;
+    m_count++;
+    m_sum += value;
+
+    if (value > m_max) {
+        m_max = value;
+    }
+}
+
+
+void LatencyHistogram::merge(const LatencyHistogram &other)
+{
+    m_count = 0;
+
+    for (size_t i = 0; i < kBuckets; ++i) {
+        const uint64_t sum = (uint64_t) m_buckets[i] + other.m_buckets[i];
+        m_buckets[i] = sum > UINT32_MAX ? UINT32_MAX : (uint32_t) sum;
+        m_count += m_buckets[i];
+    }
+
+    m_sum += other.m_sum;
+
+    if (other.m_max > m_max) {
+        m_max = other.m_max;
+    }
+}
+
+
+void LatencyHistogram::reset()
+{
+    memset(m_buckets, 0, sizeof(m_buckets));
+    m_max   = 0;
+    m_count = 0;
+    m_sum   = 0;
+}
+
+
+size_t LatencyHistogram::index(uint32_t value)
+{
+    if (value > kMaxValue) {
+        value = kMaxValue;
+    }
+
+    if (value < (2u << kSubBits)) {
+        return value;
+    }
+
+    int msb = kSubBits + 1;
+    while ((value >> (msb + 1)) != 0) {
+        msb++;
+    }
+
+    const int shift = msb - kSubBits;
+    return ((size_t) shift << kSubBits) + (value >> shift);
+}
+
+
+uint32_t LatencyHistogram::value(size_t index)
+{
+    if (index < (2u << kSubBits)) {
+        return (uint32_t) index;
+    }
+
+    const int shift     = (int) (index >> kSubBits) - 1;
+    const uint32_t base = (uint32_t) (index - ((size_t) shift << kSubBits));
+
+    return (base << shift) + ((1u << shift) >> 1);
+}
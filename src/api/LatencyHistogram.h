@@ -0,0 +1,68 @@
+/* XMRig
+ * Copyright 2010      Jeff Garzik <jgarzik@pobox.com>
+ * Copyright 2012-2014 pooler      <pooler@litecoinpool.org>
+ * Copyright 2014      Lucas Jones <https://github.com/lucasjones>
+ * Copyright 2014-2016 Wolf9466    <https://github.com/OhGodAPet>
+ * Copyright 2016      Jay D Dee   <jayddee246@gmail.com>
+ * Copyright 2016-2017 XMRig       <support@xmrig.com>
+ *
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef __LATENCYHISTOGRAM_H__
+#define __LATENCYHISTOGRAM_H__
+
+
+#include <stddef.h>
+#include <stdint.h>
+
+
+/**
+ * Fixed size log-linear histogram of millisecond latencies (HDR style).
+ *
+ * Values below 2^(kSubBits+1) are exact, larger values fall into one of 2^kSubBits
+ * buckets per power of two, so quantiles are within 1/2^(kSubBits+1) relative error.
+ * Memory use does not depend on number of samples.
+ */
+class LatencyHistogram
+{
+public:
+    constexpr static int kSubBits       = 4;
+    constexpr static uint32_t kMaxValue = 0xFFFF;
+    constexpr static size_t kBuckets    = (16 - kSubBits + 1) << kSubBits;
+
+    LatencyHistogram();
+
+    uint32_t quantile(double q) const;
+    void add(uint32_t value);
+    void merge(const LatencyHistogram &other);
+    void reset();
+
+    static size_t index(uint32_t value);
+
+    inline uint32_t max() const   { return m_max; }
+    inline uint64_t count() const { return m_count; }
+    inline uint64_t sum() const   { return m_sum; }
+
+private:
+    static uint32_t value(size_t index);
+
+    uint32_t m_buckets[kBuckets];
+    uint32_t m_max;
+    uint64_t m_count;
+    uint64_t m_sum;
+};
+
+#endif /* __LATENCYHISTOGRAM_H__ */
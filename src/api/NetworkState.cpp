@@ -36,13 +36,16 @@ NetworkState::NetworkState() :
     diff(0),
     accepted(0),
     failures(0),
+    jobs(0),
     rejected(0),
     total(0),
+    writeQueue(),
     m_active(false)
 {
     memset(pool, 0, sizeof(pool));
     m_connectionTime = 0;
     m_totalTime = 0;
+    m_windowStart = 0;
 }
 
 
@@ -60,36 +63,56 @@ uint32_t NetworkState::connectionTime() const
 
 uint32_t NetworkState::avgTime() const
 {
-    if (m_latency.empty()) {
+    if (m_latency.count() == 0) {
         return 0;
     }
 
-    return connectionTime() / (uint32_t)m_latency.size();
+    return connectionTime() / (uint32_t) m_latency.count();
 }
 
 
-uint32_t NetworkState::latency() const
+/**
+ * @brief Latency of shares accepted during last kWindow to 2 * kWindow milliseconds.
+ */
+LatencyHistogram NetworkState::windowLatency() const
 {
-    const size_t calls = m_latency.size();
-    if (calls == 0) {
-        return 0;
-    }
+    LatencyHistogram histogram = m_windows[0];
+    histogram.merge(m_windows[1]);
+
+    return histogram;
+}
 
-    auto v = m_latency;
-    std::nth_element(v.begin(), v.begin() + calls / 2, v.end());
 
-    return v[calls / 2];
+uint32_t NetworkState::latency() const
+{
+    return m_latency.quantile(0.5);
 }
 
 
-void NetworkState::add(const SubmitResult &result, const char *error)
+void NetworkState::add(const char *host, int port, const SubmitResult &result, const char *error)
 {
+    char name[sizeof(PoolStats::name)];
+    snprintf(name, sizeof(name), "%s:%d", host, port);
+
+    PoolStats *stats = poolStats(name);
+
     if (error) {
         rejected++;
+        m_rejects.add(name, result.jobId.data(), result.diff, error);
+
+        if (stats) {
+            stats->rejected++;
+        }
+
         return;
     }
 
     accepted++;
+
+    if (stats) {
+        stats->accepted++;
+    }
+
     total += result.diff;
 
     const size_t ln = topDiff.size() - 1;
@@ -98,7 +121,23 @@ void NetworkState::add(const SubmitResult &result, const char *error)
         std::sort(topDiff.rbegin(), topDiff.rend());
     }
 
-    m_latency.push_back(result.elapsed > 0xFFFF ? 0xFFFF : (uint16_t) result.elapsed);
+    const uint32_t elapsed = result.elapsed > LatencyHistogram::kMaxValue ? LatencyHistogram::kMaxValue : (uint32_t) result.elapsed;
+
+    m_latency.add(elapsed);
+    m_windows[1].add(elapsed);
+
+    if (stats) {
+        stats->latency.add(elapsed);
+    }
+}
+
+
+void NetworkState::addError(const char *host, int port, const char *message)
+{
+    char name[sizeof(PoolStats::name)];
+    snprintf(name, sizeof(name), "%s:%d", host, port);
+
+    m_connectionErrors.add(name, nullptr, 0, message);
 }
 
 
@@ -118,5 +157,46 @@ void NetworkState::stop()
     diff     = 0;
 
     failures++;
-    m_latency.clear();
+    m_latency.reset();
+}
+
+
+void NetworkState::tick(uint64_t now)
+{
+    if (now - m_windowStart < kWindow) {
+        return;
+    }
+
+    // no ticks for whole window, previous samples are too old.
+    if (now - m_windowStart >= kWindow * 2) {
+        m_windows[0].reset();
+    }
+    else {
+        m_windows[0] = m_windows[1];
+    }
+
+    m_windows[1].reset();
+    m_windowStart = now;
+}
+
+
+NetworkState::PoolStats *NetworkState::poolStats(const char *name)
+{
+    for (PoolStats &stats : m_pools) {
+        if (strcmp(stats.name, name) == 0) {
+            return &stats;
+        }
+    }
+
+    if (m_pools.size() >= kMaxPools) {
+        return nullptr;
+    }
+
+    PoolStats stats;
+    memcpy(stats.name, name, sizeof(stats.name));
+    stats.accepted = 0;
+    stats.rejected = 0;
+
+    m_pools.push_back(stats);
+    return &m_pools.back();
 }
@@ -29,34 +29,69 @@
 #include <vector>
 
 
+#include "api/ErrorLog.h"
+#include "api/LatencyHistogram.h"
+#include "net/WriteQueue.h"
+
+
 class SubmitResult;
 
 
 class NetworkState
 {
 public:
+    constexpr static size_t kMaxPools   = 16;
+    constexpr static uint64_t kWindow   = 5 * 60 * 1000;
+
+    struct PoolStats
+    {
+        inline double rejectRate() const { return (accepted + rejected) > 0 ? (double) rejected / (accepted + rejected) : 0.0; }
+
+        char name[128];
+        LatencyHistogram latency;
+        uint64_t accepted;
+        uint64_t rejected;
+    };
+
     NetworkState();
 
+    inline const ErrorLog &connectionErrors() const       { return m_connectionErrors; }
+    inline const LatencyHistogram &connectionLatency() const { return m_latency; }
+    inline const ErrorLog &rejects() const                { return m_rejects; }
+    inline const std::vector<PoolStats> &poolStats() const { return m_pools; }
+
     uint32_t totalTime() const;
     uint32_t connectionTime() const;
     uint32_t avgTime() const;
+    LatencyHistogram windowLatency() const;
     uint32_t latency() const;
-    void add(const SubmitResult &result, const char *error);
+    void add(const char *host, int port, const SubmitResult &result, const char *error);
+    void addError(const char *host, int port, const char *message);
     void setPool(const char *host, int port, const char *ip);
     void stop();
+    void tick(uint64_t now);
 
     char pool[256];
     std::array<uint64_t, 10> topDiff { { } };
     uint32_t diff;
     uint64_t accepted;
     uint64_t failures;
+    uint64_t jobs;
     uint64_t rejected;
     uint64_t total;
+    WriteQueue::Stats writeQueue;
 
 private:
+    PoolStats *poolStats(const char *name);
+
     bool m_active;
-    std::vector<uint16_t> m_latency;
+    ErrorLog m_connectionErrors;
+    ErrorLog m_rejects;
+    std::vector<PoolStats> m_pools;
+    LatencyHistogram m_latency;
+    LatencyHistogram m_windows[2];
     uint64_t m_connectionTime;
+    uint64_t m_windowStart;
     uint32_t m_totalTime;
 };
 
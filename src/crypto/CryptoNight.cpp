@@ -22,6 +22,11 @@
  */
 
 
+#include <string.h>
+#include <uv.h>
+
+
+#include "Cpu.h"
 #include "crypto/CryptoNight.h"
 
 #if defined(XMRIG_ARM)
@@ -31,12 +36,24 @@
 #endif
 
 #include "crypto/CryptoNight_test.h"
+#include "log/Log.h"
 #include "net/Job.h"
 #include "net/JobResult.h"
 #include "Options.h"
 
 
 void (*cryptonight_hash_ctx)(const void *input, size_t size, void *output, cryptonight_ctx *ctx) = nullptr;
+uint32_t CryptoNight::m_verified = 0;
+
+
+struct SelfTestTask
+{
+    bool full;
+    bool ok;
+    bool thread;
+    int index;
+    uv_thread_t id;
+};
 
 
 static void cryptonight_av1_aesni(const void *input, size_t size, void *output, struct cryptonight_ctx *ctx) {
@@ -107,6 +124,9 @@ void (*cryptonight_variations[4])(const void *input, size_t size, void *output,
 #endif
 
 
+static const int kKernels = (int) (sizeof(cryptonight_variations) / sizeof(cryptonight_variations[0]));
+
+
 bool CryptoNight::hash(const Job &job, JobResult &result, cryptonight_ctx *ctx)
 {
     cryptonight_hash_ctx(job.blob(), job.size(), result.result, ctx);
@@ -115,21 +135,88 @@ bool CryptoNight::hash(const Job &job, JobResult &result, cryptonight_ctx *ctx)
 }
 
 
+/**
+ * @brief Select hash implementation, self-test runs only if kernel not verified yet.
+ */
 bool CryptoNight::init(int algo, int variant)
 {
     if (variant < 1 || variant > 4) {
         return false;
     }
 
+    const int i = index(algo, variant);
+    cryptonight_hash_ctx = cryptonight_variations[i];
+
+    if ((m_verified & (1u << i)) == 0) {
+        const bool doubleHash = variant == Options::AV2_AESNI_DOUBLE || variant == Options::AV4_SOFT_AES_DOUBLE;
+
+        m_verified |= selfTest(candidates(algo, doubleHash) | (1u << i), false);
+    }
+
+    return (m_verified & (1u << i)) != 0;
+}
+
+
+/**
+ * @brief Full known answer suite for all algorithms and kernels supported by CPU.
+ */
+bool CryptoNight::verify()
+{
+    uint32_t kernels = candidates(Options::ALGO_CRYPTONIGHT, false) | candidates(Options::ALGO_CRYPTONIGHT, true);
+
 #   ifndef XMRIG_NO_AEON
-    const int index = algo == Options::ALGO_CRYPTONIGHT_LITE ? (variant + 3) : (variant - 1);
-#   else
-    const int index = variant - 1;
+    kernels |= candidates(Options::ALGO_CRYPTONIGHT_LITE, false) | candidates(Options::ALGO_CRYPTONIGHT_LITE, true);
 #   endif
 
-    cryptonight_hash_ctx = cryptonight_variations[index];
+    const uint64_t start  = uv_hrtime();
+    const uint32_t passed = selfTest(kernels, true);
+    const uint64_t ms     = (uv_hrtime() - start) / 1000000;
+
+    int count  = 0;
+    int failed = 0;
+    for (int i = 0; i < kKernels; ++i) {
+        if ((kernels & (1u << i)) == 0) {
+            continue;
+        }
+
+        count++;
+
+        const bool ok = (passed & (1u << i)) != 0;
+        if (ok) {
+            LOG_INFO("verify %-16s av=%d  OK", i < 4 ? "cryptonight" : "cryptonight-lite", i % 4 + 1);
+        }
+        else {
+            LOG_ERR("verify %-16s av=%d  FAILED", i < 4 ? "cryptonight" : "cryptonight-lite", i % 4 + 1);
+            failed++;
+        }
+    }
+
+    if (failed) {
+        LOG_ERR("%d of %d kernels failed verification (%u ms)", failed, count, (unsigned) ms);
+    }
+    else {
+        LOG_NOTICE("all %d kernels verified (%u ms)", count, (unsigned) ms);
+    }
+
+    return failed == 0;
+}
+
+
+/**
+ * @brief Kernels which can be selected for algorithm at runtime, AES-NI kernels only if supported by CPU.
+ */
+uint32_t CryptoNight::candidates(int algo, bool doubleHash)
+{
+    const int soft = doubleHash ? Options::AV4_SOFT_AES_DOUBLE : Options::AV3_SOFT_AES;
+    const int aes  = doubleHash ? Options::AV2_AESNI_DOUBLE : Options::AV1_AESNI;
+
+    uint32_t mask = 1u << index(algo, soft);
+
+    if (Cpu::hasAES()) {
+        mask |= 1u << index(algo, aes);
+    }
 
-    return selfTest(algo);
+    return mask;
 }
 
 
@@ -139,24 +226,102 @@ void CryptoNight::hash(const uint8_t *input, size_t size, uint8_t *output, crypt
 }
 
 
-bool CryptoNight::selfTest(int algo) {
-    if (cryptonight_hash_ctx == nullptr) {
-        return false;
-    }
+bool CryptoNight::test(int index, bool full)
+{
+    const bool doubleHash = (index % 4) == 1 || (index % 4) == 3;
+    auto fn = cryptonight_variations[index];
 
-    char output[64];
+    uint8_t output[64];
+    uint8_t input[sizeof(test_input3) * 2];
 
     struct cryptonight_ctx *ctx = (struct cryptonight_ctx*) _mm_malloc(sizeof(struct cryptonight_ctx), 16);
     ctx->memory = (uint8_t *) _mm_malloc(MEMORY * 2, 16);
 
-    cryptonight_hash_ctx(test_input, 76, output, ctx);
+    memset(output, 0, sizeof(output));
+    fn(test_input, 76, output, ctx);
+
+#   ifndef XMRIG_NO_AEON
+    bool ok = memcmp(output, index >= 4 ? test_output1 : test_output0, doubleHash ? 64 : 32) == 0;
+#   else
+    bool ok = memcmp(output, test_output0, doubleHash ? 64 : 32) == 0;
+#   endif
+
+    // variable length inputs, double kernels hash two copies of the same input.
+    if (ok && full && index < 4) {
+        const char *inputs[]   = { test_input2, test_input3 };
+        const uint8_t *hashes[] = { test_output2, test_output3 };
+
+        for (size_t i = 0; i < 2 && ok; ++i) {
+            const size_t size = strlen(inputs[i]);
+            memcpy(input, inputs[i], size);
+            memcpy(input + size, inputs[i], size);
+
+            memset(output, 0, sizeof(output));
+            fn(input, size, output, ctx);
+
+            ok = memcmp(output, hashes[i], 32) == 0 && (!doubleHash || memcmp(output + 32, hashes[i], 32) == 0);
+        }
+    }
 
     _mm_free(ctx->memory);
     _mm_free(ctx);
 
+    return ok;
+}
+
+
+int CryptoNight::index(int algo, int variant)
+{
 #   ifndef XMRIG_NO_AEON
-    return memcmp(output, algo == Options::ALGO_CRYPTONIGHT_LITE ? test_output1 : test_output0, (Options::i()->doubleHash() ? 64 : 32)) == 0;
+    return algo == Options::ALGO_CRYPTONIGHT_LITE ? (variant + 3) : (variant - 1);
 #   else
-    return memcmp(output, test_output0, (Options::i()->doubleHash() ? 64 : 32)) == 0;
+    return variant - 1;
 #   endif
 }
+
+
+/**
+ * @brief Test kernels from mask in parallel, one thread per kernel, returns mask of passed kernels.
+ */
+uint32_t CryptoNight::selfTest(uint32_t kernels, bool full)
+{
+    SelfTestTask tasks[kKernels];
+    int count = 0;
+
+    for (int i = 0; i < kKernels; ++i) {
+        if ((kernels & (1u << i)) == 0) {
+            continue;
+        }
+
+        SelfTestTask &task = tasks[count++];
+        task.full   = full;
+        task.ok     = false;
+        task.index  = i;
+        task.thread = uv_thread_create(&task.id, CryptoNight::onTest, &task) == 0;
+
+        if (!task.thread) {
+            onTest(&task);
+        }
+    }
+
+    uint32_t passed = 0;
+    for (int i = 0; i < count; ++i) {
+        if (tasks[i].thread) {
+            uv_thread_join(&tasks[i].id);
+        }
+
+        if (tasks[i].ok) {
+            passed |= 1u << tasks[i].index;
+        }
+    }
+
+    return passed;
+}
+
+
+void CryptoNight::onTest(void *arg)
+{
+    auto task = static_cast<SelfTestTask*>(arg);
+
+    task->ok = test(task->index, task->full);
+}
@@ -47,15 +47,33 @@ class Job;
 class JobResult;
 
 
+/**
+ * Hash implementation selected at runtime.
+ *
+ * Kernels are checked against known answers before first use, all kernels that may be
+ * selected later (same single/double mode) are tested at once in parallel threads.
+ * Result can be restored by caller with setVerified() to skip tests on restart.
+ */
 class CryptoNight
 {
 public:
     static bool hash(const Job &job, JobResult &result, cryptonight_ctx *ctx);
     static bool init(int algo, int variant);
+    static bool verify();
+    static uint32_t candidates(int algo, bool doubleHash);
     static void hash(const uint8_t *input, size_t size, uint8_t *output, cryptonight_ctx *ctx);
 
+    static inline uint32_t verified()              { return m_verified; }
+    static inline void setVerified(uint32_t mask)  { m_verified |= mask; }
+
 private:
-    static bool selfTest(int algo);
+    static bool test(int index, bool full);
+    static int index(int algo, int variant);
+    static uint32_t selfTest(uint32_t kernels, bool full);
+
+    static void onTest(void *arg);
+
+    static uint32_t m_verified;
 };
 
 #endif /* __CRYPTONIGHT_H__ */
@@ -47,6 +47,23 @@ const static uint8_t test_output0[64] = {
 };
 
 
+// additional vectors for full verification, single hash only.
+const static char test_input2[] = "This is a test";
+const static char test_input3[] = "Lorem ipsum dolor sit amet, consectetur adipiscing elit. Vivamus pellentesque metus.";
+
+
+const static uint8_t test_output2[32] = {
+    0xA0, 0x84, 0xF0, 0x1D, 0x14, 0x37, 0xA0, 0x9C, 0x69, 0x85, 0x40, 0x1B, 0x60, 0xD4, 0x35, 0x54,
+    0xAE, 0x10, 0x58, 0x02, 0xC5, 0xF5, 0xD8, 0xA9, 0xB3, 0x25, 0x36, 0x49, 0xC0, 0xBE, 0x66, 0x05
+};
+
+
+const static uint8_t test_output3[32] = {
+    0x0B, 0xBE, 0x54, 0xBD, 0x26, 0xCA, 0xA9, 0x2A, 0x1D, 0x43, 0x6E, 0xEC, 0x71, 0xCB, 0xEF, 0x02,
+    0x56, 0x00, 0x62, 0xFA, 0x68, 0x9F, 0xE1, 0x4D, 0x7E, 0xFC, 0xF4, 0x25, 0x66, 0xB4, 0x11, 0xCF
+};
+
+
 #ifndef XMRIG_NO_AEON
 const static uint8_t test_output1[64] = {
     0x28, 0xA2, 0x2B, 0xAD, 0x3F, 0x93, 0xD1, 0x40, 0x8F, 0xCA, 0x47, 0x2E, 0xB5, 0xAD, 0x1C, 0xBE,
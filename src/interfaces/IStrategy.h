@@ -37,6 +37,7 @@ public:
     virtual ~IStrategy() {}
 
     virtual bool isActive() const                   = 0;
+    virtual bool setPool(int index)                 = 0;
     virtual int64_t submit(const JobResult &result) = 0;
     virtual void connect()                          = 0;
     virtual void resume()                           = 0;
@@ -26,6 +26,7 @@
 
 
 #include <stdint.h>
+#include <vector>
 
 
 class Client;
@@ -40,9 +41,11 @@ public:
     virtual ~IStrategyListener() {}
 
     virtual void onActive(Client *client)                                                        = 0;
+    virtual void onClose(Client *client, int failures)                                           = 0;
     virtual void onJob(Client *client, const Job &job)                                           = 0;
     virtual void onPause(IStrategy *strategy)                                                    = 0;
     virtual void onResultAccepted(Client *client, const SubmitResult &result, const char *error) = 0;
+    virtual void onWeights(const std::vector<int> &weights)                                      = 0;
 };
 
 
@@ -33,6 +33,7 @@ class IWorker
 public:
     virtual ~IWorker() {}
 
+    virtual bool isReady() const            = 0;
     virtual uint64_t hashCount() const      = 0;
     virtual uint64_t timestamp() const      = 0;
     virtual void start()                    = 0;
@@ -23,6 +23,7 @@
 
 #include <inttypes.h>
 #include <iterator>
+#include <stdarg.h>
 #include <stdio.h>
 #include <string.h>
 #include <utility>
@@ -31,6 +32,8 @@
 #include "interfaces/IClientListener.h"
 #include "log/Log.h"
 #include "net/Client.h"
+#include "net/DnsCache.h"
+#include "net/StratumParser.h"
 #include "net/Url.h"
 #include "rapidjson/document.h"
 #include "rapidjson/error/en.h"
@@ -55,31 +58,32 @@ int64_t Client::m_sequence = 1;
 
 Client::Client(int id, const char *agent, IClientListener *listener) :
     m_quiet(false),
+    m_connector(this),
     m_agent(agent),
     m_listener(listener),
     m_id(id),
     m_retryPause(5000),
     m_failures(0),
-    m_recvBufPos(0),
     m_state(UnconnectedState),
     m_lastNicehashCheck(0),
     m_lastNicehashActivity(0),
     m_expire(0),
+    m_latency(0),
+    m_loginTime(0),
     m_stream(nullptr),
-    m_socket(nullptr)
+    m_socket(nullptr),
+    m_writeQueue(this)
 {
+    memset(m_error, 0, sizeof(m_error));
     memset(m_ip, 0, sizeof(m_ip));
     memset(&m_hints, 0, sizeof(m_hints));
 
     m_resolver.data = this;
 
-    m_hints.ai_family   = PF_INET;
+    m_hints.ai_family   = AF_UNSPEC;
     m_hints.ai_socktype = SOCK_STREAM;
     m_hints.ai_protocol = IPPROTO_TCP;
 
-    m_recvBuf.base = m_buf;
-    m_recvBuf.len  = sizeof(m_buf);
-
 #   ifndef XMRIG_PROXY_PROJECT
     m_keepAliveTimer.data = this;
     uv_timer_init(uv_default_loop(), &m_keepAliveTimer);
@@ -155,6 +159,7 @@ void Client::tick(uint64_t now)
 
     if (m_state == ConnectedState) {
         LOG_DEBUG_ERR("[%s:%u] timeout", m_url.host(), m_url.port());
+        setError("timeout");
         close();
     }
 
@@ -166,24 +171,9 @@ void Client::tick(uint64_t now)
 
 int64_t Client::submit(const JobResult &result)
 {
-#   ifdef XMRIG_PROXY_PROJECT
-    const char *nonce = result.nonce;
-    const char *data  = result.result;
-#   else
-    char nonce[9];
-    char data[65];
-
-    Job::toHex(reinterpret_cast<const unsigned char*>(&result.nonce), 4, nonce);
-    nonce[8] = '\0';
-
-    Job::toHex(result.result, 32, data);
-    data[64] = '\0';
-#   endif
+    const size_t size = m_submit.write(m_sendBuf, m_sequence, m_rpcId, result.jobId, result.nonce, result.result);
 
-    const size_t size = snprintf(m_sendBuf, sizeof(m_sendBuf), "{\"id\":%" PRIu64 ",\"jsonrpc\":\"2.0\",\"method\":\"submit\",\"params\":{\"id\":\"%s\",\"job_id\":\"%s\",\"nonce\":\"%s\",\"result\":\"%s\"}}\n",
-                                 m_sequence, m_rpcId, result.jobId.data(), nonce, data);
-
-    m_results[m_sequence] = SubmitResult(m_sequence, result.diff, result.actualDiff());
+    m_results[m_sequence] = SubmitResult(m_sequence, result.diff, result.actualDiff(), result.jobId);
     int64_t sequence = send(size);
     if (sequence != -1) {
         if (m_url.isNicehash())
@@ -193,6 +183,55 @@ int64_t Client::submit(const JobResult &result)
 }
 
 
+void Client::onConnected(uv_tcp_t *socket, const sockaddr *addr)
+{
+    m_socket       = socket;
+    m_socket->data = this;
+
+    if (addr->sa_family == AF_INET6) {
+        uv_ip6_name(reinterpret_cast<const sockaddr_in6*>(addr), m_ip, sizeof(m_ip));
+    }
+    else {
+        uv_ip4_name(reinterpret_cast<const sockaddr_in*>(addr), m_ip, sizeof(m_ip));
+    }
+
+    m_stream = reinterpret_cast<uv_stream_t*>(m_socket);
+    setState(ConnectedState);
+
+    uv_read_start(m_stream, Client::onAllocBuffer, Client::onRead);
+
+    if (login()) {
+        if (m_url.isNicehash())
+            m_lastNicehashCheck = uv_now(uv_default_loop()) - kNicehashCheckOffset;
+    }
+}
+
+
+void Client::onWriteFailed(int status)
+{
+    if (!m_quiet) {
+        LOG_ERR("[%s:%u] write error: \"%s\"", m_url.host(), m_url.port(), uv_strerror(status));
+    }
+
+    setError("write error: \"%s\"", uv_strerror(status));
+    close();
+}
+
+
+void Client::onConnectFailed(int status)
+{
+    if (!m_quiet) {
+        LOG_ERR("[%s:%u] connect error: \"%s\"", m_url.host(), m_url.port(), uv_strerror(status));
+    }
+
+    setError("connect error: \"%s\"", uv_strerror(status));
+    DnsCache::remove(m_url.host());
+
+    setState(UnconnectedState);
+    reconnect();
+}
+
+
 bool Client::isCriticalError(const char *message)
 {
     if (!message) {
@@ -215,25 +254,25 @@ bool Client::isCriticalError(const char *message)
 }
 
 
-bool Client::parseJob(const rapidjson::Value &params, int *code)
+bool Client::parseJob(const StratumJob &params, int *code)
 {
-    if (!params.IsObject()) {
+    if (!params.valid) {
         *code = 2;
         return false;
     }
 
     Job job(m_id, m_url.isNicehash());
-    if (!job.setId(params["job_id"].GetString())) {
+    if (!params.id || !job.setId(params.id)) {
         *code = 3;
         return false;
     }
 
-    if (!job.setBlob(params["blob"].GetString())) {
+    if (!job.setBlob(params.blob)) {
         *code = 4;
         return false;
     }
 
-    if (!job.setTarget(params["target"].GetString())) {
+    if (!job.setTarget(params.target)) {
         *code = 5;
         return false;
     }
@@ -243,6 +282,7 @@ bool Client::parseJob(const rapidjson::Value &params, int *code)
             LOG_WARN("[%s:%u] duplicate job received, reconnect", m_url.host(), m_url.port());
         }
 
+        setError("duplicate job received");
         close();
         return false;
     }
@@ -252,9 +292,9 @@ bool Client::parseJob(const rapidjson::Value &params, int *code)
 }
 
 
-bool Client::parseLogin(const rapidjson::Value &result, int *code)
+bool Client::parseLogin(const StratumMessage &message, int *code)
 {
-    const char *id = result["id"].GetString();
+    const char *id = message.loginId;
     if (!id || strlen(id) >= sizeof(m_rpcId)) {
         *code = 1;
         return false;
@@ -263,7 +303,7 @@ bool Client::parseLogin(const rapidjson::Value &result, int *code)
     memset(m_rpcId, 0, sizeof(m_rpcId));
     memcpy(m_rpcId, id, strlen(id));
 
-    return parseJob(result["job"], code);
+    return parseJob(message.job, code);
 }
 
 
@@ -273,18 +313,26 @@ int Client::resolve(const char *host)
 
     m_lastNicehashCheck = 0;
     m_lastNicehashActivity = 0;
-    m_expire     = 0;
-    m_recvBufPos = 0;
+    m_expire = 0;
+    m_recvBuf.reset();
 
     if (m_failures == -1) {
         m_failures = 0;
     }
 
+    std::vector<sockaddr_storage> addrs;
+    if (DnsCache::get(host, uv_now(uv_default_loop()), addrs)) {
+        connect(addrs);
+        return 0;
+    }
+
     const int r = uv_getaddrinfo(uv_default_loop(), &m_resolver, Client::onResolved, host, NULL, &m_hints);
     if (r) {
         if (!m_quiet) {
             LOG_ERR("[%s:%u] getaddrinfo error: \"%s\"", host, m_url.port(), uv_strerror(r));
         }
+
+        setError("getaddrinfo error: \"%s\"", uv_strerror(r));
         return 1;
     }
 
@@ -300,9 +348,12 @@ int64_t Client::send(size_t size)
         return -1;
     }
 
-    uv_buf_t buf = uv_buf_init(m_sendBuf, (unsigned int) size);
+    if (!m_writeQueue.write(m_stream, m_sendBuf, size)) {
+        if (m_writeQueue.stats().bytes + size > WriteQueue::kMaxBytes) {
+            LOG_ERR("[%s:%u] send failed, %u bytes pending", m_url.host(), m_url.port(), (unsigned) m_writeQueue.stats().bytes);
+            setError("send failed, %u bytes pending", (unsigned) m_writeQueue.stats().bytes);
+        }
 
-    if (uv_try_write(m_stream, &buf, 1) < 0) {
         close();
         return -1;
     }
@@ -314,7 +365,16 @@ int64_t Client::send(size_t size)
 
 void Client::close()
 {
-    if (m_state == UnconnectedState || m_state == ClosingState || !m_socket) {
+    if (m_state == UnconnectedState || m_state == ClosingState) {
+        return;
+    }
+
+    if (!m_socket) {
+        if (m_connector.cancel()) {
+            setState(UnconnectedState);
+            reconnect();
+        }
+
         return;
     }
 
@@ -326,27 +386,14 @@ void Client::close()
 }
 
 
-void Client::connect(struct sockaddr *addr)
+void Client::connect(const std::vector<sockaddr_storage> &addrs)
 {
     setState(ConnectingState);
 
-    reinterpret_cast<struct sockaddr_in*>(addr)->sin_port = htons(m_url.port());
     delete m_socket;
+    m_socket = nullptr;
 
-    uv_connect_t *req = new uv_connect_t;
-    req->data = this;
-
-    m_socket = new uv_tcp_t;
-    m_socket->data = this;
-
-    uv_tcp_init(uv_default_loop(), m_socket);
-    uv_tcp_nodelay(m_socket, 1);
-
-#   ifndef WIN32
-    uv_tcp_keepalive(m_socket, 1, 60);
-#   endif
-
-    uv_tcp_connect(req, m_socket, reinterpret_cast<const sockaddr*>(addr), Client::onConnect);
+    m_connector.connect(addrs, m_url.port());
 }
 
 
@@ -375,7 +422,7 @@ bool Client::login()
     doc.Accept(writer);
 
     const size_t size = buffer.GetSize();
-    if (size > (sizeof(m_buf) - 2)) {
+    if (size > (sizeof(m_sendBuf) - 2)) {
         return false;
     }
 
@@ -383,6 +430,8 @@ bool Client::login()
     m_sendBuf[size]     = '\n';
     m_sendBuf[size + 1] = '\0';
 
+    m_loginTime = uv_now(uv_default_loop());
+
     return (send(size + 1) != -1);
 }
 
@@ -395,45 +444,51 @@ void Client::parse(char *line, size_t len)
 
     LOG_DEBUG("[%s:%u] received (%d bytes): \"%s\"", m_url.host(), m_url.port(), len, line);
 
-    rapidjson::Document doc;
-    if (doc.ParseInsitu(line).HasParseError()) {
-        if (!m_quiet) {
-            LOG_ERR("[%s:%u] JSON decode failed: \"%s\"", m_url.host(), m_url.port(), rapidjson::GetParseError_En(doc.GetParseError()));
+    StratumMessage message;
+    if (!StratumParser::parse(line, len - 1, message)) {
+        rapidjson::Document doc;
+        if (doc.ParseInsitu(line).HasParseError()) {
+            if (!m_quiet) {
+                LOG_ERR("[%s:%u] JSON decode failed: \"%s\"", m_url.host(), m_url.port(), rapidjson::GetParseError_En(doc.GetParseError()));
+            }
+
+            return;
         }
 
-        return;
-    }
+        if (!doc.IsObject()) {
+            return;
+        }
 
-    if (!doc.IsObject()) {
-        return;
+        // in situ parsing, strings stay in line buffer after document destroyed.
+        StratumParser::parse(doc, message);
     }
 
-    const rapidjson::Value &id = doc["id"];
-    if (id.IsInt64()) {
-        parseResponse(id.GetInt64(), doc["result"], doc["error"]);
+    if (message.hasId) {
+        parseResponse(message);
     }
     else {
-        parseNotification(doc["method"].GetString(), doc["params"], doc["error"]);
+        parseNotification(message);
     }
 }
 
 
-void Client::parseNotification(const char *method, const rapidjson::Value &params, const rapidjson::Value &error)
+void Client::parseNotification(const StratumMessage &message)
 {
-    if (error.IsObject()) {
+    if (message.hasError) {
         if (!m_quiet) {
-            LOG_ERR("[%s:%u] error: \"%s\", code: %d", m_url.host(), m_url.port(), error["message"].GetString(), error["code"].GetInt());
+            LOG_ERR("[%s:%u] error: \"%s\", code: %d", m_url.host(), m_url.port(), message.errorMessage, message.errorCode);
         }
         return;
     }
 
+    const char *method = message.method;
     if (!method) {
         return;
     }
 
     if (strcmp(method, "job") == 0) {
         int code = -1;
-        if (parseJob(params, &code)) {
+        if (parseJob(message.job, &code)) {
             m_listener->onJobReceived(this, m_job);
         }
 
@@ -444,10 +499,12 @@ void Client::parseNotification(const char *method, const rapidjson::Value &param
 }
 
 
-void Client::parseResponse(int64_t id, const rapidjson::Value &result, const rapidjson::Value &error)
+void Client::parseResponse(const StratumMessage &response)
 {
-    if (error.IsObject()) {
-        const char *message = error["message"].GetString();
+    const int64_t id = response.id;
+
+    if (response.hasError) {
+        const char *message = response.errorMessage;
 
         auto it = m_results.find(id);
         if (it != m_results.end()) {
@@ -456,31 +513,35 @@ void Client::parseResponse(int64_t id, const rapidjson::Value &result, const rap
             m_results.erase(it);
         }
         else if (!m_quiet) {
-            LOG_ERR("[%s:%u] error: \"%s\", code: %d", m_url.host(), m_url.port(), message, error["code"].GetInt());
+            LOG_ERR("[%s:%u] error: \"%s\", code: %d", m_url.host(), m_url.port(), message, response.errorCode);
         }
 
         if (id == 1 || isCriticalError(message)) {
+            setError("%s", message);
             close();
         }
 
         return;
     }
 
-    if (!result.IsObject()) {
+    if (!response.hasResult) {
         return;
     }
 
     if (id == 1) {
         int code = -1;
-        if (!parseLogin(result, &code)) {
+        if (!parseLogin(response, &code)) {
             if (!m_quiet) {
                 LOG_ERR("[%s:%u] login error code: %d", m_url.host(), m_url.port(), code);
             }
 
+            setError("login error code: %d", code);
             return close();
         }
 
         m_failures = 0;
+        m_error[0] = '\0';
+        m_latency  = uv_now(uv_default_loop()) - m_loginTime;
         m_listener->onLoginSuccess(this);
         m_listener->onJobReceived(this, m_job);
         return;
@@ -518,11 +579,21 @@ void Client::reconnect(int retryPause, bool failure)
     if (failure)
         m_failures++;
     m_listener->onClose(this, (int) m_failures);
+    m_error[0] = '\0';
 
     m_expire = uv_now(uv_default_loop()) + (retryPause > 0 ? retryPause : m_retryPause);
 }
 
 
+void Client::setError(const char *fmt, ...)
+{
+    va_list args;
+    va_start(args, fmt);
+    vsnprintf(m_error, sizeof(m_error), fmt, args);
+    va_end(args);
+}
+
+
 void Client::setState(SocketState state)
 {
     LOG_DEBUG("[%s:%u] state: %d", m_url.host(), m_url.port(), state);
@@ -553,8 +624,9 @@ void Client::onAllocBuffer(uv_handle_t *handle, size_t suggested_size, uv_buf_t
 {
     auto client = getClient(handle->data);
 
-    buf->base = &client->m_recvBuf.base[client->m_recvBufPos];
-    buf->len  = client->m_recvBuf.len - (unsigned long)client->m_recvBufPos;
+    size_t size = 0;
+    buf->base = client->m_recvBuf.reserve(size);
+    buf->len  = size;
 }
 
 
@@ -564,6 +636,7 @@ void Client::onClose(uv_handle_t *handle)
 
     delete client->m_socket;
 
+    client->m_writeQueue.reset();
     client->m_stream = nullptr;
     client->m_socket = nullptr;
     client->setState(UnconnectedState);
@@ -572,36 +645,15 @@ void Client::onClose(uv_handle_t *handle)
 }
 
 
-void Client::onConnect(uv_connect_t *req, int status)
-{
-    auto client = getClient(req->data);
-    if (status < 0) {
-        if (!client->m_quiet) {
-            LOG_ERR("[%s:%u] connect error: \"%s\"", client->m_url.host(), client->m_url.port(), uv_strerror(status));
-        }
-
-        delete req;
-        client->close();
-        return;
-    }
-
-    client->m_stream = static_cast<uv_stream_t*>(req->handle);
-    client->m_stream->data = req->data;
-    client->setState(ConnectedState);
-
-    uv_read_start(client->m_stream, Client::onAllocBuffer, Client::onRead);
-    delete req;
-
-    if (client->login()) {
-        if (client->m_url.isNicehash())
-            client->m_lastNicehashCheck = uv_now(uv_default_loop()) - kNicehashCheckOffset;
-    }
-}
-
-
 void Client::onRead(uv_stream_t *stream, ssize_t nread, const uv_buf_t *buf)
 {
     auto client = getClient(stream->data);
+    if (nread == UV_ENOBUFS) {
+        LOG_ERR("[%s:%u] receive buffer overflow, message exceeds %u bytes", client->m_url.host(), client->m_url.port(), (unsigned) client->m_recvBuf.maxSize());
+        client->setError("receive buffer overflow");
+        return client->close();
+    }
+
     if (nread < 0) {
         if (!client->m_quiet) {
             if (nread != UV_EOF)
@@ -610,39 +662,24 @@ void Client::onRead(uv_stream_t *stream, ssize_t nread, const uv_buf_t *buf)
                 LOG_ERR("[%s:%u] connection closed", client->m_url.host(), client->m_url.port());
         }
 
-        return client->close();
-    }
+        if (nread != UV_EOF) {
+            client->setError("read error: \"%s\"", uv_strerror((int) nread));
+        }
+        else {
+            client->setError("connection closed");
+        }
 
-    if ((size_t) nread > (sizeof(m_buf) - 8 - client->m_recvBufPos)) {
         return client->close();
     }
 
-    client->m_recvBufPos += nread;
-
-    char* end;
-    char* start = buf->base;
-    size_t remaining = client->m_recvBufPos;
+    client->m_recvBuf.commit((size_t) nread);
 
-    while ((end = static_cast<char*>(memchr(start, '\n', remaining))) != nullptr) {
-        end++;
-        size_t len = end - start;
-        client->parse(start, len);
+    char *line;
+    size_t len;
 
-        remaining -= len;
-        start = end;
-    }
-
-    if (remaining == 0) {
-        client->m_recvBufPos = 0;
-        return;
+    while ((line = client->m_recvBuf.next(len)) != nullptr) {
+        client->parse(line, len);
     }
-
-    if (start == buf->base) {
-        return;
-    }
-
-    memcpy(buf->base, start, remaining);
-    client->m_recvBufPos = remaining;
 }
 
 
@@ -651,29 +688,19 @@ void Client::onResolved(uv_getaddrinfo_t *req, int status, struct addrinfo *res)
     auto client = getClient(req->data);
     if (status < 0) {
         LOG_ERR("[%s:%u] DNS error: \"%s\"", client->m_url.host(), client->m_url.port(), uv_strerror(status));
+        client->setError("DNS error: \"%s\"", uv_strerror(status));
         return client->reconnect();
     }
 
-    addrinfo *ptr = res;
-    std::vector<addrinfo*> ipv4;
-
-    while (ptr != nullptr) {
-        if (ptr->ai_family == AF_INET) {
-            ipv4.push_back(ptr);
-        }
-
-        ptr = ptr->ai_next;
-    }
+    std::vector<sockaddr_storage> addrs;
+    const size_t count = DnsCache::set(client->m_url.host(), uv_now(uv_default_loop()), res, addrs);
+    uv_freeaddrinfo(res);
 
-    if (ipv4.empty()) {
-        LOG_ERR("[%s:%u] DNS error: \"No IPv4 records found\"", client->m_url.host(), client->m_url.port());
+    if (count == 0) {
+        LOG_ERR("[%s:%u] DNS error: \"No IPv4 or IPv6 records found\"", client->m_url.host(), client->m_url.port());
+        client->setError("DNS error: \"No IPv4 or IPv6 records found\"");
         return client->reconnect();
     }
 
-    ptr = ipv4[rand() % ipv4.size()];
-
-    uv_ip4_name(reinterpret_cast<sockaddr_in*>(ptr->ai_addr), client->m_ip, 16);
-
-    client->connect(ptr->ai_addr);
-    uv_freeaddrinfo(res);
+    client->connect(addrs);
 }
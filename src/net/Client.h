@@ -27,19 +27,27 @@
 
 #include <map>
 #include <uv.h>
+#include <vector>
 
 
+#include "interfaces/IConnectorListener.h"
+#include "interfaces/IWriteQueueListener.h"
+#include "net/Connector.h"
 #include "net/Job.h"
+#include "net/RecvBuffer.h"
 #include "net/SubmitResult.h"
+#include "net/SubmitTemplate.h"
 #include "net/Url.h"
-#include "rapidjson/fwd.h"
+#include "net/WriteQueue.h"
 
 
 class IClientListener;
 class JobResult;
+struct StratumJob;
+struct StratumMessage;
 
 
-class Client
+class Client : public IConnectorListener, public IWriteQueueListener
 {
 public:
     enum SocketState {
@@ -67,35 +75,44 @@ public:
     void tick(uint64_t now);
 
     inline bool isReady() const              { return m_state == ConnectedState && m_failures == 0; }
+    inline const char *error() const         { return m_error; }
     inline const char *host() const          { return m_url.host(); }
     inline const char *ip() const            { return m_ip; }
     inline const Job &job() const            { return m_job; }
+    inline const WriteQueue &writeQueue() const { return m_writeQueue; }
     inline int id() const                    { return m_id; }
     inline SocketState state() const         { return m_state; }
     inline uint16_t port() const             { return m_url.port(); }
+    inline uint64_t latency() const          { return m_latency; }
+    inline void setMaxRecvSize(size_t size)  { m_recvBuf.setMaxSize(size); }
     inline void setQuiet(bool quiet)         { m_quiet = quiet; }
     inline void setRetryPause(int ms)        { m_retryPause = ms; }
 
+protected:
+    void onConnected(uv_tcp_t *socket, const sockaddr *addr) override;
+    void onConnectFailed(int status) override;
+    void onWriteFailed(int status) override;
+
 private:
     bool isCriticalError(const char *message);
-    bool parseJob(const rapidjson::Value &params, int *code);
-    bool parseLogin(const rapidjson::Value &result, int *code);
+    bool parseJob(const StratumJob &params, int *code);
+    bool parseLogin(const StratumMessage &message, int *code);
     int resolve(const char *host);
     int64_t send(size_t size);
     void close();
-    void connect(struct sockaddr *addr);
+    void connect(const std::vector<sockaddr_storage> &addrs);
     bool login();
     void parse(char *line, size_t len);
-    void parseNotification(const char *method, const rapidjson::Value &params, const rapidjson::Value &error);
-    void parseResponse(int64_t id, const rapidjson::Value &result, const rapidjson::Value &error);
+    void parseNotification(const StratumMessage &message);
+    void parseResponse(const StratumMessage &response);
     void ping();
     void reconnect(int retryPause = 0, bool failure = true);
+    void setError(const char *fmt, ...);
     void setState(SocketState state);
     void startTimeout();
 
     static void onAllocBuffer(uv_handle_t *handle, size_t suggested_size, uv_buf_t *buf);
     static void onClose(uv_handle_t *handle);
-    static void onConnect(uv_connect_t *req, int status);
     static void onRead(uv_stream_t *stream, ssize_t nread, const uv_buf_t *buf);
     static void onResolved(uv_getaddrinfo_t *req, int status, struct addrinfo *res);
 
@@ -103,8 +120,9 @@ private:
 
     addrinfo m_hints;
     bool m_quiet;
-    char m_buf[2048];
-    char m_ip[17];
+    char m_error[128];
+    char m_ip[46];
+    Connector m_connector;
     char m_rpcId[64];
     char m_sendBuf[768];
     const char *m_agent;
@@ -113,18 +131,21 @@ private:
     int m_retryPause;
     int64_t m_failures;
     Job m_job;
-    size_t m_recvBufPos;
+    RecvBuffer m_recvBuf;
     SocketState m_state;
     static int64_t m_sequence;
     std::map<int64_t, SubmitResult> m_results;
+    SubmitTemplate m_submit;
     uint64_t m_lastNicehashCheck;
     uint64_t m_lastNicehashActivity;
     uint64_t m_expire;
+    uint64_t m_latency;
+    uint64_t m_loginTime;
     Url m_url;
-    uv_buf_t m_recvBuf;
     uv_getaddrinfo_t m_resolver;
     uv_stream_t *m_stream;
     uv_tcp_t *m_socket;
+    WriteQueue m_writeQueue;
 
 #   ifndef XMRIG_PROXY_PROJECT
     uv_timer_t m_keepAliveTimer;
@@ -0,0 +1,178 @@
+/* XMRig
+ * Copyright 2010      Jeff Garzik <jgarzik@pobox.com>
+ * Copyright 2012-2014 pooler      <pooler@litecoinpool.org>
+ * Copyright 2014      Lucas Jones <https://github.com/lucasjones>
+ * Copyright 2014-2016 Wolf9466    <https://github.com/OhGodAPet>
+ * Copyright 2016      Jay D Dee   <jayddee246@gmail.com>
+ * Copyright 2016-2017 XMRig       <support@xmrig.com>
+ *
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include <algorithm>
+#include <string.h>
+
+
+#include "interfaces/IConnectorListener.h"
+#include "net/Connector.h"
+
+
+Connector::Connector(IConnectorListener *listener) :
+    m_listener(listener),
+    m_error(0),
+    m_next(0),
+    m_port(0)
+{
+    m_timer.data = this;
+    uv_timer_init(uv_default_loop(), &m_timer);
+}
+
+
+Connector::~Connector()
+{
+    cancel();
+}
+
+
+/**
+ * @brief Abort all attempts in flight, returns true if there was any.
+ */
+bool Connector::cancel()
+{
+    uv_timer_stop(&m_timer);
+
+    m_addrs.clear();
+    m_next = 0;
+
+    if (m_attempts.empty()) {
+        return false;
+    }
+
+    for (Attempt *attempt : m_attempts) {
+        attempt->owner = nullptr;
+        uv_close(reinterpret_cast<uv_handle_t*>(attempt->socket), Connector::onClose);
+    }
+
+    m_attempts.clear();
+    return true;
+}
+
+
+void Connector::connect(const std::vector<sockaddr_storage> &addrs, uint16_t port)
+{
+    cancel();
+
+    m_addrs = addrs;
+    m_error = UV_EADDRNOTAVAIL;
+    m_port  = port;
+
+    next();
+}
+
+
+void Connector::next()
+{
+    while (m_next < m_addrs.size()) {
+        Attempt *attempt = new Attempt();
+        attempt->owner    = this;
+        attempt->addr     = m_addrs[m_next++];
+        attempt->req.data = attempt;
+        attempt->socket   = new uv_tcp_t;
+
+        if (attempt->addr.ss_family == AF_INET6) {
+            reinterpret_cast<sockaddr_in6*>(&attempt->addr)->sin6_port = htons(m_port);
+        }
+        else {
+            reinterpret_cast<sockaddr_in*>(&attempt->addr)->sin_port = htons(m_port);
+        }
+
+        uv_tcp_init(uv_default_loop(), attempt->socket);
+        uv_tcp_nodelay(attempt->socket, 1);
+
+#       ifndef WIN32
+        uv_tcp_keepalive(attempt->socket, 1, 60);
+#       endif
+
+        const int rc = uv_tcp_connect(&attempt->req, attempt->socket, reinterpret_cast<const sockaddr*>(&attempt->addr), Connector::onConnect);
+        if (rc < 0) {
+            m_error = rc;
+            uv_close(reinterpret_cast<uv_handle_t*>(attempt->socket), Connector::onClose);
+            delete attempt;
+            continue;
+        }
+
+        m_attempts.push_back(attempt);
+
+        if (m_next < m_addrs.size()) {
+            uv_timer_start(&m_timer, Connector::onTimer, kAttemptDelay, 0);
+        }
+
+        return;
+    }
+
+    if (m_attempts.empty()) {
+        m_listener->onConnectFailed(m_error);
+    }
+}
+
+
+void Connector::remove(Attempt *attempt)
+{
+    m_attempts.erase(std::remove(m_attempts.begin(), m_attempts.end(), attempt), m_attempts.end());
+}
+
+
+void Connector::onClose(uv_handle_t *handle)
+{
+    delete reinterpret_cast<uv_tcp_t*>(handle);
+}
+
+
+void Connector::onConnect(uv_connect_t *req, int status)
+{
+    Attempt *attempt     = static_cast<Attempt*>(req->data);
+    Connector *connector = attempt->owner;
+
+    if (!connector) {
+        delete attempt;
+        return;
+    }
+
+    connector->remove(attempt);
+
+    if (status == 0) {
+        uv_tcp_t *socket = attempt->socket;
+        sockaddr_storage addr = attempt->addr;
+        delete attempt;
+
+        connector->cancel();
+        connector->m_listener->onConnected(socket, reinterpret_cast<const sockaddr*>(&addr));
+        return;
+    }
+
+    connector->m_error = status;
+    uv_close(reinterpret_cast<uv_handle_t*>(attempt->socket), Connector::onClose);
+    delete attempt;
+
+    uv_timer_stop(&connector->m_timer);
+    connector->next();
+}
+
+
+void Connector::onTimer(uv_timer_t *handle)
+{
+    static_cast<Connector*>(handle->data)->next();
+}
@@ -0,0 +1,81 @@
+/* XMRig
+ * Copyright 2010      Jeff Garzik <jgarzik@pobox.com>
+ * Copyright 2012-2014 pooler      <pooler@litecoinpool.org>
+ * Copyright 2014      Lucas Jones <https://github.com/lucasjones>
+ * Copyright 2014-2016 Wolf9466    <https://github.com/OhGodAPet>
+ * Copyright 2016      Jay D Dee   <jayddee246@gmail.com>
+ * Copyright 2016-2017 XMRig       <support@xmrig.com>
+ *
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef __CONNECTOR_H__
+#define __CONNECTOR_H__
+
+
+#include <stdint.h>
+#include <uv.h>
+#include <vector>
+
+
+class IConnectorListener;
+
+
+/**
+ * Races TCP connects to resolved addresses (RFC 8305).
+ *
+ * Next address is tried after kAttemptDelay or as soon as the previous attempt fails,
+ * first established connection wins and all other attempts are closed.
+ */
+class Connector
+{
+public:
+    constexpr static int kAttemptDelay = 250;
+
+    Connector(IConnectorListener *listener);
+    ~Connector();
+
+    bool cancel();
+    void connect(const std::vector<sockaddr_storage> &addrs, uint16_t port);
+
+    inline bool isPending() const { return !m_attempts.empty(); }
+
+private:
+    struct Attempt
+    {
+        Connector *owner;
+        sockaddr_storage addr;
+        uv_connect_t req;
+        uv_tcp_t *socket;
+    };
+
+    void next();
+    void remove(Attempt *attempt);
+
+    static void onClose(uv_handle_t *handle);
+    static void onConnect(uv_connect_t *req, int status);
+    static void onTimer(uv_timer_t *handle);
+
+    IConnectorListener *m_listener;
+    int m_error;
+    size_t m_next;
+    std::vector<Attempt*> m_attempts;
+    std::vector<sockaddr_storage> m_addrs;
+    uint16_t m_port;
+    uv_timer_t m_timer;
+};
+
+
+#endif /* __CONNECTOR_H__ */
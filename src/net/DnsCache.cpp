@@ -0,0 +1,139 @@
+/* XMRig
+ * Copyright 2010      Jeff Garzik <jgarzik@pobox.com>
+ * Copyright 2012-2014 pooler      <pooler@litecoinpool.org>
+ * Copyright 2014      Lucas Jones <https://github.com/lucasjones>
+ * Copyright 2014-2016 Wolf9466    <https://github.com/OhGodAPet>
+ * Copyright 2016      Jay D Dee   <jayddee246@gmail.com>
+ * Copyright 2016-2017 XMRig       <support@xmrig.com>
+ *
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include <algorithm>
+#include <stdlib.h>
+#include <string.h>
+
+
+#include "net/DnsCache.h"
+
+
+std::vector<DnsCache::Entry> DnsCache::m_entries;
+
+
+static void shuffle(std::vector<sockaddr_storage> &addrs)
+{
+    for (size_t i = addrs.size(); i > 1; --i) {
+        std::swap(addrs[i - 1], addrs[rand() % i]);
+    }
+}
+
+
+bool DnsCache::get(const char *host, uint64_t now, std::vector<sockaddr_storage> &addrs)
+{
+    const Entry *entry = find(host);
+    if (!entry || entry->expire <= now) {
+        return false;
+    }
+
+    order(*entry, addrs);
+    return true;
+}
+
+
+/**
+ * @brief Store resolved addresses and return them in connection order, IPv6 first and families interleaved.
+ */
+size_t DnsCache::set(const char *host, uint64_t now, const addrinfo *res, std::vector<sockaddr_storage> &addrs)
+{
+    Entry *entry = find(host);
+    if (!entry) {
+        m_entries.push_back(Entry());
+        entry = &m_entries.back();
+
+        strncpy(entry->host, host, sizeof(entry->host) - 1);
+        entry->host[sizeof(entry->host) - 1] = '\0';
+    }
+
+    entry->ipv4.clear();
+    entry->ipv6.clear();
+    entry->expire = now + kTtl;
+
+    for (const addrinfo *ptr = res; ptr != nullptr; ptr = ptr->ai_next) {
+        if (ptr->ai_family != AF_INET && ptr->ai_family != AF_INET6) {
+            continue;
+        }
+
+        sockaddr_storage addr;
+        memset(&addr, 0, sizeof(addr));
+        memcpy(&addr, ptr->ai_addr, ptr->ai_addrlen);
+
+        std::vector<sockaddr_storage> &list = ptr->ai_family == AF_INET ? entry->ipv4 : entry->ipv6;
+        const bool duplicate = std::any_of(list.begin(), list.end(), [&addr, ptr](const sockaddr_storage &other) {
+            return memcmp(&other, &addr, ptr->ai_addrlen) == 0;
+        });
+
+        if (!duplicate) {
+            list.push_back(addr);
+        }
+    }
+
+    order(*entry, addrs);
+    return addrs.size();
+}
+
+
+void DnsCache::remove(const char *host)
+{
+    Entry *entry = find(host);
+    if (entry) {
+        entry->expire = 0;
+    }
+}
+
+
+DnsCache::Entry *DnsCache::find(const char *host)
+{
+    for (Entry &entry : m_entries) {
+        if (strncmp(entry.host, host, sizeof(entry.host) - 1) == 0) {
+            return &entry;
+        }
+    }
+
+    return nullptr;
+}
+
+
+void DnsCache::order(const Entry &entry, std::vector<sockaddr_storage> &addrs)
+{
+    std::vector<sockaddr_storage> ipv4 = entry.ipv4;
+    std::vector<sockaddr_storage> ipv6 = entry.ipv6;
+
+    shuffle(ipv4);
+    shuffle(ipv6);
+
+    addrs.clear();
+    addrs.reserve(ipv4.size() + ipv6.size());
+
+    for (size_t i = 0; i < std::max(ipv4.size(), ipv6.size()); ++i) {
+        if (i < ipv6.size()) {
+            addrs.push_back(ipv6[i]);
+        }
+
+        if (i < ipv4.size()) {
+            addrs.push_back(ipv4[i]);
+        }
+    }
+}
@@ -0,0 +1,64 @@
+/* XMRig
+ * Copyright 2010      Jeff Garzik <jgarzik@pobox.com>
+ * Copyright 2012-2014 pooler      <pooler@litecoinpool.org>
+ * Copyright 2014      Lucas Jones <https://github.com/lucasjones>
+ * Copyright 2014-2016 Wolf9466    <https://github.com/OhGodAPet>
+ * Copyright 2016      Jay D Dee   <jayddee246@gmail.com>
+ * Copyright 2016-2017 XMRig       <support@xmrig.com>
+ *
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef __DNSCACHE_H__
+#define __DNSCACHE_H__
+
+
+#include <stdint.h>
+#include <uv.h>
+#include <vector>
+
+
+/**
+ * Resolved pool addresses, so reconnect after a pool drop skips the getaddrinfo round trip.
+ *
+ * getaddrinfo does not report record TTL, entries live for fixed kTtl and are
+ * removed earlier if no address accepted a connection.
+ */
+class DnsCache
+{
+public:
+    constexpr static uint64_t kTtl = 5 * 60 * 1000;
+
+    static bool get(const char *host, uint64_t now, std::vector<sockaddr_storage> &addrs);
+    static size_t set(const char *host, uint64_t now, const addrinfo *res, std::vector<sockaddr_storage> &addrs);
+    static void remove(const char *host);
+
+private:
+    struct Entry
+    {
+        char host[256];
+        std::vector<sockaddr_storage> ipv4;
+        std::vector<sockaddr_storage> ipv6;
+        uint64_t expire;
+    };
+
+    static Entry *find(const char *host);
+    static void order(const Entry &entry, std::vector<sockaddr_storage> &addrs);
+
+    static std::vector<Entry> m_entries;
+};
+
+
+#endif /* __DNSCACHE_H__ */
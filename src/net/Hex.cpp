@@ -0,0 +1,142 @@
+/* XMRig
+ * Copyright 2010      Jeff Garzik <jgarzik@pobox.com>
+ * Copyright 2012-2014 pooler      <pooler@litecoinpool.org>
+ * Copyright 2014      Lucas Jones <https://github.com/lucasjones>
+ * Copyright 2014-2016 Wolf9466    <https://github.com/OhGodAPet>
+ * Copyright 2016      Jay D Dee   <jayddee246@gmail.com>
+ * Copyright 2016-2017 XMRig       <support@xmrig.com>
+ *
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#   define XMRIG_HEX_SSE2
+#   include <emmintrin.h>
+#endif
+
+
+#include "net/Hex.h"
+
+
+static const char kDigits[] = "0123456789abcdef";
+
+
+/**
+ * @brief Value of hex digit or -1, compiles to conditional moves.
+ */
+static inline int nibble(uint8_t c)
+{
+    const unsigned digit = (unsigned) c - '0';
+    const unsigned alpha = (unsigned) (c | 0x20) - 'a';
+
+    return digit <= 9 ? (int) digit : (alpha <= 5 ? (int) alpha + 10 : -1);
+}
+
+
+#ifdef XMRIG_HEX_SSE2
+static inline __m128i toAscii(__m128i nibbles)
+{
+    const __m128i letters = _mm_and_si128(_mm_cmpgt_epi8(nibbles, _mm_set1_epi8(9)), _mm_set1_epi8('a' - '0' - 10));
+
+    return _mm_add_epi8(_mm_add_epi8(nibbles, _mm_set1_epi8('0')), letters);
+}
+
+
+/**
+ * @brief Convert 16 characters to nibbles, invalid lanes are accumulated in invalid mask.
+ */
+static inline __m128i toNibbles(__m128i chars, __m128i &invalid)
+{
+    const __m128i digit   = _mm_sub_epi8(chars, _mm_set1_epi8('0'));
+    const __m128i alpha   = _mm_sub_epi8(_mm_or_si128(chars, _mm_set1_epi8(0x20)), _mm_set1_epi8('a'));
+    const __m128i isDigit = _mm_cmpeq_epi8(_mm_max_epu8(digit, _mm_set1_epi8(9)), _mm_set1_epi8(9));
+    const __m128i isAlpha = _mm_cmpeq_epi8(_mm_max_epu8(alpha, _mm_set1_epi8(5)), _mm_set1_epi8(5));
+
+    invalid = _mm_or_si128(invalid, _mm_andnot_si128(_mm_or_si128(isDigit, isAlpha), _mm_set1_epi8(-1)));
+
+    return _mm_or_si128(_mm_and_si128(isDigit, digit), _mm_and_si128(isAlpha, _mm_add_epi8(alpha, _mm_set1_epi8(10))));
+}
+
+
+/**
+ * @brief Join pairs of nibbles in 16 bit lanes, first character is high nibble.
+ */
+static inline __m128i toBytes(__m128i nibbles)
+{
+    return _mm_or_si128(_mm_slli_epi16(_mm_and_si128(nibbles, _mm_set1_epi16(0x00FF)), 4), _mm_srli_epi16(nibbles, 8));
+}
+#endif
+
+
+bool Hex::decode(const char *in, size_t len, uint8_t *out)
+{
+    if (len % 2 != 0) {
+        return false;
+    }
+
+    size_t i = 0;
+
+#   ifdef XMRIG_HEX_SSE2
+    __m128i invalid = _mm_setzero_si128();
+
+    for (; i + 32 <= len; i += 32) {
+        const __m128i a = toNibbles(_mm_loadu_si128(reinterpret_cast<const __m128i *>(in + i)), invalid);
+        const __m128i b = toNibbles(_mm_loadu_si128(reinterpret_cast<const __m128i *>(in + i + 16)), invalid);
+
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(out + i / 2), _mm_packus_epi16(toBytes(a), toBytes(b)));
+    }
+
+    if (_mm_movemask_epi8(invalid)) {
+        return false;
+    }
+#   endif
+
+    int error = 0;
+
+    for (; i < len; i += 2) {
+        const int hi = nibble((uint8_t) in[i]);
+        const int lo = nibble((uint8_t) in[i + 1]);
+
+        error |= hi | lo;
+        out[i / 2] = (uint8_t) (((hi & 0x0F) << 4) | (lo & 0x0F));
+    }
+
+    return error >= 0;
+}
+
+
+void Hex::encode(const uint8_t *in, size_t len, char *out)
+{
+    size_t i = 0;
+
+#   ifdef XMRIG_HEX_SSE2
+    const __m128i mask = _mm_set1_epi8(0x0F);
+
+    for (; i + 16 <= len; i += 16) {
+        const __m128i bytes = _mm_loadu_si128(reinterpret_cast<const __m128i *>(in + i));
+        const __m128i hi    = toAscii(_mm_and_si128(_mm_srli_epi16(bytes, 4), mask));
+        const __m128i lo    = toAscii(_mm_and_si128(bytes, mask));
+
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(out + i * 2),      _mm_unpacklo_epi8(hi, lo));
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(out + i * 2 + 16), _mm_unpackhi_epi8(hi, lo));
+    }
+#   endif
+
+    for (; i < len; ++i) {
+        out[i * 2]     = kDigits[in[i] >> 4];
+        out[i * 2 + 1] = kDigits[in[i] & 0x0F];
+    }
+}
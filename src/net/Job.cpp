@@ -25,36 +25,10 @@
 #include <string.h>
 
 
+#include "net/Hex.h"
 #include "net/Job.h"
 
 
-static inline unsigned char hf_hex2bin(char c, bool &err)
-{
-    if (c >= '0' && c <= '9') {
-        return c - '0';
-    }
-    else if (c >= 'a' && c <= 'f') {
-        return c - 'a' + 0xA;
-    }
-    else if (c >= 'A' && c <= 'F') {
-        return c - 'A' + 0xA;
-    }
-
-    err = true;
-    return 0;
-}
-
-
-static inline char hf_bin2hex(unsigned char c)
-{
-    if (c <= 0x9) {
-        return '0' + c;
-    }
-
-    return 'a' - 0xA + c;
-}
-
-
 Job::Job(int poolId, bool nicehash) :
     m_nicehash(nicehash),
     m_poolId(poolId),
@@ -148,24 +122,13 @@ bool Job::setTarget(const char *target)
 
 bool Job::fromHex(const char* in, unsigned int len, unsigned char* out)
 {
-    bool error = false;
-    for (unsigned int i = 0; i < len; i += 2) {
-        out[i / 2] = (hf_hex2bin(in[i], error) << 4) | hf_hex2bin(in[i + 1], error);
-
-        if (error) {
-            return false;
-        }
-    }
-    return true;
+    return Hex::decode(in, len, out);
 }
 
 
 void Job::toHex(const unsigned char* in, unsigned int len, char* out)
 {
-    for (unsigned int i = 0; i < len; i++) {
-        out[i * 2] = hf_bin2hex((in[i] & 0xF0) >> 4);
-        out[i * 2 + 1] = hf_bin2hex(in[i] & 0x0F);
-    }
+    Hex::encode(in, len, out);
 }
 
 
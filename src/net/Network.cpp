@@ -34,19 +34,25 @@
 #include "log/Log.h"
 #include "net/Client.h"
 #include "net/Network.h"
+#include "net/proxy/Proxy.h"
+#include "net/strategies/AdaptiveStrategy.h"
 #include "net/strategies/DonateStrategy.h"
 #include "net/strategies/FailoverStrategy.h"
 #include "net/strategies/SinglePoolStrategy.h"
+#include "net/strategies/SplitStrategy.h"
 #include "net/SubmitResult.h"
 #include "net/Url.h"
 #include "Options.h"
 #include "Platform.h"
+#include "Startup.h"
 #include "workers/Workers.h"
 
 
 Network::Network(const Options *options) :
+    m_client(nullptr),
     m_options(options),
-    m_donate(nullptr)
+    m_donate(nullptr),
+    m_proxy(nullptr)
 {
     srand(time(0) ^ (uintptr_t) this);
 
@@ -54,7 +60,13 @@ Network::Network(const Options *options) :
 
     const std::vector<Url*> &pools = options->pools();
 
-    if (pools.size() > 1) {
+    if (pools.size() > 1 && options->poolStrategy() == Options::POOL_ADAPTIVE) {
+        m_strategy = new AdaptiveStrategy(pools, Platform::userAgent(), this);
+    }
+    else if (pools.size() > 1 && options->poolStrategy() == Options::POOL_SPLIT) {
+        m_strategy = new SplitStrategy(pools, Platform::userAgent(), this);
+    }
+    else if (pools.size() > 1) {
         m_strategy = new FailoverStrategy(pools, Platform::userAgent(), this);
     }
     else {
@@ -65,6 +77,15 @@ Network::Network(const Options *options) :
         m_donate = new DonateStrategy(Platform::userAgent(), this);
     }
 
+    if (m_options->proxyPort() > 0) {
+        m_proxy = new Proxy(this);
+
+        if (!m_proxy->start(m_options->proxyPort())) {
+            delete m_proxy;
+            m_proxy = nullptr;
+        }
+    }
+
     m_timer.data = this;
     uv_timer_init(uv_default_loop(), &m_timer);
 
@@ -89,10 +110,20 @@ void Network::stop()
         m_donate->stop();
     }
 
+    if (m_proxy) {
+        m_proxy->stop();
+    }
+
     m_strategy->stop();
 }
 
 
+bool Network::setPool(int index)
+{
+    return m_strategy->setPool(index);
+}
+
+
 void Network::printState()
 {
     uint32_t total = m_state.totalTime();
@@ -113,14 +144,30 @@ void Network::onActive(Client *client)
         return;
     }
 
+    m_client = client;
+    Startup::mark(Startup::Pool);
     m_state.setPool(client->host(), client->port(), client->ip());
 
     LOG_INFO(m_options->colors() ? "\x1B[01;37muse pool \x1B[01;36m%s:%d \x1B[01;30m%s" : "use pool %s:%d %s", client->host(), client->port(), client->ip());
 }
 
 
+void Network::onClose(Client *client, int failures)
+{
+    if (client->id() == -1 || client->error()[0] == '\0') {
+        return;
+    }
+
+    m_state.addError(client->host(), client->port(), client->error());
+}
+
+
 void Network::onJob(Client *client, const Job &job)
 {
+    if (m_proxy && client->id() != -1) {
+        m_proxy->setJob(job);
+    }
+
     if (m_donate && m_donate->isActive() && client->id() != -1) {
         return;
     }
@@ -155,9 +202,23 @@ void Network::onPause(IStrategy *strategy)
 }
 
 
+int64_t Network::onProxySubmit(const JobResult &result)
+{
+    return m_strategy->submit(result);
+}
+
+
 void Network::onResultAccepted(Client *client, const SubmitResult &result, const char *error)
 {
-    m_state.add(result, error);
+    if (m_proxy) {
+        m_proxy->onResult(result.seq, error);
+    }
+
+    m_state.add(client->host(), client->port(), result, error);
+
+    if (!error && client->id() != -1) {
+        Startup::mark(Startup::Share);
+    }
 
     if (error) {
         LOG_INFO(m_options->colors() ? "\x1B[01;31mrejected\x1B[0m (%" PRId64 "/%" PRId64 ") diff \x1B[01;37m%u\x1B[0m \x1B[31m\"%s\"\x1B[0m \x1B[01;30m(%" PRIu64 " ms)"
@@ -172,6 +233,12 @@ void Network::onResultAccepted(Client *client, const SubmitResult &result, const
 }
 
 
+void Network::onWeights(const std::vector<int> &weights)
+{
+    Workers::setWeights(weights);
+}
+
+
 void Network::setJob(Client *client, const Job &job)
 {
     if (m_options->colors()) {
@@ -181,7 +248,21 @@ void Network::setJob(Client *client, const Job &job)
         LOG_INFO("new job from %s:%d diff %d", client->host(), client->port(), job.diff());
     }
 
+    if (job.poolId() >= 0) {
+        Startup::mark(Startup::Job);
+    }
+
     m_state.diff = job.diff();
+    m_state.jobs++;
+
+    // upper nonce byte 0 is reserved for local threads, other values belong to proxy miners.
+    if (m_proxy && job.poolId() >= 0 && !job.isNicehash()) {
+        Job local = job;
+        local.setNicehash(true);
+
+        return Workers::setJob(local);
+    }
+
     Workers::setJob(job);
 }
 
@@ -191,11 +272,16 @@ void Network::tick()
     const uint64_t now = uv_now(uv_default_loop());
 
     m_strategy->tick(now);
+    m_state.tick(now);
 
     if (m_donate) {
         m_donate->tick(now);
     }
 
+    if (m_client) {
+        m_state.writeQueue = m_client->writeQueue().stats();
+    }
+
 #   ifndef XMRIG_NO_API
     Api::tick(m_state);
 #   endif
@@ -31,30 +31,38 @@
 
 #include "api/NetworkState.h"
 #include "interfaces/IJobResultListener.h"
+#include "interfaces/IProxyListener.h"
 #include "interfaces/IStrategyListener.h"
 
 
 class IStrategy;
 class Options;
+class Proxy;
 class Url;
 
 
-class Network : public IJobResultListener, public IStrategyListener
+class Network : public IJobResultListener, public IProxyListener, public IStrategyListener
 {
 public:
   Network(const Options *options);
   ~Network();
 
+  bool setPool(int index);
   void connect();
   void stop();
   void printState();
 
+  inline NetworkState &state() { return m_state; }
+
 protected:
   void onActive(Client *client) override;
+  void onClose(Client *client, int failures) override;
   void onJob(Client *client, const Job &job) override;
   void onJobResult(const JobResult &result) override;
   void onPause(IStrategy *strategy) override;
+  int64_t onProxySubmit(const JobResult &result) override;
   void onResultAccepted(Client *client, const SubmitResult &result, const char *error) override;
+  void onWeights(const std::vector<int> &weights) override;
 
 private:
   constexpr static int kTickInterval = 1 * 1000;
@@ -64,10 +72,12 @@ private:
 
   static void onTick(uv_timer_t *handle);
 
+  Client *m_client;
   const Options *m_options;
   IStrategy *m_donate;
   IStrategy *m_strategy;
   NetworkState m_state;
+  Proxy *m_proxy;
   uv_timer_t m_timer;
 };
 
@@ -0,0 +1,166 @@
+/* XMRig
+ * Copyright 2010      Jeff Garzik <jgarzik@pobox.com>
+ * Copyright 2012-2014 pooler      <pooler@litecoinpool.org>
+ * Copyright 2014      Lucas Jones <https://github.com/lucasjones>
+ * Copyright 2014-2016 Wolf9466    <https://github.com/OhGodAPet>
+ * Copyright 2016      Jay D Dee   <jayddee246@gmail.com>
+ * Copyright 2016-2017 XMRig       <support@xmrig.com>
+ *
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include <string.h>
+
+
+#include "net/PoolSelector.h"
+
+
+static inline double ewma(double average, double value, double alpha)
+{
+    return average + alpha * (value - average);
+}
+
+
+PoolSelector::PoolSelector(size_t count) :
+    m_candidate(-1),
+    m_metrics(count),
+    m_blockTime(0),
+    m_candidateTime(0),
+    m_switchTime(0)
+{
+    memset(m_metrics.data(), 0, sizeof(Metrics) * count);
+    memset(m_block, 0, sizeof(m_block));
+}
+
+
+/**
+ * @brief Pool to mine on, -1 if no pool is ready.
+ */
+int PoolSelector::select(int active, const std::vector<bool> &ready, uint64_t now)
+{
+    int best = -1;
+
+    for (size_t i = 0; i < m_metrics.size(); ++i) {
+        if (ready[i] && (best == -1 || m_metrics[i].cost() < m_metrics[best].cost())) {
+            best = (int) i;
+        }
+    }
+
+    if (best == -1 || active < 0 || !ready[active]) {
+        m_candidate = -1;
+        return best;
+    }
+
+    if (best == active || m_metrics[best].cost() >= m_metrics[active].cost() * (1.0 - kHysteresis)) {
+        m_candidate = -1;
+        return active;
+    }
+
+    if (best != m_candidate) {
+        m_candidate     = best;
+        m_candidateTime = now;
+    }
+
+    if (now - m_candidateTime < kHoldTime || now - m_switchTime < kMinDwell) {
+        return active;
+    }
+
+    return best;
+}
+
+
+/**
+ * @brief Track lag between pools by previous block hash of each new job.
+ */
+void PoolSelector::onJob(size_t index, const uint8_t *blob, size_t size, uint64_t now)
+{
+    uint8_t prev[32];
+    if (!prevHash(blob, size, prev)) {
+        return;
+    }
+
+    Metrics &metrics = m_metrics[index];
+    if (metrics.block && memcmp(metrics.prev, prev, sizeof(prev)) == 0) {
+        return;
+    }
+
+    double lag = 0.0;
+    if (m_blockTime && memcmp(m_block, prev, sizeof(prev)) == 0) {
+        lag = (double) (now - m_blockTime);
+    }
+    else {
+        memcpy(m_block, prev, sizeof(prev));
+        m_blockTime = now;
+    }
+
+    metrics.lag = metrics.block ? ewma(metrics.lag, lag, 0.2) : lag;
+    metrics.block = true;
+    memcpy(metrics.prev, prev, sizeof(prev));
+}
+
+
+/**
+ * @brief Login round trip is the only latency sample for pools without shares.
+ */
+void PoolSelector::onLogin(size_t index, uint64_t latency)
+{
+    Metrics &metrics = m_metrics[index];
+
+    metrics.latency = metrics.results ? ewma(metrics.latency, (double) latency, 0.1) : (double) latency;
+}
+
+
+void PoolSelector::onResult(size_t index, uint64_t elapsed, bool rejected)
+{
+    Metrics &metrics = m_metrics[index];
+
+    metrics.latency = metrics.results ? ewma(metrics.latency, (double) elapsed, 0.1) : (double) elapsed;
+    metrics.rejects = ewma(metrics.rejects, rejected ? 1.0 : 0.0, 0.02);
+    metrics.results++;
+}
+
+
+void PoolSelector::onSwitch(uint64_t now)
+{
+    m_candidate  = -1;
+    m_switchTime = now;
+}
+
+
+/**
+ * @brief Previous block id from hashing blob: major and minor version, timestamp (varints), then 32 bytes.
+ */
+bool PoolSelector::prevHash(const uint8_t *blob, size_t size, uint8_t *hash)
+{
+    size_t pos = 0;
+
+    for (int field = 0; field < 3; ++field) {
+        while (pos < size && (blob[pos] & 0x80)) {
+            pos++;
+        }
+
+        if (++pos > size) {
+            return false;
+        }
+    }
+
+    if (pos + 32 > size) {
+        return false;
+    }
+
+    memcpy(hash, blob + pos, 32);
+    return true;
+}
@@ -0,0 +1,83 @@
+/* XMRig
+ * Copyright 2010      Jeff Garzik <jgarzik@pobox.com>
+ * Copyright 2012-2014 pooler      <pooler@litecoinpool.org>
+ * Copyright 2014      Lucas Jones <https://github.com/lucasjones>
+ * Copyright 2014-2016 Wolf9466    <https://github.com/OhGodAPet>
+ * Copyright 2016      Jay D Dee   <jayddee246@gmail.com>
+ * Copyright 2016-2017 XMRig       <support@xmrig.com>
+ *
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef __POOLSELECTOR_H__
+#define __POOLSELECTOR_H__
+
+
+#include <stddef.h>
+#include <stdint.h>
+#include <vector>
+
+
+/**
+ * Pool ranking for AdaptiveStrategy.
+ *
+ * Cost of a pool is expressed in milliseconds: response round trip, lag behind
+ * the first pool that announced the current block and reject rate weighted by kRejectWeight.
+ * Active pool is replaced only if the candidate stays kHysteresis cheaper for kHoldTime
+ * and the active pool was used at least kMinDwell.
+ */
+class PoolSelector
+{
+public:
+    constexpr static double kHysteresis     = 0.2;
+    constexpr static double kRejectWeight   = 10000.0;
+    constexpr static uint64_t kHoldTime     = 60 * 1000;
+    constexpr static uint64_t kMinDwell     = 5 * 60 * 1000;
+
+    struct Metrics
+    {
+        inline double cost() const { return latency + lag + rejects * kRejectWeight; }
+
+        bool block;
+        double lag;
+        double latency;
+        double rejects;
+        uint64_t results;
+        uint8_t prev[32];
+    };
+
+    PoolSelector(size_t count);
+
+    int select(int active, const std::vector<bool> &ready, uint64_t now);
+    void onJob(size_t index, const uint8_t *blob, size_t size, uint64_t now);
+    void onLogin(size_t index, uint64_t latency);
+    void onResult(size_t index, uint64_t elapsed, bool rejected);
+    void onSwitch(uint64_t now);
+
+    static bool prevHash(const uint8_t *blob, size_t size, uint8_t *hash);
+
+    inline const Metrics &metrics(size_t index) const { return m_metrics[index]; }
+
+private:
+    int m_candidate;
+    std::vector<Metrics> m_metrics;
+    uint64_t m_blockTime;
+    uint64_t m_candidateTime;
+    uint64_t m_switchTime;
+    uint8_t m_block[32];
+};
+
+
+#endif /* __POOLSELECTOR_H__ */
@@ -0,0 +1,125 @@
+/* XMRig
+ * Copyright 2010      Jeff Garzik <jgarzik@pobox.com>
+ * Copyright 2012-2014 pooler      <pooler@litecoinpool.org>
+ * Copyright 2014      Lucas Jones <https://github.com/lucasjones>
+ * Copyright 2014-2016 Wolf9466    <https://github.com/OhGodAPet>
+ * Copyright 2016      Jay D Dee   <jayddee246@gmail.com>
+ * Copyright 2016-2017 XMRig       <support@xmrig.com>
+ *
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include <stdlib.h>
+#include <string.h>
+
+
+#include "net/RecvBuffer.h"
+
+
+RecvBuffer::RecvBuffer(size_t maxSize) :
+    m_data(nullptr),
+    m_begin(0),
+    m_capacity(0),
+    m_end(0),
+    m_maxSize(0),
+    m_scan(0)
+{
+    setMaxSize(maxSize);
+}
+
+
+RecvBuffer::~RecvBuffer()
+{
+    free(m_data);
+}
+
+
+/**
+ * @brief Next complete line including trailing '\n', nullptr if the data is incomplete.
+ */
+char *RecvBuffer::next(size_t &len)
+{
+    if (m_scan == m_end) {
+        return nullptr;
+    }
+
+    const char *end = static_cast<const char*>(memchr(m_data + m_scan, '\n', m_end - m_scan));
+    if (!end) {
+        m_scan = m_end;
+        return nullptr;
+    }
+
+    char *line = m_data + m_begin;
+    len = (size_t) (end - line) + 1;
+
+    m_begin += len;
+    m_scan   = m_begin;
+
+    return line;
+}
+
+
+/**
+ * @brief Free space for the next read, size is 0 if an unfinished line already occupies maximum size.
+ */
+char *RecvBuffer::reserve(size_t &size)
+{
+    if (m_begin == m_end) {
+        m_begin = m_end = m_scan = 0;
+    }
+
+    if (m_capacity - m_end < kMinRead && m_begin > 0) {
+        memmove(m_data, m_data + m_begin, m_end - m_begin);
+
+        m_end  -= m_begin;
+        m_scan -= m_begin;
+        m_begin = 0;
+    }
+
+    if (m_capacity - m_end < kMinRead && m_capacity < m_maxSize) {
+        size_t capacity = m_capacity ? m_capacity * 2 : kInitialSize;
+        if (capacity > m_maxSize) {
+            capacity = m_maxSize;
+        }
+
+        char *data = static_cast<char*>(realloc(m_data, capacity));
+        if (data) {
+            m_data     = data;
+            m_capacity = capacity;
+        }
+    }
+
+    size = m_capacity - m_end;
+    return m_data + m_end;
+}
+
+
+void RecvBuffer::commit(size_t size)
+{
+    m_end += size;
+}
+
+
+void RecvBuffer::reset()
+{
+    m_begin = m_end = m_scan = 0;
+}
+
+
+void RecvBuffer::setMaxSize(size_t size)
+{
+    m_maxSize = size > kMinRead ? size : kMinRead;
+}
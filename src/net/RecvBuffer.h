@@ -0,0 +1,67 @@
+/* XMRig
+ * Copyright 2010      Jeff Garzik <jgarzik@pobox.com>
+ * Copyright 2012-2014 pooler      <pooler@litecoinpool.org>
+ * Copyright 2014      Lucas Jones <https://github.com/lucasjones>
+ * Copyright 2014-2016 Wolf9466    <https://github.com/OhGodAPet>
+ * Copyright 2016      Jay D Dee   <jayddee246@gmail.com>
+ * Copyright 2016-2017 XMRig       <support@xmrig.com>
+ *
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef __RECVBUFFER_H__
+#define __RECVBUFFER_H__
+
+
+#include <stddef.h>
+
+
+/**
+ * Growable buffer for newline delimited messages.
+ *
+ * Complete lines are consumed by advancing the read offset, the unfinished
+ * tail is moved to the front only when the free space at the end runs low.
+ */
+class RecvBuffer
+{
+public:
+    constexpr static size_t kInitialSize = 4 * 1024;
+    constexpr static size_t kMaxSize     = 64 * 1024;
+    constexpr static size_t kMinRead     = 1024;
+
+    RecvBuffer(size_t maxSize = kMaxSize);
+    ~RecvBuffer();
+
+    char *next(size_t &len);
+    char *reserve(size_t &size);
+    void commit(size_t size);
+    void reset();
+    void setMaxSize(size_t size);
+
+    inline size_t capacity() const { return m_capacity; }
+    inline size_t maxSize() const  { return m_maxSize; }
+    inline size_t size() const     { return m_end - m_begin; }
+
+private:
+    char *m_data;
+    size_t m_begin;
+    size_t m_capacity;
+    size_t m_end;
+    size_t m_maxSize;
+    size_t m_scan;
+};
+
+
+#endif /* __RECVBUFFER_H__ */
@@ -0,0 +1,450 @@
+/* XMRig
+ * Copyright 2010      Jeff Garzik <jgarzik@pobox.com>
+ * Copyright 2012-2014 pooler      <pooler@litecoinpool.org>
+ * Copyright 2014      Lucas Jones <https://github.com/lucasjones>
+ * Copyright 2014-2016 Wolf9466    <https://github.com/OhGodAPet>
+ * Copyright 2016      Jay D Dee   <jayddee246@gmail.com>
+ * Copyright 2016-2017 XMRig       <support@xmrig.com>
+ *
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include <string.h>
+
+
+#include "net/StratumParser.h"
+#include "rapidjson/document.h"
+
+
+class StratumScanner
+{
+public:
+    enum Section {
+        RootSection,
+        JobSection,
+        ResultSection,
+        ErrorSection,
+        SkipSection
+    };
+
+    inline StratumScanner(char *line, size_t len) : m_end(line + len), m_p(line), m_count(0) {}
+
+    bool scan(StratumMessage &message);
+
+private:
+    constexpr static int kMaxDepth   = 16;
+    constexpr static int kMaxStrings = 16;
+
+    struct Token
+    {
+        char *ptr;
+        size_t len;
+    };
+
+    static inline bool match(const Token &key, const char *name) { return strlen(name) == key.len && memcmp(key.ptr, name, key.len) == 0; }
+
+    bool capture(const char **out);
+    bool consume(char c);
+    bool members(Section section, StratumMessage &message, int depth);
+    bool number(int64_t *out);
+    bool skip(int depth);
+    bool string(Token *token);
+    bool value(Section section, const Token &key, StratumMessage &message, int depth);
+    char peek();
+    void skipSpaces();
+
+    char *m_end;
+    char *m_p;
+    int m_count;
+    Token m_strings[kMaxStrings];
+};
+
+
+bool StratumScanner::scan(StratumMessage &message)
+{
+    if (!members(RootSection, message, 0)) {
+        return false;
+    }
+
+    skipSpaces();
+    if (m_p != m_end && *m_p != '\0') {
+        return false;
+    }
+
+    // terminate captured strings only after whole line accepted, so failed scan leaves buffer intact for DOM.
+    for (int i = 0; i < m_count; ++i) {
+        m_strings[i].ptr[m_strings[i].len] = '\0';
+    }
+
+    if (message.hasError && !message.errorMessage) {
+        message.errorMessage = "";
+    }
+
+    return true;
+}
+
+
+bool StratumScanner::capture(const char **out)
+{
+    Token token;
+    if (m_count == kMaxStrings || !string(&token)) {
+        return false;
+    }
+
+    m_strings[m_count++] = token;
+    *out = token.ptr;
+    return true;
+}
+
+
+bool StratumScanner::consume(char c)
+{
+    skipSpaces();
+
+    if (m_p < m_end && *m_p == c) {
+        m_p++;
+        return true;
+    }
+
+    return false;
+}
+
+
+bool StratumScanner::members(Section section, StratumMessage &message, int depth)
+{
+    if (depth > kMaxDepth || !consume('{')) {
+        return false;
+    }
+
+    if (consume('}')) {
+        return true;
+    }
+
+    do {
+        Token key;
+        if (!string(&key) || !consume(':') || !value(section, key, message, depth + 1)) {
+            return false;
+        }
+    } while (consume(','));
+
+    return consume('}');
+}
+
+
+/**
+ * @brief Integer only, fractions and exponents are left to DOM.
+ */
+bool StratumScanner::number(int64_t *out)
+{
+    skipSpaces();
+
+    const bool negative = m_p < m_end && *m_p == '-';
+    if (negative) {
+        m_p++;
+    }
+
+    int64_t value = 0;
+    int digits    = 0;
+
+    while (m_p < m_end && *m_p >= '0' && *m_p <= '9') {
+        if (++digits > 18) {
+            return false;
+        }
+
+        value = value * 10 + (*m_p++ - '0');
+    }
+
+    if (digits == 0 || (m_p < m_end && (*m_p == '.' || *m_p == 'e' || *m_p == 'E'))) {
+        return false;
+    }
+
+    *out = negative ? -value : value;
+    return true;
+}
+
+
+bool StratumScanner::skip(int depth)
+{
+    if (depth > kMaxDepth) {
+        return false;
+    }
+
+    const char c = peek();
+
+    if (c == '"') {
+        Token token;
+        return string(&token);
+    }
+
+    if (c == '{') {
+        StratumMessage unused;
+        return members(SkipSection, unused, depth);
+    }
+
+    if (c == '[') {
+        m_p++;
+        if (consume(']')) {
+            return true;
+        }
+
+        do {
+            if (!skip(depth + 1)) {
+                return false;
+            }
+        } while (consume(','));
+
+        return consume(']');
+    }
+
+    static const char *literals[] = { "true", "false", "null" };
+    for (const char *literal : literals) {
+        const size_t len = strlen(literal);
+        if ((size_t) (m_end - m_p) >= len && memcmp(m_p, literal, len) == 0) {
+            m_p += len;
+            return true;
+        }
+    }
+
+    if (c == '-' || (c >= '0' && c <= '9')) {
+        while (m_p < m_end && *m_p != '\0' && strchr("+-.eE0123456789", *m_p)) {
+            m_p++;
+        }
+
+        return true;
+    }
+
+    return false;
+}
+
+
+/**
+ * @brief Plain string without escapes, token points after opening quote.
+ *
+ * Both searches are done with memchr, long hex blobs are the bulk of stratum traffic.
+ */
+bool StratumScanner::string(Token *token)
+{
+    if (!consume('"')) {
+        return false;
+    }
+
+    char *start = m_p;
+    char *quote = static_cast<char *>(memchr(start, '"', m_end - start));
+    if (!quote) {
+        return false;
+    }
+
+    if (memchr(start, '\\', quote - start)) {
+        return false;
+    }
+
+    token->ptr = start;
+    token->len = (size_t) (quote - start);
+    m_p        = quote + 1;
+
+    return true;
+}
+
+
+bool StratumScanner::value(Section section, const Token &key, StratumMessage &message, int depth)
+{
+    const char c = peek();
+
+    switch (section) {
+    case RootSection:
+        if (match(key, "id")) {
+            if (c == 'n') {
+                return skip(depth);
+            }
+
+            message.hasId = true;
+            return number(&message.id);
+        }
+
+        if (match(key, "method") && c == '"') {
+            return capture(&message.method);
+        }
+
+        if (match(key, "params") && c == '{') {
+            message.job.valid = true;
+            return members(JobSection, message, depth);
+        }
+
+        if (match(key, "result") && c == '{') {
+            message.hasResult = true;
+            return members(ResultSection, message, depth);
+        }
+
+        if (match(key, "error") && c == '{') {
+            message.hasError = true;
+            return members(ErrorSection, message, depth);
+        }
+        break;
+
+    case JobSection:
+        if (c == '"') {
+            if (match(key, "job_id")) {
+                return capture(&message.job.id);
+            }
+
+            if (match(key, "blob")) {
+                return capture(&message.job.blob);
+            }
+
+            if (match(key, "target")) {
+                return capture(&message.job.target);
+            }
+        }
+        break;
+
+    case ResultSection:
+        if (match(key, "id") && c == '"') {
+            return capture(&message.loginId);
+        }
+
+        if (match(key, "status") && c == '"') {
+            return capture(&message.status);
+        }
+
+        if (match(key, "job") && c == '{') {
+            message.job.valid = true;
+            return members(JobSection, message, depth);
+        }
+        break;
+
+    case ErrorSection:
+        if (match(key, "code") && (c == '-' || (c >= '0' && c <= '9'))) {
+            int64_t code = 0;
+            if (!number(&code)) {
+                return false;
+            }
+
+            message.errorCode = (int) code;
+            return true;
+        }
+
+        if (match(key, "message") && c == '"') {
+            return capture(&message.errorMessage);
+        }
+        break;
+
+    default:
+        break;
+    }
+
+    return skip(depth);
+}
+
+
+char StratumScanner::peek()
+{
+    skipSpaces();
+
+    return m_p < m_end ? *m_p : '\0';
+}
+
+
+void StratumScanner::skipSpaces()
+{
+    while (m_p < m_end && (*m_p == ' ' || *m_p == '\t' || *m_p == '\r' || *m_p == '\n')) {
+        m_p++;
+    }
+}
+
+
+static const rapidjson::Value *member(const rapidjson::Value &object, const char *name)
+{
+    if (!object.IsObject()) {
+        return nullptr;
+    }
+
+    auto it = object.FindMember(name);
+    return it != object.MemberEnd() ? &it->value : nullptr;
+}
+
+
+static const char *string(const rapidjson::Value &object, const char *name)
+{
+    const rapidjson::Value *value = member(object, name);
+    return value && value->IsString() ? value->GetString() : nullptr;
+}
+
+
+static void job(const rapidjson::Value *value, StratumJob &job)
+{
+    if (!value || !value->IsObject()) {
+        return;
+    }
+
+    job.valid  = true;
+    job.id     = string(*value, "job_id");
+    job.blob   = string(*value, "blob");
+    job.target = string(*value, "target");
+}
+
+
+bool StratumParser::parse(char *line, size_t len, StratumMessage &message)
+{
+    memset(&message, 0, sizeof(message));
+
+    StratumScanner scanner(line, len);
+    if (scanner.scan(message)) {
+        return true;
+    }
+
+    memset(&message, 0, sizeof(message));
+    return false;
+}
+
+
+/**
+ * @brief Fill message from DOM, used as fallback for lines not accepted by fast path.
+ */
+void StratumParser::parse(const rapidjson::Value &doc, StratumMessage &message)
+{
+    memset(&message, 0, sizeof(message));
+
+    const rapidjson::Value *id = member(doc, "id");
+    if (id && id->IsInt64()) {
+        message.hasId = true;
+        message.id    = id->GetInt64();
+    }
+
+    message.method = string(doc, "method");
+    job(member(doc, "params"), message.job);
+
+    const rapidjson::Value *result = member(doc, "result");
+    if (result && result->IsObject()) {
+        message.hasResult = true;
+        message.loginId   = string(*result, "id");
+        message.status    = string(*result, "status");
+
+        job(member(*result, "job"), message.job);
+    }
+
+    const rapidjson::Value *error = member(doc, "error");
+    if (error && error->IsObject()) {
+        const rapidjson::Value *code = member(*error, "code");
+
+        message.hasError     = true;
+        message.errorMessage = string(*error, "message");
+        message.errorCode    = code && code->IsInt() ? code->GetInt() : 0;
+
+        if (!message.errorMessage) {
+            message.errorMessage = "";
+        }
+    }
+}
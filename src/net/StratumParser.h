@@ -0,0 +1,76 @@
+/* XMRig
+ * Copyright 2010      Jeff Garzik <jgarzik@pobox.com>
+ * Copyright 2012-2014 pooler      <pooler@litecoinpool.org>
+ * Copyright 2014      Lucas Jones <https://github.com/lucasjones>
+ * Copyright 2014-2016 Wolf9466    <https://github.com/OhGodAPet>
+ * Copyright 2016      Jay D Dee   <jayddee246@gmail.com>
+ * Copyright 2016-2017 XMRig       <support@xmrig.com>
+ *
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef __STRATUMPARSER_H__
+#define __STRATUMPARSER_H__
+
+
+#include <stddef.h>
+#include <stdint.h>
+
+
+#include "rapidjson/fwd.h"
+
+
+struct StratumJob
+{
+    bool valid;
+    const char *blob;
+    const char *id;
+    const char *target;
+};
+
+
+/**
+ * Fields of stratum message used by client, strings point into receive buffer.
+ */
+struct StratumMessage
+{
+    bool hasError;
+    bool hasId;
+    bool hasResult;
+    const char *errorMessage;
+    const char *loginId;
+    const char *method;
+    const char *status;
+    int errorCode;
+    int64_t id;
+    StratumJob job;
+};
+
+
+/**
+ * Extracts job notification, login result, submit response and error fields in place, without DOM.
+ *
+ * Returns false for anything it does not handle (escaped strings, non integer id, malformed JSON),
+ * buffer is left untouched in this case and should be parsed with rapidjson.
+ */
+class StratumParser
+{
+public:
+    static bool parse(char *line, size_t len, StratumMessage &message);
+    static void parse(const rapidjson::Value &doc, StratumMessage &message);
+};
+
+
+#endif /* __STRATUMPARSER_H__ */
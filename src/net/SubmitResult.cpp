@@ -28,8 +28,9 @@
 #include "net/SubmitResult.h"
 
 
-SubmitResult::SubmitResult(int64_t seq, uint32_t diff, uint64_t actualDiff) :
+SubmitResult::SubmitResult(int64_t seq, uint32_t diff, uint64_t actualDiff, const JobId &jobId) :
     seq(seq),
+    jobId(jobId),
     diff(diff),
     actualDiff(actualDiff),
     elapsed(0)
@@ -28,15 +28,19 @@
 #include <uv.h>
 
 
+#include "net/JobId.h"
+
+
 class SubmitResult
 {
 public:
     inline SubmitResult() : seq(0), diff(0), actualDiff(0), elapsed(0), start(0) {}
-    SubmitResult(int64_t seq, uint32_t diff, uint64_t actualDiff);
+    SubmitResult(int64_t seq, uint32_t diff, uint64_t actualDiff, const JobId &jobId);
 
     void done();
 
     int64_t seq;
+    JobId jobId;
     uint32_t diff;
     uint64_t actualDiff;
     uint64_t elapsed;
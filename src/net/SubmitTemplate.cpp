@@ -0,0 +1,123 @@
+/* XMRig
+ * Copyright 2010      Jeff Garzik <jgarzik@pobox.com>
+ * Copyright 2012-2014 pooler      <pooler@litecoinpool.org>
+ * Copyright 2014      Lucas Jones <https://github.com/lucasjones>
+ * Copyright 2014-2016 Wolf9466    <https://github.com/OhGodAPet>
+ * Copyright 2016      Jay D Dee   <jayddee246@gmail.com>
+ * Copyright 2016-2017 XMRig       <support@xmrig.com>
+ *
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include <string.h>
+
+
+#include "net/Hex.h"
+#include "net/SubmitTemplate.h"
+
+
+static const char kTail[] = ",\"jsonrpc\":\"2.0\"}\n";
+
+
+SubmitTemplate::SubmitTemplate() :
+    m_nonce(0),
+    m_result(0),
+    m_size(0)
+{
+    m_rpcId[0] = '\0';
+}
+
+
+size_t SubmitTemplate::write(char *buf, uint64_t id, const char *rpcId, const JobId &jobId, uint32_t nonce, const uint8_t *result)
+{
+    prepare(rpcId, jobId);
+
+    memcpy(buf, m_data, m_size);
+    Hex::encode(reinterpret_cast<const uint8_t*>(&nonce), 4, buf + m_nonce);
+    Hex::encode(result, 32, buf + m_result);
+
+    return finalize(buf, id);
+}
+
+
+#ifdef XMRIG_PROXY_PROJECT
+size_t SubmitTemplate::write(char *buf, uint64_t id, const char *rpcId, const JobId &jobId, const char *nonce, const char *result)
+{
+    prepare(rpcId, jobId);
+
+    memcpy(buf, m_data, m_size);
+    memcpy(buf + m_nonce, nonce, 8);
+    memcpy(buf + m_result, result, 64);
+
+    return finalize(buf, id);
+}
+#endif
+
+
+size_t SubmitTemplate::finalize(char *buf, uint64_t id) const
+{
+    char digits[20];
+    size_t count = 0;
+
+    do {
+        digits[count++] = (char) ('0' + id % 10);
+        id /= 10;
+    } while (id);
+
+    char *out = buf + m_size;
+    while (count) {
+        *out++ = digits[--count];
+    }
+
+    memcpy(out, kTail, sizeof(kTail));
+
+    return (size_t) (out - buf) + sizeof(kTail) - 1;
+}
+
+
+void SubmitTemplate::prepare(const char *rpcId, const JobId &jobId)
+{
+    if (m_size && m_jobId == jobId && strcmp(m_rpcId, rpcId) == 0) {
+        return;
+    }
+
+    strncpy(m_rpcId, rpcId, sizeof(m_rpcId) - 1);
+    m_rpcId[sizeof(m_rpcId) - 1] = '\0';
+    m_jobId = jobId;
+
+    char *out = m_data;
+    auto append = [&out](const char *str) {
+        const size_t size = strlen(str);
+        memcpy(out, str, size);
+        out += size;
+    };
+
+    append("{\"method\":\"submit\",\"params\":{\"id\":\"");
+    append(m_rpcId);
+    append("\",\"job_id\":\"");
+    append(m_jobId.data());
+    append("\",\"nonce\":\"");
+    m_nonce = (size_t) (out - m_data);
+    memset(out, '0', 8);
+    out += 8;
+    append("\",\"result\":\"");
+    m_result = (size_t) (out - m_data);
+    memset(out, '0', 64);
+    out += 64;
+    append("\"},\"id\":");
+
+    m_size = (size_t) (out - m_data);
+}
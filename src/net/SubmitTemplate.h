@@ -0,0 +1,67 @@
+/* XMRig
+ * Copyright 2010      Jeff Garzik <jgarzik@pobox.com>
+ * Copyright 2012-2014 pooler      <pooler@litecoinpool.org>
+ * Copyright 2014      Lucas Jones <https://github.com/lucasjones>
+ * Copyright 2014-2016 Wolf9466    <https://github.com/OhGodAPet>
+ * Copyright 2016      Jay D Dee   <jayddee246@gmail.com>
+ * Copyright 2016-2017 XMRig       <support@xmrig.com>
+ *
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef __SUBMITTEMPLATE_H__
+#define __SUBMITTEMPLATE_H__
+
+
+#include <stddef.h>
+#include <stdint.h>
+
+
+#include "net/JobId.h"
+
+
+/**
+ * Pre-formatted submit request, rebuilt only when login id or job id changes.
+ *
+ * The nonce and result slots have fixed offsets and are patched in place,
+ * the request id has variable width and goes to the end of the line.
+ */
+class SubmitTemplate
+{
+public:
+    constexpr static size_t kMaxSize = 384;
+
+    SubmitTemplate();
+
+    size_t write(char *buf, uint64_t id, const char *rpcId, const JobId &jobId, uint32_t nonce, const uint8_t *result);
+
+#   ifdef XMRIG_PROXY_PROJECT
+    size_t write(char *buf, uint64_t id, const char *rpcId, const JobId &jobId, const char *nonce, const char *result);
+#   endif
+
+private:
+    size_t finalize(char *buf, uint64_t id) const;
+    void prepare(const char *rpcId, const JobId &jobId);
+
+    char m_data[kMaxSize];
+    char m_rpcId[64];
+    JobId m_jobId;
+    size_t m_nonce;
+    size_t m_result;
+    size_t m_size;
+};
+
+
+#endif /* __SUBMITTEMPLATE_H__ */
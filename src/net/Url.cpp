@@ -41,6 +41,7 @@ Url::Url() :
     m_host(nullptr),
     m_password(nullptr),
     m_user(nullptr),
+    m_weight(1),
     m_port(kDefaultPort)
 {
 }
@@ -63,6 +64,7 @@ Url::Url(const char *url) :
     m_host(nullptr),
     m_password(nullptr),
     m_user(nullptr),
+    m_weight(1),
     m_port(kDefaultPort)
 {
     parse(url);
@@ -74,6 +76,7 @@ Url::Url(const char *host, uint16_t port, const char *user, const char *password
     m_nicehash(nicehash),
     m_password(password ? strdup(password) : nullptr),
     m_user(user ? strdup(user) : nullptr),
+    m_weight(1),
     m_port(port)
 {
     m_host = strdup(host);
@@ -105,18 +108,33 @@ bool Url::parse(const char *url)
         return false;
     }
 
-    const char *port = strchr(base, ':');
+    const char *host = base;
+    const char *end  = nullptr;
+    const char *port = nullptr;
+
+    if (*base == '[') {
+        host = base + 1;
+        end  = strchr(host, ']');
+        if (!end) {
+            return false;
+        }
+
+        port = end[1] == ':' ? end + 1 : nullptr;
+    }
+    else {
+        port = end = strchr(base, ':');
+    }
+
+    const size_t size = (end ? end : host + strlen(host)) - host;
+    m_host = static_cast<char*>(malloc(size + 1));
+    memcpy(m_host, host, size);
+    m_host[size] = '\0';
+
     if (!port) {
-        m_host = strdup(base);
         return false;
     }
 
-    const size_t size = port++ - base + 1;
-    m_host = static_cast<char*>(malloc(size));
-    memcpy(m_host, base, size - 1);
-    m_host[size - 1] = '\0';
-
-    m_port = (uint16_t) strtol(port, nullptr, 10);
+    m_port = (uint16_t) strtol(port + 1, nullptr, 10);
     return true;
 }
 
@@ -183,6 +201,7 @@ Url &Url::operator=(const Url *other)
     m_keepAlive = other->m_keepAlive;
     m_nicehash  = other->m_nicehash;
     m_port      = other->m_port;
+    m_weight    = other->m_weight;
 
     free(m_host);
     m_host = strdup(other->m_host);
@@ -46,9 +46,11 @@ public:
     inline const char *host() const          { return m_host; }
     inline const char *password() const      { return m_password ? m_password : kDefaultPassword; }
     inline const char *user() const          { return m_user ? m_user : kDefaultUser; }
+    inline int weight() const                { return m_weight; }
     inline uint16_t port() const             { return m_port; }
     inline void setKeepAlive(bool keepAlive) { m_keepAlive = keepAlive; }
     inline void setNicehash(bool nicehash)   { m_nicehash = nicehash; }
+    inline void setWeight(int weight)        { m_weight = weight; }
 
     bool parse(const char *url);
     bool setUserpass(const char *userpass);
@@ -64,6 +66,7 @@ private:
     char *m_host;
     char *m_password;
     char *m_user;
+    int m_weight;
     uint16_t m_port;
 };
 
@@ -0,0 +1,176 @@
+/* XMRig
+ * Copyright 2010      Jeff Garzik <jgarzik@pobox.com>
+ * Copyright 2012-2014 pooler      <pooler@litecoinpool.org>
+ * Copyright 2014      Lucas Jones <https://github.com/lucasjones>
+ * Copyright 2014-2016 Wolf9466    <https://github.com/OhGodAPet>
+ * Copyright 2016      Jay D Dee   <jayddee246@gmail.com>
+ * Copyright 2016-2017 XMRig       <support@xmrig.com>
+ *
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include <stdlib.h>
+#include <string.h>
+
+
+#include "interfaces/IWriteQueueListener.h"
+#include "net/WriteQueue.h"
+
+
+WriteQueue::WriteQueue(IWriteQueueListener *listener) :
+    m_writing(false),
+    m_listener(listener),
+    m_stats(),
+    m_stream(nullptr)
+{
+    m_req.data = this;
+    m_batch.reserve(kMaxBatch);
+}
+
+
+WriteQueue::~WriteQueue()
+{
+    release(m_batch);
+
+    for (uv_buf_t &buf : m_queue) {
+        free(buf.base);
+    }
+}
+
+
+/**
+ * @brief Write or queue a message, returns false if the connection is stalled or broken.
+ */
+bool WriteQueue::write(uv_stream_t *stream, const char *data, size_t size)
+{
+    if (m_stats.bytes + size > kMaxBytes) {
+        m_stats.overflows++;
+        return false;
+    }
+
+    m_stream = stream;
+
+    if (!m_writing && m_queue.empty()) {
+        uv_buf_t buf = uv_buf_init(const_cast<char *>(data), (unsigned int) size);
+        const int rc = uv_try_write(stream, &buf, 1);
+
+        if (rc == (int) size) {
+            m_stats.direct++;
+            return true;
+        }
+
+        if (rc < 0 && rc != UV_EAGAIN && rc != UV_ENOSYS) {
+            return false;
+        }
+
+        if (rc > 0) {
+            m_stats.partial++;
+            data += rc;
+            size -= rc;
+        }
+    }
+
+    enqueue(data, size);
+
+    return m_writing || flush() == 0;
+}
+
+
+/**
+ * @brief Drop queued messages, must be called after the stream is closed.
+ */
+void WriteQueue::reset()
+{
+    for (uv_buf_t &buf : m_queue) {
+        m_stats.bytes -= buf.len;
+        free(buf.base);
+    }
+
+    m_queue.clear();
+    m_stats.depth = m_batch.size();
+    m_stream      = nullptr;
+}
+
+
+int WriteQueue::flush()
+{
+    while (!m_queue.empty() && m_batch.size() < kMaxBatch) {
+        m_batch.push_back(m_queue.front());
+        m_queue.pop_front();
+    }
+
+    const int rc = uv_write(&m_req, m_stream, m_batch.data(), (unsigned int) m_batch.size(), WriteQueue::onWrite);
+    if (rc < 0) {
+        release(m_batch);
+        return rc;
+    }
+
+    m_writing = true;
+    m_stats.batches++;
+    m_stats.coalesced += m_batch.size();
+
+    return 0;
+}
+
+
+void WriteQueue::enqueue(const char *data, size_t size)
+{
+    uv_buf_t buf = uv_buf_init(static_cast<char *>(malloc(size)), (unsigned int) size);
+    memcpy(buf.base, data, size);
+
+    m_queue.push_back(buf);
+
+    m_stats.bytes += size;
+    m_stats.depth = m_queue.size() + m_batch.size();
+
+    if (m_stats.depth > m_stats.peak) {
+        m_stats.peak = m_stats.depth;
+    }
+}
+
+
+void WriteQueue::release(std::vector<uv_buf_t> &bufs)
+{
+    for (uv_buf_t &buf : bufs) {
+        m_stats.bytes -= buf.len;
+        free(buf.base);
+    }
+
+    bufs.clear();
+    m_stats.depth = m_queue.size();
+}
+
+
+void WriteQueue::onWrite(uv_write_t *req, int status)
+{
+    auto queue = static_cast<WriteQueue*>(req->data);
+
+    queue->m_writing = false;
+    queue->release(queue->m_batch);
+
+    // stream already closed (reset() called or write canceled by uv_close).
+    if (!queue->m_stream || status == UV_ECANCELED) {
+        return;
+    }
+
+    if (status == 0 && !queue->m_queue.empty()) {
+        status = queue->flush();
+    }
+
+    if (status < 0) {
+        queue->m_listener->onWriteFailed(status);
+    }
+}
@@ -0,0 +1,89 @@
+/* XMRig
+ * Copyright 2010      Jeff Garzik <jgarzik@pobox.com>
+ * Copyright 2012-2014 pooler      <pooler@litecoinpool.org>
+ * Copyright 2014      Lucas Jones <https://github.com/lucasjones>
+ * Copyright 2014-2016 Wolf9466    <https://github.com/OhGodAPet>
+ * Copyright 2016      Jay D Dee   <jayddee246@gmail.com>
+ * Copyright 2016-2017 XMRig       <support@xmrig.com>
+ *
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef __WRITEQUEUE_H__
+#define __WRITEQUEUE_H__
+
+
+#include <deque>
+#include <stdint.h>
+#include <uv.h>
+#include <vector>
+
+
+class IWriteQueueListener;
+
+
+/**
+ * Outgoing data for one connection.
+ *
+ * Messages are written directly with uv_try_write while nothing is pending,
+ * the rest (or the unwritten tail of a partial write) is queued and flushed
+ * with a single uv_write per batch. Failure of a batch written later from the
+ * write callback is reported to listener, which must close the stream.
+ */
+class WriteQueue
+{
+public:
+    constexpr static size_t kMaxBatch = 32;
+    constexpr static size_t kMaxBytes = 64 * 1024;
+
+    struct Stats
+    {
+        size_t bytes;
+        size_t depth;
+        size_t peak;
+        uint64_t batches;
+        uint64_t coalesced;
+        uint64_t direct;
+        uint64_t overflows;
+        uint64_t partial;
+    };
+
+    WriteQueue(IWriteQueueListener *listener);
+    ~WriteQueue();
+
+    bool write(uv_stream_t *stream, const char *data, size_t size);
+    void reset();
+
+    inline bool isWriting() const     { return m_writing; }
+    inline const Stats &stats() const { return m_stats; }
+
+private:
+    int flush();
+    void enqueue(const char *data, size_t size);
+    void release(std::vector<uv_buf_t> &bufs);
+
+    static void onWrite(uv_write_t *req, int status);
+
+    bool m_writing;
+    IWriteQueueListener *m_listener;
+    std::deque<uv_buf_t> m_queue;
+    std::vector<uv_buf_t> m_batch;
+    Stats m_stats;
+    uv_stream_t *m_stream;
+    uv_write_t m_req;
+};
+
+
+#endif /* __WRITEQUEUE_H__ */
@@ -0,0 +1,322 @@
+/* XMRig
+ * Copyright 2010      Jeff Garzik <jgarzik@pobox.com>
+ * Copyright 2012-2014 pooler      <pooler@litecoinpool.org>
+ * Copyright 2014      Lucas Jones <https://github.com/lucasjones>
+ * Copyright 2014-2016 Wolf9466    <https://github.com/OhGodAPet>
+ * Copyright 2016      Jay D Dee   <jayddee246@gmail.com>
+ * Copyright 2016-2017 XMRig       <support@xmrig.com>
+ *
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <inttypes.h>
+#include <stdio.h>
+#include <string.h>
+
+
+#include "log/Log.h"
+#include "net/Hex.h"
+#include "net/Job.h"
+#include "net/proxy/Miner.h"
+#include "net/proxy/Proxy.h"
+#include "rapidjson/document.h"
+
+
+Miner::Miner(Proxy *proxy, uint64_t id, uint8_t slot) :
+    m_closing(false),
+    m_logged(false),
+    m_proxy(proxy),
+    m_recvBuf(kMaxRecvSize),
+    m_id(id),
+    m_slot(slot),
+    m_writeQueue(this)
+{
+    memset(m_ip, 0, sizeof(m_ip));
+    snprintf(m_rpcId, sizeof(m_rpcId), "%" PRIu64 "-%u", id, (unsigned) slot);
+
+    uv_tcp_init(uv_default_loop(), &m_socket);
+    m_socket.data = this;
+}
+
+
+Miner::~Miner()
+{
+}
+
+
+bool Miner::accept(uv_stream_t *server)
+{
+    if (uv_accept(server, reinterpret_cast<uv_stream_t*>(&m_socket)) != 0) {
+        return false;
+    }
+
+    sockaddr_storage addr;
+    int size = sizeof(addr);
+
+    if (uv_tcp_getpeername(&m_socket, reinterpret_cast<sockaddr*>(&addr), &size) == 0) {
+        if (addr.ss_family == AF_INET6) {
+            uv_ip6_name(reinterpret_cast<const sockaddr_in6*>(&addr), m_ip, sizeof(m_ip));
+        }
+        else {
+            uv_ip4_name(reinterpret_cast<const sockaddr_in*>(&addr), m_ip, sizeof(m_ip));
+        }
+    }
+
+    uv_tcp_nodelay(&m_socket, 1);
+    uv_read_start(reinterpret_cast<uv_stream_t*>(&m_socket), Miner::onAllocBuffer, Miner::onRead);
+
+    return true;
+}
+
+
+/**
+ * @brief Close connection, object deleted and removed from proxy in close callback.
+ */
+void Miner::close()
+{
+    if (m_closing) {
+        return;
+    }
+
+    m_closing = true;
+    uv_close(reinterpret_cast<uv_handle_t*>(&m_socket), Miner::onClose);
+}
+
+
+void Miner::onWriteFailed(int status)
+{
+    close();
+}
+
+
+void Miner::reply(int64_t rpcId, const char *error)
+{
+    if (error) {
+        // upstream messages are forwarded as is, escape them for JSON.
+        char message[256];
+        size_t size = 0;
+
+        for (const char *p = error; *p && size < sizeof(message) - 2; ++p) {
+            if (*p == '"' || *p == '\\') {
+                message[size++] = '\\';
+            }
+
+            message[size++] = (unsigned char) *p < 0x20 ? ' ' : *p;
+        }
+
+        message[size] = '\0';
+
+        send(snprintf(m_sendBuf, sizeof(m_sendBuf), "{\"id\":%" PRId64 ",\"jsonrpc\":\"2.0\",\"error\":{\"code\":-1,\"message\":\"%s\"}}\n", rpcId, message));
+        return;
+    }
+
+    send(snprintf(m_sendBuf, sizeof(m_sendBuf), "{\"id\":%" PRId64 ",\"jsonrpc\":\"2.0\",\"error\":null,\"result\":{\"status\":\"OK\"}}\n", rpcId));
+}
+
+
+void Miner::setJob(const Job &job)
+{
+    if (!m_logged) {
+        return;
+    }
+
+    size_t size = (size_t) snprintf(m_sendBuf, sizeof(m_sendBuf), "{\"jsonrpc\":\"2.0\",\"method\":\"job\",\"params\":");
+    size += writeJob(m_sendBuf + size, sizeof(m_sendBuf) - size, job);
+    size += (size_t) snprintf(m_sendBuf + size, sizeof(m_sendBuf) - size, "}\n");
+
+    send(size);
+}
+
+
+bool Miner::send(size_t size)
+{
+    if (m_closing || size >= sizeof(m_sendBuf)) {
+        return false;
+    }
+
+    if (!m_writeQueue.write(reinterpret_cast<uv_stream_t*>(&m_socket), m_sendBuf, size)) {
+        close();
+        return false;
+    }
+
+    return true;
+}
+
+
+/**
+ * @brief Job object for this miner, upper nonce byte of the blob set to miner slot.
+ */
+size_t Miner::writeJob(char *buf, size_t size, const Job &job) const
+{
+    uint8_t blob[84];
+    memcpy(blob, job.blob(), job.size());
+    blob[42] = m_slot;
+
+    char blobHex[169];
+    Hex::encode(blob, job.size(), blobHex);
+    blobHex[job.size() * 2] = '\0';
+
+    // compact 32 bit target if it is precise enough, full 64 bit target otherwise.
+    char target[17];
+    const uint64_t full    = job.target();
+    const uint32_t compact = static_cast<uint32_t>(full >> 32);
+
+    if (compact > 0xFFFF) {
+        Hex::encode(reinterpret_cast<const uint8_t*>(&compact), sizeof(compact), target);
+        target[8] = '\0';
+    }
+    else {
+        Hex::encode(reinterpret_cast<const uint8_t*>(&full), sizeof(full), target);
+        target[16] = '\0';
+    }
+
+    return (size_t) snprintf(buf, size, "{\"blob\":\"%s\",\"job_id\":\"%s\",\"target\":\"%s\",\"id\":\"%s\"}", blobHex, job.id().data(), target, m_rpcId);
+}
+
+
+void Miner::login(int64_t rpcId)
+{
+    const Job &job = m_proxy->job();
+    if (!job.isValid()) {
+        reply(rpcId, "No job available, try again later");
+        return;
+    }
+
+    m_logged = true;
+
+    size_t size = (size_t) snprintf(m_sendBuf, sizeof(m_sendBuf), "{\"id\":%" PRId64 ",\"jsonrpc\":\"2.0\",\"error\":null,\"result\":{\"id\":\"%s\",\"job\":", rpcId, m_rpcId);
+    size += writeJob(m_sendBuf + size, sizeof(m_sendBuf) - size, job);
+    size += (size_t) snprintf(m_sendBuf + size, sizeof(m_sendBuf) - size, ",\"status\":\"OK\"}}\n");
+
+    send(size);
+}
+
+
+void Miner::parse(char *line, size_t len)
+{
+    line[len - 1] = '\0';
+
+    rapidjson::Document doc;
+    if (doc.ParseInsitu(line).HasParseError() || !doc.IsObject()) {
+        LOG_ERR("[proxy %s] JSON decode failed", m_ip);
+        return close();
+    }
+
+    const rapidjson::Value &id     = doc["id"];
+    const rapidjson::Value &method = doc["method"];
+
+    if (!id.IsInt64() || !method.IsString()) {
+        return;
+    }
+
+    if (strcmp(method.GetString(), "login") == 0) {
+        return login(id.GetInt64());
+    }
+
+    if (!m_logged) {
+        return reply(id.GetInt64(), "Unauthenticated");
+    }
+
+    const rapidjson::Value &params = doc["params"];
+
+    if (strcmp(method.GetString(), "submit") == 0 && params.IsObject()) {
+        const rapidjson::Value &jobId  = params["job_id"];
+        const rapidjson::Value &nonce  = params["nonce"];
+        const rapidjson::Value &result = params["result"];
+
+        if (!jobId.IsString() || !nonce.IsString() || !result.IsString()) {
+            return reply(id.GetInt64(), "Malformed share");
+        }
+
+        return submit(id.GetInt64(), jobId.GetString(), nonce.GetString(), result.GetString());
+    }
+
+    if (strcmp(method.GetString(), "keepalived") == 0) {
+        send(snprintf(m_sendBuf, sizeof(m_sendBuf), "{\"id\":%" PRId64 ",\"jsonrpc\":\"2.0\",\"error\":null,\"result\":{\"status\":\"KEEPALIVED\"}}\n", id.GetInt64()));
+        return;
+    }
+
+    reply(id.GetInt64(), "Unsupported method");
+}
+
+
+void Miner::submit(int64_t rpcId, const char *jobId, const char *nonce, const char *result)
+{
+    uint32_t value = 0;
+    uint8_t hash[32];
+
+    if (strlen(nonce) != 8 || strlen(result) != 64 ||
+        !Hex::decode(nonce, 8, reinterpret_cast<uint8_t*>(&value)) || !Hex::decode(result, 64, hash)) {
+        return reply(rpcId, "Malformed share");
+    }
+
+    if ((value >> 24) != m_slot) {
+        return reply(rpcId, "Invalid nonce");
+    }
+
+    const JobId id(jobId);
+    const int64_t seq = m_proxy->submit(this, rpcId, id, value, hash);
+
+    if (seq == -3) {
+        return reply(rpcId, "Low difficulty share");
+    }
+
+    if (seq == -2) {
+        return reply(rpcId, "Invalid job id");
+    }
+
+    if (seq == -1) {
+        return reply(rpcId, "Pool unavailable");
+    }
+}
+
+
+void Miner::onAllocBuffer(uv_handle_t *handle, size_t suggested_size, uv_buf_t *buf)
+{
+    auto miner = getMiner(handle->data);
+
+    size_t size = 0;
+    buf->base = miner->m_recvBuf.reserve(size);
+    buf->len  = size;
+}
+
+
+void Miner::onClose(uv_handle_t *handle)
+{
+    auto miner = getMiner(handle->data);
+
+    miner->m_writeQueue.reset();
+    miner->m_proxy->remove(miner);
+
+    delete miner;
+}
+
+
+void Miner::onRead(uv_stream_t *stream, ssize_t nread, const uv_buf_t *buf)
+{
+    auto miner = getMiner(stream->data);
+    if (nread < 0) {
+        return miner->close();
+    }
+
+    miner->m_recvBuf.commit((size_t) nread);
+
+    char *line;
+    size_t len;
+
+    while (!miner->m_closing && (line = miner->m_recvBuf.next(len)) != nullptr) {
+        miner->parse(line, len);
+    }
+}
@@ -0,0 +1,92 @@
+/* XMRig
+ * Copyright 2010      Jeff Garzik <jgarzik@pobox.com>
+ * Copyright 2012-2014 pooler      <pooler@litecoinpool.org>
+ * Copyright 2014      Lucas Jones <https://github.com/lucasjones>
+ * Copyright 2014-2016 Wolf9466    <https://github.com/OhGodAPet>
+ * Copyright 2016      Jay D Dee   <jayddee246@gmail.com>
+ * Copyright 2016-2017 XMRig       <support@xmrig.com>
+ *
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef __MINER_H__
+#define __MINER_H__
+
+
+#include <stdint.h>
+#include <uv.h>
+
+
+#include "interfaces/IWriteQueueListener.h"
+#include "net/RecvBuffer.h"
+#include "net/WriteQueue.h"
+
+
+class Job;
+class Proxy;
+
+
+/**
+ * Connection from a rig to local proxy, handles login, submit and keepalived requests.
+ */
+class Miner : public IWriteQueueListener
+{
+public:
+    constexpr static size_t kMaxRecvSize = 16 * 1024;
+
+    Miner(Proxy *proxy, uint64_t id, uint8_t slot);
+
+    bool accept(uv_stream_t *server);
+    void close();
+    void reply(int64_t rpcId, const char *error);
+    void setJob(const Job &job);
+
+    inline const char *ip() const { return m_ip; }
+    inline uint64_t id() const    { return m_id; }
+    inline uint8_t slot() const   { return m_slot; }
+
+protected:
+    void onWriteFailed(int status) override;
+
+private:
+    ~Miner();
+
+    bool send(size_t size);
+    size_t writeJob(char *buf, size_t size, const Job &job) const;
+    void login(int64_t rpcId);
+    void parse(char *line, size_t len);
+    void submit(int64_t rpcId, const char *jobId, const char *nonce, const char *result);
+
+    static void onAllocBuffer(uv_handle_t *handle, size_t suggested_size, uv_buf_t *buf);
+    static void onClose(uv_handle_t *handle);
+    static void onRead(uv_stream_t *stream, ssize_t nread, const uv_buf_t *buf);
+
+    static inline Miner *getMiner(void *data) { return static_cast<Miner*>(data); }
+
+    bool m_closing;
+    bool m_logged;
+    char m_ip[46];
+    char m_rpcId[24];
+    char m_sendBuf[768];
+    Proxy *m_proxy;
+    RecvBuffer m_recvBuf;
+    uint64_t m_id;
+    uint8_t m_slot;
+    uv_tcp_t m_socket;
+    WriteQueue m_writeQueue;
+};
+
+
+#endif /* __MINER_H__ */
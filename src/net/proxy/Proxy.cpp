@@ -0,0 +1,226 @@
+/* XMRig
+ * Copyright 2010      Jeff Garzik <jgarzik@pobox.com>
+ * Copyright 2012-2014 pooler      <pooler@litecoinpool.org>
+ * Copyright 2014      Lucas Jones <https://github.com/lucasjones>
+ * Copyright 2014-2016 Wolf9466    <https://github.com/OhGodAPet>
+ * Copyright 2016      Jay D Dee   <jayddee246@gmail.com>
+ * Copyright 2016-2017 XMRig       <support@xmrig.com>
+ *
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <string.h>
+
+
+#include "interfaces/IProxyListener.h"
+#include "log/Log.h"
+#include "net/JobResult.h"
+#include "net/proxy/Miner.h"
+#include "net/proxy/Proxy.h"
+
+
+Proxy::Proxy(IProxyListener *listener) :
+    m_listening(false),
+    m_warned(false),
+    m_listener(listener),
+    m_count(0),
+    m_sequence(0)
+{
+    memset(m_miners, 0, sizeof(m_miners));
+}
+
+
+Proxy::~Proxy()
+{
+}
+
+
+/**
+ * @brief Forward upstream response to miner, returns false if share was not submitted by proxy.
+ */
+bool Proxy::onResult(int64_t seq, const char *error)
+{
+    auto it = m_pending.find(seq);
+    if (it == m_pending.end()) {
+        return false;
+    }
+
+    const Pending pending = it->second;
+    m_pending.erase(it);
+
+    Miner *miner = m_miners[pending.slot];
+    if (miner && miner->id() == pending.miner) {
+        miner->reply(pending.rpcId, error);
+    }
+
+    return true;
+}
+
+
+bool Proxy::start(int port)
+{
+    sockaddr_in6 addr;
+    uv_ip6_addr("::", port, &addr);
+
+    uv_tcp_init(uv_default_loop(), &m_server);
+    m_server.data = this;
+
+    int rc = uv_tcp_bind(&m_server, reinterpret_cast<const sockaddr*>(&addr), 0);
+    if (rc == 0) {
+        rc = uv_listen(reinterpret_cast<uv_stream_t*>(&m_server), 128, Proxy::onConnection);
+    }
+
+    if (rc != 0) {
+        LOG_ERR("proxy failed to listen on port %d: \"%s\"", port, uv_strerror(rc));
+        uv_close(reinterpret_cast<uv_handle_t*>(&m_server), nullptr);
+        return false;
+    }
+
+    m_listening = true;
+    LOG_INFO("proxy listening on port %d, up to %d miners", port, kMaxMiners);
+    return true;
+}
+
+
+/**
+ * @brief Submit share from miner to upstream pool.
+ *
+ * Returns -3 if share does not meet job target, -2 if job is unknown, -1 if pool is not available,
+ * otherwise upstream request sequence.
+ */
+int64_t Proxy::submit(Miner *miner, int64_t rpcId, const JobId &jobId, uint32_t nonce, const uint8_t *result)
+{
+    const Job *job = nullptr;
+    if (m_job.isValid() && m_job.id() == jobId) {
+        job = &m_job;
+    }
+    else if (m_prevJob.isValid() && m_prevJob.id() == jobId) {
+        job = &m_prevJob;
+    }
+
+    if (!job) {
+        return -2;
+    }
+
+    const uint64_t value = *reinterpret_cast<const uint64_t*>(result + 24);
+    if (value == 0 || value >= job->target()) {
+        return -3;
+    }
+
+    const int64_t seq = m_listener->onProxySubmit(JobResult(job->poolId(), jobId, nonce, result, job->diff()));
+    if (seq < 0) {
+        return -1;
+    }
+
+    // pool never answered oldest shares, connection was probably lost.
+    if (m_pending.size() >= kPending) {
+        m_pending.erase(m_pending.begin());
+    }
+
+    Pending &pending = m_pending[seq];
+    pending.rpcId = rpcId;
+    pending.miner = miner->id();
+    pending.slot  = miner->slot();
+
+    return seq;
+}
+
+
+void Proxy::remove(Miner *miner)
+{
+    if (m_miners[miner->slot()] != miner) {
+        return;
+    }
+
+    m_miners[miner->slot()] = nullptr;
+    m_count--;
+
+    LOG_INFO("proxy miner %s disconnected, %d active", miner->ip(), m_count);
+}
+
+
+/**
+ * @brief New upstream job, nonce space can be split only if pool does not split it already.
+ */
+void Proxy::setJob(const Job &job)
+{
+    if (job.isNicehash()) {
+        if (!m_warned) {
+            LOG_ERR("proxy: upstream pool uses nicehash nonce, jobs are not forwarded to miners");
+            m_warned = true;
+        }
+
+        return;
+    }
+
+    m_prevJob = m_job;
+    m_job     = job;
+
+    for (Miner *miner : m_miners) {
+        if (miner) {
+            miner->setJob(m_job);
+        }
+    }
+}
+
+
+void Proxy::stop()
+{
+    for (Miner *miner : m_miners) {
+        if (miner) {
+            miner->close();
+        }
+    }
+
+    if (m_listening) {
+        m_listening = false;
+        uv_close(reinterpret_cast<uv_handle_t*>(&m_server), nullptr);
+    }
+}
+
+
+void Proxy::onConnection(uv_stream_t *server, int status)
+{
+    auto proxy = static_cast<Proxy*>(server->data);
+    if (status < 0) {
+        LOG_ERR("proxy accept error: \"%s\"", uv_strerror(status));
+        return;
+    }
+
+    int slot = 0;
+    for (int i = 1; i <= kMaxMiners; ++i) {
+        if (!proxy->m_miners[i]) {
+            slot = i;
+            break;
+        }
+    }
+
+    Miner *miner = new Miner(proxy, ++proxy->m_sequence, (uint8_t) slot);
+    if (!miner->accept(server)) {
+        miner->close();
+        return;
+    }
+
+    if (slot == 0) {
+        LOG_WARN("proxy is full, miner %s rejected", miner->ip());
+        miner->close();
+        return;
+    }
+
+    proxy->m_miners[slot] = miner;
+    proxy->m_count++;
+
+    LOG_INFO("proxy miner %s connected, %d active", miner->ip(), proxy->m_count);
+}
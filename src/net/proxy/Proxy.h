@@ -0,0 +1,88 @@
+/* XMRig
+ * Copyright 2010      Jeff Garzik <jgarzik@pobox.com>
+ * Copyright 2012-2014 pooler      <pooler@litecoinpool.org>
+ * Copyright 2014      Lucas Jones <https://github.com/lucasjones>
+ * Copyright 2014-2016 Wolf9466    <https://github.com/OhGodAPet>
+ * Copyright 2016      Jay D Dee   <jayddee246@gmail.com>
+ * Copyright 2016-2017 XMRig       <support@xmrig.com>
+ *
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef __PROXY_H__
+#define __PROXY_H__
+
+
+#include <map>
+#include <stdint.h>
+#include <uv.h>
+
+
+#include "net/Job.h"
+
+
+class IProxyListener;
+class Miner;
+
+
+/**
+ * Local stratum server, multiplexes miners over upstream pool connection.
+ *
+ * Each miner owns one value of the upper nonce byte (NiceHash style), value 0 is
+ * reserved for local worker threads, so up to kMaxMiners rigs share one upstream job.
+ */
+class Proxy
+{
+public:
+    constexpr static int kMaxMiners  = 255;
+    constexpr static size_t kPending = 4096;
+
+    Proxy(IProxyListener *listener);
+    ~Proxy();
+
+    bool onResult(int64_t seq, const char *error);
+    bool start(int port);
+    int64_t submit(Miner *miner, int64_t rpcId, const JobId &jobId, uint32_t nonce, const uint8_t *result);
+    void remove(Miner *miner);
+    void setJob(const Job &job);
+    void stop();
+
+    inline const Job &job() const { return m_job; }
+    inline int miners() const     { return m_count; }
+
+private:
+    struct Pending
+    {
+        int64_t rpcId;
+        uint64_t miner;
+        uint8_t slot;
+    };
+
+    static void onConnection(uv_stream_t *server, int status);
+
+    bool m_listening;
+    bool m_warned;
+    IProxyListener *m_listener;
+    int m_count;
+    Job m_job;
+    Job m_prevJob;
+    Miner *m_miners[kMaxMiners + 1];
+    std::map<int64_t, Pending> m_pending;
+    uint64_t m_sequence;
+    uv_tcp_t m_server;
+};
+
+
+#endif /* __PROXY_H__ */
@@ -0,0 +1,206 @@
+/* XMRig
+ * Copyright 2010      Jeff Garzik <jgarzik@pobox.com>
+ * Copyright 2012-2014 pooler      <pooler@litecoinpool.org>
+ * Copyright 2014      Lucas Jones <https://github.com/lucasjones>
+ * Copyright 2014-2016 Wolf9466    <https://github.com/OhGodAPet>
+ * Copyright 2016      Jay D Dee   <jayddee246@gmail.com>
+ * Copyright 2016-2017 XMRig       <support@xmrig.com>
+ *
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include "interfaces/IStrategyListener.h"
+#include "log/Log.h"
+#include "net/Client.h"
+#include "net/strategies/AdaptiveStrategy.h"
+#include "net/SubmitResult.h"
+#include "Options.h"
+
+
+AdaptiveStrategy::AdaptiveStrategy(const std::vector<Url*> &urls, const char *agent, IStrategyListener *listener) :
+    m_active(-1),
+    m_listener(listener),
+    m_selector(urls.size())
+{
+    for (const Url *url : urls) {
+        add(url, agent);
+    }
+}
+
+
+/**
+ * @brief Switch to given pool now if it is logged in.
+ */
+bool AdaptiveStrategy::setPool(int index)
+{
+    if (index < 0 || index >= (int) m_pools.size() || !m_pools[index]->isReady()) {
+        return false;
+    }
+
+    if (index != m_active) {
+        activate(index, uv_now(uv_default_loop()));
+    }
+
+    return true;
+}
+
+
+int64_t AdaptiveStrategy::submit(const JobResult &result)
+{
+    if (m_active == -1) {
+        return -1;
+    }
+
+    return m_pools[m_active]->submit(result);
+}
+
+
+void AdaptiveStrategy::connect()
+{
+    for (Client *client : m_pools) {
+        client->connect();
+    }
+}
+
+
+void AdaptiveStrategy::resume()
+{
+    if (!isActive()) {
+        return;
+    }
+
+    m_listener->onJob(m_pools[m_active], m_pools[m_active]->job());
+}
+
+
+void AdaptiveStrategy::stop()
+{
+    for (Client *client : m_pools) {
+        client->disconnect();
+    }
+
+    m_active = -1;
+
+    m_listener->onPause(this);
+}
+
+
+void AdaptiveStrategy::tick(uint64_t now)
+{
+    for (Client *client : m_pools) {
+        client->tick(now);
+    }
+
+    select(now);
+}
+
+
+void AdaptiveStrategy::onClose(Client *client, int failures)
+{
+    if (failures == -1) {
+        return;
+    }
+
+    m_listener->onClose(client, failures);
+
+    if (m_active != client->id()) {
+        return;
+    }
+
+    m_active = -1;
+    select(uv_now(uv_default_loop()));
+
+    if (!isActive()) {
+        m_listener->onPause(this);
+    }
+}
+
+
+void AdaptiveStrategy::onJobReceived(Client *client, const Job &job)
+{
+    const uint64_t now = uv_now(uv_default_loop());
+    m_selector.onJob(client->id(), job.blob(), job.size(), now);
+
+    if (!isActive()) {
+        return select(now);
+    }
+
+    if (m_active == client->id()) {
+        m_listener->onJob(client, job);
+    }
+}
+
+
+void AdaptiveStrategy::onLoginSuccess(Client *client)
+{
+    m_selector.onLogin(client->id(), client->latency());
+}
+
+
+void AdaptiveStrategy::onResultAccepted(Client *client, const SubmitResult &result, const char *error)
+{
+    m_selector.onResult(client->id(), result.elapsed, error != nullptr);
+    m_listener->onResultAccepted(client, result, error);
+}
+
+
+void AdaptiveStrategy::activate(int index, uint64_t now)
+{
+    Client *client = m_pools[index];
+
+    if (m_active >= 0) {
+        const PoolSelector::Metrics &from = m_selector.metrics(m_active);
+        const PoolSelector::Metrics &to   = m_selector.metrics(index);
+
+        LOG_NOTICE("switch pool %s:%d -> %s:%d, cost %.0f -> %.0f ms (latency %.0f, lag %.0f, rejects %.2f%%)",
+                   m_pools[m_active]->host(), m_pools[m_active]->port(), client->host(), client->port(),
+                   from.cost(), to.cost(), to.latency, to.lag, to.rejects * 100.0);
+    }
+
+    m_active = index;
+    m_selector.onSwitch(now);
+
+    m_listener->onActive(client);
+    m_listener->onJob(client, client->job());
+}
+
+
+void AdaptiveStrategy::add(const Url *url, const char *agent)
+{
+    Client *client = new Client((int) m_pools.size(), agent, this);
+    client->setUrl(url);
+    client->setRetryPause(Options::i()->retryPause() * 1000);
+    client->setMaxRecvSize((size_t) Options::i()->recvBuffer() * 1024);
+
+    m_pools.push_back(client);
+}
+
+
+/**
+ * @brief Pick pool by cost, a pool counts as ready when logged in and has a job.
+ */
+void AdaptiveStrategy::select(uint64_t now)
+{
+    std::vector<bool> ready(m_pools.size());
+    for (size_t i = 0; i < m_pools.size(); ++i) {
+        ready[i] = m_pools[i]->isReady() && m_pools[i]->job().isValid();
+    }
+
+    const int index = m_selector.select(m_active, ready, now);
+    if (index >= 0 && index != m_active) {
+        activate(index, now);
+    }
+}
@@ -53,6 +53,7 @@ DonateStrategy::DonateStrategy(const char *agent, IStrategyListener *listener) :
     m_client = new Client(-1, agent, this);
     m_client->setUrl(url);
     m_client->setRetryPause(Options::i()->retryPause() * 1000);
+    m_client->setMaxRecvSize((size_t) Options::i()->recvBuffer() * 1024);
     m_client->setQuiet(true);
 
     delete url;
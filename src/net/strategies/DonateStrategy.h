@@ -44,6 +44,7 @@ public:
 
 public:
     inline bool isActive() const override  { return m_active; }
+    inline bool setPool(int) override      { return false; }
     inline void resume() override          {}
 
     int64_t submit(const JobResult &result) override;
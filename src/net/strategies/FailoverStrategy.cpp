@@ -31,6 +31,8 @@
 FailoverStrategy::FailoverStrategy(const std::vector<Url*> &urls, const char *agent, IStrategyListener *listener) :
     m_active(-1),
     m_index(0),
+    m_primary(0),
+    m_standby(Options::i()->standby()),
     m_listener(listener)
 {
     for (const Url *url : urls) {
@@ -39,8 +41,51 @@ FailoverStrategy::FailoverStrategy(const std::vector<Url*> &urls, const char *ag
 }
 
 
+/**
+ * @brief Make pool with given index primary, current pool keeps mining until new one logged in.
+ */
+bool FailoverStrategy::setPool(int index)
+{
+    if (index < 0 || index >= (int) m_pools.size()) {
+        return false;
+    }
+
+    const int previous = m_primary;
+    m_primary = index;
+
+    if (m_index == index && m_standby == 0) {
+        return true;
+    }
+
+    for (size_t i = 0; i < m_pools.size(); ++i) {
+        const int id = static_cast<int>(i);
+        if (id == m_active) {
+            continue;
+        }
+
+        if (id != index && !isStandby(id)) {
+            m_pools[i]->disconnect();
+            continue;
+        }
+
+        const bool connected = id == previous || id == m_index || (id > previous && id <= previous + m_standby);
+        if (!connected) {
+            m_pools[i]->connect();
+        }
+    }
+
+    m_index = index;
+
+    return true;
+}
+
+
 int64_t FailoverStrategy::submit(const JobResult &result)
 {
+    if (m_active == -1) {
+        return -1;
+    }
+
     return m_pools[m_active]->submit(result);
 }
 
@@ -48,6 +93,12 @@ int64_t FailoverStrategy::submit(const JobResult &result)
 void FailoverStrategy::connect()
 {
     m_pools[m_index]->connect();
+
+    for (size_t i = 0; i < m_pools.size(); ++i) {
+        if ((int) i != m_index && isStandby((int) i)) {
+            m_pools[i]->connect();
+        }
+    }
 }
 
 
@@ -67,7 +118,7 @@ void FailoverStrategy::stop()
         m_pools[i]->disconnect();
     }
 
-    m_index  = 0;
+    m_index  = m_primary;
     m_active = -1;
 
     m_listener->onPause(this);
@@ -88,17 +139,24 @@ void FailoverStrategy::onClose(Client *client, int failures)
         return;
     }
 
+    m_listener->onClose(client, failures);
+
     if (m_active == client->id()) {
         m_active = -1;
-        m_listener->onPause(this);
+
+        if (!failover()) {
+            m_listener->onPause(this);
+        }
     }
 
-    if (m_index == 0 && failures < Options::i()->retries()) {
+    if (m_index == m_primary && failures < Options::i()->retries()) {
         return;
     }
 
     if (m_index == client->id() && (m_pools.size() - m_index) > 1) {
-        m_pools[++m_index]->connect();
+        if (!isStandby(++m_index)) {
+            m_pools[m_index]->connect();
+        }
     }
 }
 
@@ -115,12 +173,12 @@ void FailoverStrategy::onLoginSuccess(Client *client)
 {
     int active = m_active;
 
-    if (client->id() == 0 || !isActive()) {
+    if (client->id() == m_primary || !isActive()) {
         active = client->id();
     }
 
-    for (size_t i = 1; i < m_pools.size(); ++i) {
-        if (active != static_cast<int>(i)) {
+    for (size_t i = 0; i < m_pools.size(); ++i) {
+        if (active != static_cast<int>(i) && m_primary != static_cast<int>(i) && !isStandby(static_cast<int>(i))) {
             m_pools[i]->disconnect();
         }
     }
@@ -138,11 +196,35 @@ void FailoverStrategy::onResultAccepted(Client *client, const SubmitResult &resu
 }
 
 
+/**
+ * @brief Switch to the first logged in standby pool, its last job is used immediately.
+ */
+bool FailoverStrategy::failover()
+{
+    for (size_t i = 0; i < m_pools.size(); ++i) {
+        Client *client = m_pools[i];
+
+        if (!isStandby((int) i) || !client->isReady() || !client->job().isValid()) {
+            continue;
+        }
+
+        m_index = m_active = (int) i;
+        m_listener->onActive(client);
+        m_listener->onJob(client, client->job());
+
+        return true;
+    }
+
+    return false;
+}
+
+
 void FailoverStrategy::add(const Url *url, const char *agent)
 {
     Client *client = new Client((int) m_pools.size(), agent, this);
     client->setUrl(url);
     client->setRetryPause(Options::i()->retryPause() * 1000);
+    client->setMaxRecvSize((size_t) Options::i()->recvBuffer() * 1024);
 
     m_pools.push_back(client);
 }
@@ -45,6 +45,7 @@ public:
 public:
     inline bool isActive() const override  { return m_active >= 0; }
 
+    bool setPool(int index) override;
     int64_t submit(const JobResult &result) override;
     void connect() override;
     void resume() override;
@@ -58,10 +59,15 @@ protected:
     void onResultAccepted(Client *client, const SubmitResult &result, const char *error) override;
 
 private:
+    inline bool isStandby(int index) const { return index > m_primary && index <= m_primary + m_standby; }
+
+    bool failover();
     void add(const Url *url, const char *agent);
 
     int m_active;
     int m_index;
+    int m_primary;
+    int m_standby;
     IStrategyListener *m_listener;
     std::vector<Client*> m_pools;
 };
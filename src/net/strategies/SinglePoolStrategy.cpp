@@ -35,6 +35,7 @@ SinglePoolStrategy::SinglePoolStrategy(const Url *url, const char *agent, IStrat
     m_client = new Client(0, agent, this);
     m_client->setUrl(url);
     m_client->setRetryPause(Options::i()->retryPause() * 1000);
+    m_client->setMaxRecvSize((size_t) Options::i()->recvBuffer() * 1024);
 }
 
 
@@ -74,6 +75,8 @@ void SinglePoolStrategy::tick(uint64_t now)
 
 void SinglePoolStrategy::onClose(Client *client, int failures)
 {
+    m_listener->onClose(client, failures);
+
     if (!isActive()) {
         return;
     }
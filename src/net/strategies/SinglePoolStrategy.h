@@ -40,7 +40,8 @@ public:
     SinglePoolStrategy(const Url *url, const char *agent, IStrategyListener *listener);
 
 public:
-    inline bool isActive() const override  { return m_active; }
+    inline bool isActive() const override      { return m_active; }
+    inline bool setPool(int index) override    { return index == 0; }
 
     int64_t submit(const JobResult &result) override;
     void connect() override;
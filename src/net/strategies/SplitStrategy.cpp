@@ -0,0 +1,196 @@
+/* XMRig
+ * Copyright 2010      Jeff Garzik <jgarzik@pobox.com>
+ * Copyright 2012-2014 pooler      <pooler@litecoinpool.org>
+ * Copyright 2014      Lucas Jones <https://github.com/lucasjones>
+ * Copyright 2014-2016 Wolf9466    <https://github.com/OhGodAPet>
+ * Copyright 2016      Jay D Dee   <jayddee246@gmail.com>
+ * Copyright 2016-2017 XMRig       <support@xmrig.com>
+ *
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include "interfaces/IStrategyListener.h"
+#include "net/Client.h"
+#include "net/JobResult.h"
+#include "net/strategies/SplitStrategy.h"
+#include "net/Url.h"
+#include "Options.h"
+
+
+SplitStrategy::SplitStrategy(const std::vector<Url*> &urls, const char *agent, IStrategyListener *listener) :
+    m_active(0),
+    m_listener(listener),
+    m_current(urls.size(), 0)
+{
+    for (const Url *url : urls) {
+        add(url, agent);
+    }
+}
+
+
+/**
+ * @brief Manual pool selection is not supported, all pools are in use.
+ */
+bool SplitStrategy::setPool(int index)
+{
+    return false;
+}
+
+
+int64_t SplitStrategy::submit(const JobResult &result)
+{
+    if (result.poolId < 0 || result.poolId >= (int) m_pools.size() || !m_pools[result.poolId]->isReady()) {
+        return -1;
+    }
+
+    return m_pools[result.poolId]->submit(result);
+}
+
+
+void SplitStrategy::connect()
+{
+    m_listener->onWeights(m_current);
+
+    for (Client *client : m_pools) {
+        client->connect();
+    }
+}
+
+
+void SplitStrategy::resume()
+{
+    for (size_t i = 0; i < m_pools.size(); ++i) {
+        if (m_current[i] > 0) {
+            m_listener->onJob(m_pools[i], m_pools[i]->job());
+        }
+    }
+}
+
+
+void SplitStrategy::stop()
+{
+    for (Client *client : m_pools) {
+        client->disconnect();
+    }
+
+    m_active = 0;
+    m_current.assign(m_pools.size(), 0);
+
+    m_listener->onPause(this);
+}
+
+
+void SplitStrategy::tick(uint64_t now)
+{
+    for (Client *client : m_pools) {
+        client->tick(now);
+    }
+}
+
+
+void SplitStrategy::onClose(Client *client, int failures)
+{
+    if (failures == -1) {
+        return;
+    }
+
+    m_listener->onClose(client, failures);
+
+    if (m_current[client->id()] == 0) {
+        return;
+    }
+
+    update();
+
+    if (!isActive()) {
+        m_listener->onPause(this);
+    }
+}
+
+
+void SplitStrategy::onJobReceived(Client *client, const Job &job)
+{
+    m_listener->onJob(client, job);
+
+    if (m_current[client->id()] == 0) {
+        update();
+    }
+}
+
+
+void SplitStrategy::onLoginSuccess(Client *client)
+{
+}
+
+
+void SplitStrategy::onResultAccepted(Client *client, const SubmitResult &result, const char *error)
+{
+    m_listener->onResultAccepted(client, result, error);
+}
+
+
+void SplitStrategy::add(const Url *url, const char *agent)
+{
+    Client *client = new Client((int) m_pools.size(), agent, this);
+    client->setUrl(url);
+    client->setRetryPause(Options::i()->retryPause() * 1000);
+    client->setMaxRecvSize((size_t) Options::i()->recvBuffer() * 1024);
+
+    m_pools.push_back(client);
+    m_weights.push_back(url->weight());
+}
+
+
+/**
+ * @brief Recalculate weights of pools in use, a pool is used when logged in and has a job.
+ */
+void SplitStrategy::update()
+{
+    std::vector<int> weights(m_pools.size(), 0);
+    bool weighted = false;
+
+    for (size_t i = 0; i < m_pools.size(); ++i) {
+        if (m_pools[i]->isReady() && m_pools[i]->job().isValid() && m_weights[i] > 0) {
+            weights[i] = m_weights[i];
+            weighted   = true;
+        }
+    }
+
+    // only backup pools left, mine on all of them equally.
+    if (!weighted) {
+        for (size_t i = 0; i < m_pools.size(); ++i) {
+            if (m_pools[i]->isReady() && m_pools[i]->job().isValid()) {
+                weights[i] = 1;
+            }
+        }
+    }
+
+    if (weights == m_current) {
+        return;
+    }
+
+    m_active = 0;
+    for (size_t i = 0; i < m_pools.size(); ++i) {
+        if (weights[i] > 0 && m_current[i] == 0) {
+            m_listener->onActive(m_pools[i]);
+        }
+
+        m_active += weights[i] > 0 ? 1 : 0;
+    }
+
+    m_current = weights;
+    m_listener->onWeights(m_current);
+}
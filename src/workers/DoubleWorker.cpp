@@ -62,21 +62,22 @@ DoubleWorker::~DoubleWorker()
 
 void DoubleWorker::start()
 {
-    while (Workers::sequence() > 0) {
-        if (Workers::isPaused()) {
-            do {
-                std::this_thread::sleep_for(std::chrono::milliseconds(200));
-            }
-            while (Workers::isPaused());
+    if (!m_ctx) {
+        return;
+    }
 
-            if (Workers::sequence() == 0) {
+    while (Workers::isRunning(m_id)) {
+        if (Workers::isPaused(m_id)) {
+            Workers::wait(m_id);
+
+            if (!Workers::isRunning(m_id)) {
                 break;
             }
 
             consumeJob();
         }
 
-        while (!Workers::isOutdated(m_sequence)) {
+        while (!Workers::isOutdated(m_sequence) && !Workers::isPaused(m_id)) {
             if ((m_count & 0xF) == 0) {
                 storeStats();
             }
@@ -100,6 +101,8 @@ void DoubleWorker::start()
 
         consumeJob();
     }
+
+    Workers::save(m_id, m_state->job, m_state->nonce1, m_state->nonce2);
 }
 
 
@@ -116,7 +119,7 @@ bool DoubleWorker::resume(const Job &job)
 
 void DoubleWorker::consumeJob()
 {
-    Job job = Workers::job();
+    Job job = Workers::job(m_id);
     m_sequence = Workers::sequence();
     if (m_state->job == job) {
         return;
@@ -140,6 +143,8 @@ void DoubleWorker::consumeJob()
         m_state->nonce1 = 0xffffffffU / (m_threads * 2) * m_id;
         m_state->nonce2 = 0xffffffffU / (m_threads * 2) * (m_id + m_threads);
     }
+
+    Workers::restore(m_id, m_state->job, &m_state->nonce1, &m_state->nonce2);
 }
 
 
@@ -0,0 +1,235 @@
+/* XMRig
+ * Copyright 2010      Jeff Garzik <jgarzik@pobox.com>
+ * Copyright 2012-2014 pooler      <pooler@litecoinpool.org>
+ * Copyright 2014      Lucas Jones <https://github.com/lucasjones>
+ * Copyright 2014-2016 Wolf9466    <https://github.com/OhGodAPet>
+ * Copyright 2016      Jay D Dee   <jayddee246@gmail.com>
+ * Copyright 2016-2017 XMRig       <support@xmrig.com>
+ *
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include <math.h>
+#include <stdio.h>
+#include <string.h>
+
+
+#include "Cpu.h"
+#include "log/Log.h"
+#include "Options.h"
+#include "workers/Governor.h"
+#include "workers/Workers.h"
+
+
+Governor::CpuTimes Governor::m_times;
+double Governor::m_duty     = 1.0;
+double Governor::m_load     = 0.0;
+double Governor::m_pressure = 0.0;
+int Governor::m_target      = 0;
+std::vector<double> Governor::m_credits;
+uv_timer_t Governor::m_sampleTimer;
+uv_timer_t Governor::m_sliceTimer;
+
+
+bool Governor::start(int target)
+{
+    if (target <= 0) {
+        return false;
+    }
+
+    if (!readTimes(m_times)) {
+        LOG_WARN("load governor disabled, CPU usage statistics not available");
+        return false;
+    }
+
+    m_target = target;
+    m_duty   = 1.0;
+
+    // spread initial phase, so throttled threads not paused and resumed all at once.
+    const int threads = Workers::maxThreads();
+    m_credits.resize(threads);
+    for (int i = 0; i < threads; ++i) {
+        m_credits[i] = (double) i / threads;
+    }
+
+    uv_timer_init(uv_default_loop(), &m_sampleTimer);
+    uv_timer_start(&m_sampleTimer, Governor::onSample, kSampleInterval, kSampleInterval);
+
+    uv_timer_init(uv_default_loop(), &m_sliceTimer);
+    uv_timer_start(&m_sliceTimer, Governor::onSlice, kSliceInterval, kSliceInterval);
+
+    return true;
+}
+
+
+void Governor::stop()
+{
+    if (!isEnabled()) {
+        return;
+    }
+
+    uv_timer_stop(&m_sampleTimer);
+    uv_timer_stop(&m_sliceTimer);
+
+    for (size_t i = 0; i < m_credits.size(); ++i) {
+        Workers::setThrottled((int) i, false);
+    }
+
+    m_target = 0;
+}
+
+
+bool Governor::readTimes(CpuTimes &times)
+{
+#   ifdef __linux__
+    FILE *fp = fopen("/proc/stat", "r");
+    if (!fp) {
+        return false;
+    }
+
+    unsigned long long user = 0, nice = 0, system = 0, idle = 0, iowait = 0, irq = 0, softirq = 0, steal = 0;
+    const int count = fscanf(fp, "cpu %llu %llu %llu %llu %llu %llu %llu %llu", &user, &nice, &system, &idle, &iowait, &irq, &softirq, &steal);
+    fclose(fp);
+
+    if (count < 4) {
+        return false;
+    }
+
+    times.total = user + nice + system + idle + iowait + irq + softirq + steal;
+    times.idle  = idle + iowait;
+    times.self  = 0;
+
+    fp = fopen("/proc/self/stat", "r");
+    if (!fp) {
+        return false;
+    }
+
+    char buf[1024];
+    const size_t size = fread(buf, 1, sizeof(buf) - 1, fp);
+    fclose(fp);
+    buf[size] = '\0';
+
+    // process name may contain spaces, fields counted after closing parenthesis, utime and stime are 14 and 15.
+    const char *p = strrchr(buf, ')');
+    unsigned long long utime = 0, stime = 0;
+    if (!p || sscanf(p + 2, "%*c %*d %*d %*d %*d %*d %*u %*u %*u %*u %*u %llu %llu", &utime, &stime) != 2) {
+        return false;
+    }
+
+    times.self = utime + stime;
+    return true;
+#   else
+    return false;
+#   endif
+}
+
+
+/**
+ * @brief Returns share of time in percent some tasks stalled waiting for CPU during last 10 seconds, 0 if PSI not supported.
+ */
+double Governor::readPressure()
+{
+#   ifdef __linux__
+    FILE *fp = fopen("/proc/pressure/cpu", "r");
+    if (!fp) {
+        return 0.0;
+    }
+
+    double avg10 = 0.0;
+    if (fscanf(fp, "some avg10=%lf", &avg10) != 1) {
+        avg10 = 0.0;
+    }
+
+    fclose(fp);
+    return avg10;
+#   else
+    return 0.0;
+#   endif
+}
+
+
+void Governor::sample()
+{
+    CpuTimes times;
+    if (!readTimes(times) || times.total <= m_times.total) {
+        return;
+    }
+
+    const double total = (double) (times.total - m_times.total);
+    const double busy  = 1.0 - (double) (times.idle - m_times.idle) / total;
+    const double self  = (double) (times.self - m_times.self) / total;
+    m_times = times;
+
+    m_load     = busy * 100.0;
+    m_pressure = readPressure();
+
+    // share of whole machine left for mining after other processes.
+    double budget = m_target / 100.0 - (busy > self ? busy - self : 0.0);
+    if (m_pressure > kPressureLimit) {
+        budget *= kPressureLimit / m_pressure;
+    }
+
+    double duty = budget * Cpu::threads() / Workers::threads();
+    duty = duty < 0.0 ? 0.0 : (duty > 1.0 ? 1.0 : duty);
+
+    const double prev = m_duty;
+    m_duty = (m_duty + duty) / 2.0;
+
+    if (fabs(m_duty - prev) >= 0.1) {
+        LOG_INFO(Options::i()->colors() ? "\x1B[01;37mgovernor\x1B[0m host load \x1B[01;37m%.0f%%\x1B[0m mining duty \x1B[01;36m%.0f%%"
+                                        : "governor host load %.0f%% mining duty %.0f%%", m_load, m_duty * 100.0);
+    }
+}
+
+
+/**
+ * @brief Decide which threads run during next slice.
+ *
+ * Each thread accumulates duty cycle as credit and runs a slice when credit reaches one,
+ * so on average thread runs duty share of time.
+ */
+void Governor::slice()
+{
+    const int threads = Workers::threads();
+
+    for (int i = 0; i < (int) m_credits.size(); ++i) {
+        if (i >= threads || m_duty >= 0.99) {
+            Workers::setThrottled(i, false);
+            continue;
+        }
+
+        m_credits[i] += m_duty;
+        if (m_credits[i] >= 1.0) {
+            m_credits[i] -= 1.0;
+            Workers::setThrottled(i, false);
+        }
+        else {
+            Workers::setThrottled(i, true);
+        }
+    }
+}
+
+
+void Governor::onSample(uv_timer_t *handle)
+{
+    sample();
+}
+
+
+void Governor::onSlice(uv_timer_t *handle)
+{
+    slice();
+}
@@ -0,0 +1,82 @@
+/* XMRig
+ * Copyright 2010      Jeff Garzik <jgarzik@pobox.com>
+ * Copyright 2012-2014 pooler      <pooler@litecoinpool.org>
+ * Copyright 2014      Lucas Jones <https://github.com/lucasjones>
+ * Copyright 2014-2016 Wolf9466    <https://github.com/OhGodAPet>
+ * Copyright 2016      Jay D Dee   <jayddee246@gmail.com>
+ * Copyright 2016-2017 XMRig       <support@xmrig.com>
+ *
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef __GOVERNOR_H__
+#define __GOVERNOR_H__
+
+
+#include <stdint.h>
+#include <uv.h>
+#include <vector>
+
+
+/**
+ * Keeps host CPU load below target by throttling mining threads, runs on the event loop.
+ *
+ * Load of other processes sampled from /proc/stat minus own usage from /proc/self/stat,
+ * remaining budget converted to duty cycle and spread over threads with error diffusion.
+ */
+class Governor
+{
+public:
+    static bool start(int target);
+    static void stop();
+
+    static inline bool isEnabled()      { return m_target > 0; }
+    static inline double duty()         { return m_duty; }
+    static inline double load()         { return m_load; }
+    static inline double pressure()     { return m_pressure; }
+    static inline int target()          { return m_target; }
+
+private:
+    constexpr static int kSampleInterval  = 1000;
+    constexpr static int kSliceInterval   = 200;
+    constexpr static double kPressureLimit = 20.0;
+
+    struct CpuTimes
+    {
+        uint64_t total;
+        uint64_t idle;
+        uint64_t self;
+    };
+
+    static bool readTimes(CpuTimes &times);
+    static double readPressure();
+    static void sample();
+    static void slice();
+
+    static void onSample(uv_timer_t *handle);
+    static void onSlice(uv_timer_t *handle);
+
+    static CpuTimes m_times;
+    static double m_duty;
+    static double m_load;
+    static double m_pressure;
+    static int m_target;
+    static std::vector<double> m_credits;
+    static uv_timer_t m_sampleTimer;
+    static uv_timer_t m_sliceTimer;
+};
+
+
+#endif /* __GOVERNOR_H__ */
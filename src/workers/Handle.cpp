@@ -25,7 +25,8 @@
 #include "workers/Handle.h"
 
 
-Handle::Handle(int threadId, int threads, int64_t affinity, int priority) :
+Handle::Handle(int threadId, int threads, const CpuSet &affinity, int priority) :
+    m_finished(false),
     m_priority(priority),
     m_threadId(threadId),
     m_threads(threads),
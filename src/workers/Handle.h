@@ -25,32 +25,39 @@
 #define __HANDLE_H__
 
 
+#include <atomic>
 #include <stdint.h>
 #include <uv.h>
 
 
+#include "CpuSet.h"
+
+
 class IWorker;
 
 
 class Handle
 {
 public:
-    Handle(int threadId, int threads, int64_t affinity, int priority);
+    Handle(int threadId, int threads, const CpuSet &affinity, int priority);
     void join();
     void start(void (*callback) (void *));
 
+    inline const CpuSet &affinity() const  { return m_affinity; }
+    inline bool isFinished() const         { return m_finished.load(std::memory_order_acquire); }
     inline int priority() const            { return m_priority; }
     inline int threadId() const            { return m_threadId; }
     inline int threads() const             { return m_threads; }
-    inline int64_t affinity() const        { return m_affinity; }
     inline IWorker *worker() const         { return m_worker; }
+    inline void finish()                   { m_finished.store(true, std::memory_order_release); }
     inline void setWorker(IWorker *worker) { m_worker = worker; }
 
 private:
+    std::atomic<bool> m_finished;
     int m_priority;
     int m_threadId;
     int m_threads;
-    int64_t m_affinity;
+    CpuSet m_affinity;
     IWorker *m_worker;
     uv_thread_t m_thread;
 };
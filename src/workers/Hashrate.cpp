@@ -46,6 +46,7 @@ inline const char *format(double h, char* buf, size_t size)
 Hashrate::Hashrate(int threads) :
     m_highest(0.0),
     m_average(0.0),
+    m_capacity(threads),
     m_threads(threads)
 {
     m_counts     = new uint64_t*[threads];
@@ -55,10 +56,8 @@ Hashrate::Hashrate(int threads) :
     for (int i = 0; i < threads; i++) {
         m_counts[i] = new uint64_t[kBucketSize + 1];
         m_timestamps[i] = new uint64_t[kBucketSize + 1];
-        m_top[i] = 0;
 
-        memset(m_counts[i], 0, sizeof(uint64_t) * (kBucketSize + 1));
-        memset(m_timestamps[i], 0, sizeof(uint64_t) * (kBucketSize + 1));
+        reset(i);
     }
 
     const int printTime = Options::i()->printTime();
@@ -164,6 +163,67 @@ void Hashrate::print()
 }
 
 
+void Hashrate::reset(size_t threadId)
+{
+    m_top[threadId] = 0;
+
+    memset(m_counts[threadId], 0, sizeof(uint64_t) * (kBucketSize + 1));
+    memset(m_timestamps[threadId], 0, sizeof(uint64_t) * (kBucketSize + 1));
+}
+
+
+/**
+ * @brief Change number of threads, storage only grows, history of threads started again is cleared.
+ *
+ * Must be called from the event loop thread, as all other methods.
+ */
+void Hashrate::resize(int threads)
+{
+    if (threads > m_capacity) {
+        uint64_t **counts     = new uint64_t*[threads];
+        uint64_t **timestamps = new uint64_t*[threads];
+        uint32_t *top         = new uint32_t[threads];
+
+        memcpy(counts,     m_counts,     sizeof(uint64_t*) * m_capacity);
+        memcpy(timestamps, m_timestamps, sizeof(uint64_t*) * m_capacity);
+        memcpy(top,        m_top,        sizeof(uint32_t) * m_capacity);
+
+        for (int i = m_capacity; i < threads; i++) {
+            counts[i]     = new uint64_t[kBucketSize + 1];
+            timestamps[i] = new uint64_t[kBucketSize + 1];
+        }
+
+        delete [] m_counts;
+        delete [] m_timestamps;
+        delete [] m_top;
+
+        m_counts     = counts;
+        m_timestamps = timestamps;
+        m_top        = top;
+        m_capacity   = threads;
+    }
+
+    for (int i = m_threads; i < threads; i++) {
+        reset(i);
+    }
+
+    m_threads = threads;
+}
+
+
+/**
+ * @brief Values from previous run, average is replaced as soon as enough samples collected.
+ */
+void Hashrate::restore(double highest, double average)
+{
+    updateHighest(highest);
+
+    if (isnormal(average) && m_average == 0.0) {
+        m_average = average;
+    }
+}
+
+
 void Hashrate::stop()
 {
     uv_timer_stop(&m_timer);
@@ -43,6 +43,9 @@ public:
     double calc(size_t threadId, size_t ms) const;
     void add(size_t threadId, uint64_t count, uint64_t timestamp);
     void print();
+    void reset(size_t threadId);
+    void resize(int threads);
+    void restore(double highest, double average);
     void stop();
     void updateHighest();
 
@@ -60,6 +63,7 @@ private:
 
     double m_highest;
     double m_average;
+    int m_capacity;
     int m_threads;
     uint32_t* m_top;
     uint64_t** m_counts;
@@ -38,21 +38,22 @@ SingleWorker::SingleWorker(Handle *handle)
 
 void SingleWorker::start()
 {
-    while (Workers::sequence() > 0) {
-        if (Workers::isPaused()) {
-            do {
-                std::this_thread::sleep_for(std::chrono::milliseconds(200));
-            }
-            while (Workers::isPaused());
+    if (!m_ctx) {
+        return;
+    }
+
+    while (Workers::isRunning(m_id)) {
+        if (Workers::isPaused(m_id)) {
+            Workers::wait(m_id);
 
-            if (Workers::sequence() == 0) {
+            if (!Workers::isRunning(m_id)) {
                 break;
             }
 
             consumeJob();
         }
 
-        while (!Workers::isOutdated(m_sequence)) {
+        while (!Workers::isOutdated(m_sequence) && !Workers::isPaused(m_id)) {
             if ((m_count & 0xF) == 0) {
                 storeStats();
             }
@@ -69,6 +70,8 @@ void SingleWorker::start()
 
         consumeJob();
     }
+
+    Workers::save(m_id, m_job, m_result.nonce);
 }
 
 
@@ -87,9 +90,17 @@ bool SingleWorker::resume(const Job &job)
 
 void SingleWorker::consumeJob()
 {
-    Job job = Workers::job();
+    Job job = Workers::job(m_id);
     m_sequence = Workers::sequence();
-    if (m_job == job) {
+
+    // nonce in blob of current job overwritten while mining, compare without it, so
+    // sequence change without new job (resize, split, av change) keeps nonce position.
+    const uint32_t nonce = *m_job.nonce();
+    *m_job.nonce() = *job.nonce();
+    const bool same = m_job == job;
+    *m_job.nonce() = nonce;
+
+    if (same) {
         return;
     }
 
@@ -108,6 +119,8 @@ void SingleWorker::consumeJob()
     else {
         m_result.nonce = 0xffffffffU / m_threads * m_id;
     }
+
+    Workers::restore(m_id, m_job, &m_result.nonce);
 }
 
 
@@ -0,0 +1,123 @@
+/* XMRig
+ * Copyright 2010      Jeff Garzik <jgarzik@pobox.com>
+ * Copyright 2012-2014 pooler      <pooler@litecoinpool.org>
+ * Copyright 2014      Lucas Jones <https://github.com/lucasjones>
+ * Copyright 2014-2016 Wolf9466    <https://github.com/OhGodAPet>
+ * Copyright 2016      Jay D Dee   <jayddee246@gmail.com>
+ * Copyright 2016-2017 XMRig       <support@xmrig.com>
+ *
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include "workers/ThreadControl.h"
+#include "workers/Workers.h"
+
+
+ThreadControl::ThreadControl() :
+    m_flags(0),
+    m_latencyCount(0),
+    m_latencyLast(0),
+    m_latencyMax(0),
+    m_latencySum(0),
+    m_wakeTime(0)
+{
+    uv_cond_init(&m_cond);
+    uv_mutex_init(&m_mutex);
+}
+
+
+ThreadControl::~ThreadControl()
+{
+    uv_cond_destroy(&m_cond);
+    uv_mutex_destroy(&m_mutex);
+}
+
+
+/**
+ * @brief Average resume latency in microseconds.
+ */
+uint64_t ThreadControl::latencyAvg() const
+{
+    const uint64_t count = latencyCount();
+
+    return count ? m_latencySum.load(std::memory_order_relaxed) / count : 0;
+}
+
+
+void ThreadControl::set(int flag, bool enable)
+{
+    if (enable) {
+        m_flags.fetch_or(flag);
+        return;
+    }
+
+    if (m_flags.fetch_and(~flag) == flag) {
+        wake();
+    }
+}
+
+
+/**
+ * @brief Block calling mining thread until it allowed to run, called only by thread owning this object.
+ */
+void ThreadControl::wait(int id)
+{
+    uv_mutex_lock(&m_mutex);
+
+    if (!Workers::isPaused(id) || !Workers::isRunning(id)) {
+        uv_mutex_unlock(&m_mutex);
+        return;
+    }
+
+    // state checked under the lock, so any wake up request stored before it is stale.
+    m_wakeTime = 0;
+
+    do {
+        uv_cond_wait(&m_cond, &m_mutex);
+    }
+    while (Workers::isPaused(id) && Workers::isRunning(id));
+
+    uv_mutex_unlock(&m_mutex);
+
+    const uint64_t wakeTime = m_wakeTime.exchange(0);
+    if (!wakeTime) {
+        return;
+    }
+
+    const uint64_t now     = uv_hrtime();
+    const uint64_t latency = now > wakeTime ? (now - wakeTime) / 1000 : 0;
+
+    m_latencyLast.store(latency, std::memory_order_relaxed);
+    m_latencySum.fetch_add(latency, std::memory_order_relaxed);
+    m_latencyCount.fetch_add(1, std::memory_order_relaxed);
+
+    if (latency > m_latencyMax.load(std::memory_order_relaxed)) {
+        m_latencyMax.store(latency, std::memory_order_relaxed);
+    }
+}
+
+
+/**
+ * @brief Wake up thread if it waits, state change which allows thread to run must be stored before this call.
+ */
+void ThreadControl::wake()
+{
+    m_wakeTime = uv_hrtime();
+
+    uv_mutex_lock(&m_mutex);
+    uv_cond_signal(&m_cond);
+    uv_mutex_unlock(&m_mutex);
+}
@@ -0,0 +1,74 @@
+/* XMRig
+ * Copyright 2010      Jeff Garzik <jgarzik@pobox.com>
+ * Copyright 2012-2014 pooler      <pooler@litecoinpool.org>
+ * Copyright 2014      Lucas Jones <https://github.com/lucasjones>
+ * Copyright 2014-2016 Wolf9466    <https://github.com/OhGodAPet>
+ * Copyright 2016      Jay D Dee   <jayddee246@gmail.com>
+ * Copyright 2016-2017 XMRig       <support@xmrig.com>
+ *
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef __THREADCONTROL_H__
+#define __THREADCONTROL_H__
+
+
+#include <atomic>
+#include <stdint.h>
+#include <uv.h>
+
+
+/**
+ * Pause state of single mining thread.
+ *
+ * Paused thread blocks on own condition variable and woken up only when this thread can run again,
+ * time between wake up request and actual resume collected as resume latency.
+ */
+class ThreadControl
+{
+public:
+    enum Flags {
+        Throttled = 1,
+        Disabled  = 2
+    };
+
+    ThreadControl();
+    ~ThreadControl();
+
+    inline bool isDisabled() const       { return (m_flags.load(std::memory_order_relaxed) & Disabled) != 0; }
+    inline bool isPaused() const         { return m_flags.load(std::memory_order_relaxed) != 0; }
+    inline bool isThrottled() const      { return (m_flags.load(std::memory_order_relaxed) & Throttled) != 0; }
+    inline uint64_t latencyCount() const { return m_latencyCount.load(std::memory_order_relaxed); }
+    inline uint64_t latencyLast() const  { return m_latencyLast.load(std::memory_order_relaxed); }
+    inline uint64_t latencyMax() const   { return m_latencyMax.load(std::memory_order_relaxed); }
+
+    uint64_t latencyAvg() const;
+    void set(int flag, bool enable);
+    void wait(int id);
+    void wake();
+
+private:
+    std::atomic<int> m_flags;
+    std::atomic<uint64_t> m_latencyCount;
+    std::atomic<uint64_t> m_latencyLast;
+    std::atomic<uint64_t> m_latencyMax;
+    std::atomic<uint64_t> m_latencySum;
+    std::atomic<uint64_t> m_wakeTime;
+    uv_cond_t m_cond;
+    uv_mutex_t m_mutex;
+};
+
+
+#endif /* __THREADCONTROL_H__ */
@@ -0,0 +1,81 @@
+/* XMRig
+ * Copyright 2010      Jeff Garzik <jgarzik@pobox.com>
+ * Copyright 2012-2014 pooler      <pooler@litecoinpool.org>
+ * Copyright 2014      Lucas Jones <https://github.com/lucasjones>
+ * Copyright 2014-2016 Wolf9466    <https://github.com/OhGodAPet>
+ * Copyright 2016      Jay D Dee   <jayddee246@gmail.com>
+ * Copyright 2016-2017 XMRig       <support@xmrig.com>
+ *
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include "workers/ThreadGroups.h"
+
+
+/**
+ * @brief Map each thread to group index, groups with zero weight get no threads.
+ *
+ * Every weighted group gets one thread first (heavier groups first if threads are not enough), remaining
+ * threads distributed by Sainte-Lague: next thread goes to group with highest weight / (2 * assigned + 1).
+ * Threads of one group are contiguous, group -1 returned only if all weights are zero.
+ */
+void ThreadGroups::assign(const std::vector<int> &weights, int threads, std::vector<int> &groups)
+{
+    std::vector<int> counts(weights.size(), 0);
+
+    for (int i = 0; i < threads; ++i) {
+        int best = -1;
+
+        for (size_t g = 0; g < weights.size(); ++g) {
+            if (weights[g] <= 0) {
+                continue;
+            }
+
+            if (best == -1) {
+                best = (int) g;
+                continue;
+            }
+
+            if ((counts[g] == 0) != (counts[best] == 0)) {
+                if (counts[g] == 0) {
+                    best = (int) g;
+                }
+
+                continue;
+            }
+
+            // compare weights[g] / (2 * counts[g] + 1) against the best quotient without division.
+            if ((long long) weights[g] * (2 * counts[best] + 1) > (long long) weights[best] * (2 * counts[g] + 1)) {
+                best = (int) g;
+            }
+        }
+
+        if (best == -1) {
+            break;
+        }
+
+        counts[best]++;
+    }
+
+    groups.assign(threads > 0 ? threads : 0, -1);
+
+    int id = 0;
+    for (size_t g = 0; g < counts.size(); ++g) {
+        for (int i = 0; i < counts[g]; ++i) {
+            groups[id++] = (int) g;
+        }
+    }
+}
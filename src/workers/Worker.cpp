@@ -22,11 +22,13 @@
  */
 
 #include <chrono>
+#include <uv.h>
 
 
 #include "Cpu.h"
 #include "Mem.h"
 #include "Platform.h"
+#include "Startup.h"
 #include "workers/Handle.h"
 #include "workers/Worker.h"
 
@@ -40,17 +42,21 @@ Worker::Worker(Handle *handle) :
     m_sequence(0),
     m_benchmark(false)
 {
-    if (Cpu::threads() > 1 && handle->affinity() != -1L) {
+    if (Cpu::threads() > 1 && !handle->affinity().isEmpty()) {
         Cpu::setAffinity(m_id, handle->affinity());
     }
 
     Platform::setThreadPriority(handle->priority());
+
+    const uint64_t start = uv_hrtime();
     m_ctx = Mem::create(m_id);
+    Startup::onWorker(uv_hrtime() - start);
 }
 
 
 Worker::~Worker()
 {
+    Mem::destroy(m_id, m_ctx);
 }
 
 
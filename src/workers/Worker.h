@@ -42,6 +42,7 @@ public:
     Worker(Handle *handle);
     ~Worker();
 
+    inline bool isReady() const override       { return m_ctx != nullptr; }
     inline uint64_t hashCount() const override { return m_hashCount.load(std::memory_order_relaxed); }
     inline uint64_t timestamp() const override { return m_timestamp.load(std::memory_order_relaxed); }
     inline void setBenchmark(bool enable) override { m_benchmark = enable; }
@@ -25,26 +25,43 @@
 
 
 #include "api/Api.h"
+#include "Cgroup.h"
+#include "Cpu.h"
+#include "crypto/CryptoNight.h"
 #include "interfaces/IJobResultListener.h"
+#include "log/Log.h"
 #include "Mem.h"
 #include "Options.h"
+#include "Startup.h"
 #include "workers/DoubleWorker.h"
 #include "workers/Handle.h"
 #include "workers/Hashrate.h"
 #include "workers/SingleWorker.h"
+#include "workers/ThreadGroups.h"
 #include "workers/Workers.h"
 
 
 bool Workers::m_active = false;
 bool Workers::m_enabled = true;
 bool Workers::m_benchmark = false;
+bool Workers::m_strictAffinity = false;
+CpuSet Workers::m_affinity;
 Hashrate *Workers::m_hashrate = nullptr;
 IJobResultListener *Workers::m_listener = nullptr;
+int Workers::m_maxThreads = 0;
+int Workers::m_priority = -1;
 Job Workers::m_job;
 std::atomic<int> Workers::m_paused;
+std::atomic<int> Workers::m_threads;
 std::atomic<uint64_t> Workers::m_sequence;
 std::list<JobResult> Workers::m_queue;
+std::vector<Workers::Checkpoint> Workers::m_checkpoints;
 std::vector<Handle*> Workers::m_workers;
+std::vector<int> Workers::m_groups;
+std::vector<int> Workers::m_weights;
+std::vector<Job> Workers::m_jobs;
+std::vector<Topology::Slot> Workers::m_placement;
+ThreadControl *Workers::m_control = nullptr;
 uint64_t Workers::m_ticks = 0;
 uv_async_t Workers::m_async;
 uv_mutex_t Workers::m_mutex;
@@ -52,12 +69,16 @@ uv_rwlock_t Workers::m_rwlock;
 uv_timer_t Workers::m_timer;
 
 
-Job Workers::job()
+/**
+ * @brief Current job for thread, in split mode each thread mines job of pool from its group.
+ */
+Job Workers::job(int id)
 {
     if (!m_benchmark)
     {
         uv_rwlock_rdlock(&m_rwlock);
-        Job job = m_job;
+        const int group = id < (int) m_groups.size() ? m_groups[id] : -1;
+        Job job = group >= 0 ? m_jobs[group] : m_job;
         uv_rwlock_rdunlock(&m_rwlock);
         return job;
     }
@@ -72,6 +93,62 @@ Job Workers::job()
 }
 
 
+/**
+ * @brief Continue nonce range of previous thread with the same id if it stopped on the same job.
+ *
+ * Called once by a new worker thread, previous thread already joined, so no lock needed.
+ */
+bool Workers::restore(int id, const Job &job, uint32_t *nonce1, uint32_t *nonce2)
+{
+    Checkpoint &checkpoint = m_checkpoints[id];
+    if (!checkpoint.valid) {
+        return false;
+    }
+
+    const bool found = checkpoint.poolId == job.poolId() && checkpoint.id == job.id();
+    if (found) {
+        *nonce1 = checkpoint.nonce1;
+
+        if (nonce2) {
+            *nonce2 = checkpoint.nonce2;
+        }
+    }
+
+    checkpoint.valid = false;
+    return found;
+}
+
+
+/**
+ * @brief Switch hash implementation at runtime, workers paused while self-test runs.
+ *
+ * Only AES implementation can be changed, scratchpads are allocated for single or double hash.
+ */
+bool Workers::setAlgoVariant(int av)
+{
+    const int prev   = Options::i()->algoVariant();
+    const int paused = m_paused.exchange(1);
+    m_sequence++;
+
+    const bool ok = CryptoNight::init(Options::i()->algo(), av);
+    if (ok) {
+        Options::i()->setAlgoVariant(av);
+    }
+    else {
+        CryptoNight::init(Options::i()->algo(), prev);
+    }
+
+    m_paused = paused;
+    m_sequence++;
+
+    if (!paused) {
+        wakeAll();
+    }
+
+    return ok;
+}
+
+
 void Workers::printHashrate(bool detail)
 {
     m_hashrate->print();
@@ -91,13 +168,31 @@ void Workers::setEnabled(bool enabled)
 
     m_paused = enabled ? 0 : 1;
     m_sequence++;
+
+    if (enabled) {
+        wakeAll();
+    }
 }
 
 
+/**
+ * @brief Set job for all threads or, in split mode, only for group of pool that sent it.
+ *
+ * Donate job has no group and replaces jobs of all groups until pools resend own jobs.
+ */
 void Workers::setJob(const Job &job)
 {
     uv_rwlock_wrlock(&m_rwlock);
-    m_job = job;
+    if (job.poolId() >= 0 && job.poolId() < (int) m_jobs.size()) {
+        m_jobs[job.poolId()] = job;
+    }
+    else {
+        m_job = job;
+
+        for (Job &group : m_jobs) {
+            group = job;
+        }
+    }
     uv_rwlock_wrunlock(&m_rwlock);
 
     m_active = true;
@@ -107,13 +202,94 @@ void Workers::setJob(const Job &job)
 
     m_sequence++;
     m_paused = 0;
+
+    wakeAll();
+}
+
+
+/**
+ * @brief Change number of mining threads at runtime.
+ *
+ * Threads above new count leave mining loop and reaped by timer, missing threads started,
+ * first Mem::threads() threads use scratchpads from initial allocation, others allocate own.
+ */
+void Workers::setThreads(int threads)
+{
+    if (threads < 1 || threads > m_maxThreads || threads == m_threads) {
+        return;
+    }
+
+    m_threads = threads;
+    m_sequence++;
+
+    // paused threads above new count must wake up to exit.
+    wakeAll();
+
+    for (int i = 0; i < threads; ++i) {
+        if (!m_workers[i]) {
+            startThread(i);
+        }
+    }
+
+    if (!m_weights.empty()) {
+        split();
+    }
+
+    m_hashrate->resize(threads);
+}
+
+
+/**
+ * @brief Pause or resume single thread on behalf of load governor, global pause state not affected.
+ */
+void Workers::setThrottled(int id, bool throttled)
+{
+    m_control[id].set(ThreadControl::Throttled, throttled);
 }
 
 
-void Workers::start(int64_t affinity, int priority, bool benchmark)
+/**
+ * @brief Enable or disable single thread, disabled thread stays paused until enabled again.
+ */
+void Workers::setThreadEnabled(int id, bool enabled)
+{
+    if (id < 0 || id >= m_maxThreads) {
+        return;
+    }
+
+    m_control[id].set(ThreadControl::Disabled, !enabled);
+}
+
+
+/**
+ * @brief Enable split mode, threads divided between pools by weights indexed by pool id, empty vector disables it.
+ */
+void Workers::setWeights(const std::vector<int> &weights)
+{
+    if (weights == m_weights) {
+        return;
+    }
+
+    m_weights = weights;
+    split();
+
+    if (m_active && m_enabled) {
+        wakeAll();
+    }
+}
+
+
+void Workers::start(const CpuSet &affinity, int priority, bool benchmark)
 {
     const int threads = Mem::threads();
-    m_hashrate = new Hashrate(threads);
+    const int limit   = Cgroup::cpuLimit();
+    const int cpus    = (limit && limit < Cpu::threads()) ? limit : Cpu::threads();
+
+    m_hashrate   = new Hashrate(threads);
+    m_threads    = threads;
+    m_maxThreads = threads > cpus ? threads : cpus;
+    m_affinity   = affinity;
+    m_priority   = priority;
 
     uv_mutex_init(&m_mutex);
     uv_rwlock_init(&m_rwlock);
@@ -128,20 +304,40 @@ void Workers::start(int64_t affinity, int priority, bool benchmark)
 
     // if the mask width is equal to the number of threads,
     // then using a strict thread affinity (1 thread on only 1 logical processor)
-    bool useStrictThreadAffinity = false;
-    if (affinity != -1L && threads > 1) {
-        useStrictThreadAffinity = (getCpuMaskWidth(affinity) == threads);
+    m_strictAffinity = false;
+    if (!affinity.isEmpty() && threads > 1) {
+        m_strictAffinity = (affinity.count() == threads);
+    }
+
+    m_workers.resize(m_maxThreads, nullptr);
+    m_checkpoints.resize(m_maxThreads);
+    m_control = new ThreadControl[m_maxThreads];
+
+    if (Options::i()->autoAffinity()) {
+        const int scratchpad = (Options::i()->algo() == Options::ALGO_CRYPTONIGHT_LITE ? 1024 : 2048) * (Options::i()->doubleHash() ? 2 : 1);
+        m_placement = Topology::place(m_maxThreads, scratchpad);
     }
 
     for (int i = 0; i < threads; ++i) {
-        uint64_t threadAffinity = useStrictThreadAffinity ? getThreadAffinity(affinity, i) : affinity;
-        Handle *handle = new Handle(i, threads, threadAffinity, priority);
-        m_workers.push_back(handle);
-        handle->start(Workers::onReady);
+        startThread(i);
     }
 }
 
 
+/**
+ * @brief Remember position in nonce range when thread leaves after resize, see restore().
+ */
+void Workers::save(int id, const Job &job, uint32_t nonce1, uint32_t nonce2)
+{
+    Checkpoint &checkpoint = m_checkpoints[id];
+    checkpoint.valid  = true;
+    checkpoint.poolId = job.poolId();
+    checkpoint.id     = job.id();
+    checkpoint.nonce1 = nonce1;
+    checkpoint.nonce2 = nonce2;
+}
+
+
 void Workers::stop()
 {
     uv_timer_stop(&m_timer);
@@ -151,8 +347,12 @@ void Workers::stop()
     m_paused   = 0;
     m_sequence = 0;
 
-    for (size_t i = 0; i < m_workers.size(); ++i) {
-        m_workers[i]->join();
+    wakeAll();
+
+    for (Handle *handle : m_workers) {
+        if (handle) {
+            handle->join();
+        }
     }
 }
 
@@ -182,6 +382,7 @@ void Workers::onReady(void *arg)
 
     handle->worker()->setBenchmark(m_benchmark);
     handle->worker()->start();
+    handle->finish();
 }
 
 
@@ -206,9 +407,13 @@ void Workers::onResult(uv_async_t *handle)
 
 void Workers::onTick(uv_timer_t *handle)
 {
-    for (Handle *handle : m_workers) {
-        if (!handle->worker()) {
-            return;
+    reap();
+
+    const int threads = m_threads;
+    for (int i = 0; i < threads; ++i) {
+        Handle *handle = m_workers[i];
+        if (!handle || !handle->worker()) {
+            continue;
         }
 
         m_hashrate->add(handle->threadId(), handle->worker()->hashCount(), handle->worker()->timestamp());
@@ -218,32 +423,86 @@ void Workers::onTick(uv_timer_t *handle)
         m_hashrate->updateHighest();
     }
 
+    Startup::tick(Mem::threads(), m_benchmark);
+
 #   ifndef XMRIG_NO_API
     Api::tick(m_hashrate);
 #   endif
 }
 
-int Workers::getCpuMaskWidth(int64_t mask)
+/**
+ * @brief Join threads finished after resize and free their scratchpads, thread count lowered if new thread failed to allocate scratchpad.
+ */
+void Workers::reap()
 {
-    int count = 0;
-    while (mask)
-    {
-        count += mask & 1;
-        mask >>= 1;
+    for (size_t i = 0; i < m_workers.size(); ++i) {
+        Handle *handle = m_workers[i];
+        if (!handle || !handle->isFinished()) {
+            continue;
+        }
+
+        handle->join();
+        const bool ready = handle->worker()->isReady();
+        delete handle->worker();
+        delete handle;
+
+        m_workers[i] = nullptr;
+
+        // scratchpad allocation failed, retry would fail again, so keep only threads below.
+        if (!ready && i > 0 && (int) i < m_threads) {
+            LOG_ERR("thread #%d failed to start, reduce threads to %d", (int) i, (int) i);
+            setThreads((int) i);
+            continue;
+        }
+
+        // thread count raised again before this thread noticed it was stopped.
+        if ((int) i < m_threads) {
+            m_hashrate->reset(i);
+            startThread((int) i);
+        }
     }
-    return count;
 }
 
 
-int64_t Workers::getThreadAffinity(int64_t cpuMask, int threadId)
+void Workers::split()
 {
-    int affinity = 1;
-    int count = cpuMask & affinity;
-    while (count < (threadId + 1) && affinity < cpuMask)
-    {
-        affinity <<= 1;
-        if (cpuMask & affinity)
-            count++;
+    std::vector<int> groups;
+    ThreadGroups::assign(m_weights, m_threads, groups);
+    groups.resize(m_maxThreads, groups.empty() ? -1 : groups.back());
+
+    uv_rwlock_wrlock(&m_rwlock);
+    m_groups = std::move(groups);
+    m_jobs.resize(m_weights.size());
+    uv_rwlock_wrunlock(&m_rwlock);
+
+    m_sequence++;
+}
+
+
+void Workers::startThread(int id)
+{
+    CpuSet affinity;
+    if (!m_placement.empty()) {
+        affinity.set(m_placement[id].cpu);
+    }
+    else if (m_strictAffinity && id < m_affinity.count()) {
+        affinity.set(m_affinity.nth(id));
+    }
+    else {
+        affinity = m_affinity;
+    }
+
+    Handle *handle = new Handle(id, m_maxThreads, affinity, m_priority);
+    m_workers[id] = handle;
+    handle->start(Workers::onReady);
+}
+
+
+void Workers::wakeAll()
+{
+    for (int i = 0; i < m_maxThreads; ++i) {
+        if (m_workers[i]) {
+            m_control[i].wake();
+        }
     }
-    return (affinity > cpuMask) ? cpuMask : affinity;
 }
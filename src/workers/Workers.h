@@ -30,8 +30,11 @@
 #include <uv.h>
 #include <vector>
 
+#include "CpuSet.h"
 #include "net/Job.h"
 #include "net/JobResult.h"
+#include "Topology.h"
+#include "workers/ThreadControl.h"
 
 
 class Handle;
@@ -42,38 +45,77 @@ class IJobResultListener;
 class Workers
 {
 public:
-    static Job job();
+    static Job job(int id);
+    static bool restore(int id, const Job &job, uint32_t *nonce1, uint32_t *nonce2 = nullptr);
+    static bool setAlgoVariant(int av);
     static void printHashrate(bool detail);
     static void setEnabled(bool enabled);
     static void setJob(const Job &job);
-    static void start(int64_t affinity, int priority, bool benchmark);
+    static void setThreadEnabled(int id, bool enabled);
+    static void setThreads(int threads);
+    static void setThrottled(int id, bool throttled);
+    static void setWeights(const std::vector<int> &weights);
+    static void start(const CpuSet &affinity, int priority, bool benchmark);
+    static void save(int id, const Job &job, uint32_t nonce1, uint32_t nonce2 = 0);
     static void stop();
     static void submit(const JobResult &result);
 
     static inline bool isEnabled()                               { return m_enabled; }
+    static inline Hashrate *hashrate()                           { return m_hashrate; }
     static inline bool isOutdated(uint64_t sequence)             { return m_sequence.load(std::memory_order_relaxed) != sequence; }
     static inline bool isPaused()                                { return m_paused.load(std::memory_order_relaxed) == 1; }
+    static inline bool isPaused(int id)                          { return isPaused() || m_control[id].isPaused(); }
+    static inline bool isRunning(int id)                         { return m_sequence.load(std::memory_order_relaxed) > 0 && id < m_threads.load(std::memory_order_relaxed); }
+    static inline int maxThreads()                               { return m_maxThreads; }
+    static inline const Topology::Slot *placement(int id)        { return m_placement.empty() ? nullptr : &m_placement[id]; }
+    static inline const ThreadControl &control(int id)           { return m_control[id]; }
+    static inline int threads()                                  { return m_threads.load(std::memory_order_relaxed); }
     static inline uint64_t sequence()                            { return m_sequence.load(std::memory_order_relaxed); }
     static inline void pause()                                   { m_active = false; m_paused = 1; m_sequence++; }
     static inline void setListener(IJobResultListener *listener) { m_listener = listener; }
+    static inline void wait(int id)                              { m_control[id].wait(id); }
 
 private:
+    struct Checkpoint
+    {
+        inline Checkpoint() : valid(false), poolId(-1), nonce1(0), nonce2(0) {}
+
+        bool valid;
+        int poolId;
+        JobId id;
+        uint32_t nonce1;
+        uint32_t nonce2;
+    };
+
     static void onReady(void *arg);
     static void onResult(uv_async_t *handle);
     static void onTick(uv_timer_t *handle);
-    static int getCpuMaskWidth(int64_t mask);
-    static int64_t getThreadAffinity(int64_t cpuMask, int threadId);
+    static void reap();
+    static void split();
+    static void startThread(int id);
+    static void wakeAll();
 
     static bool m_active;
     static bool m_enabled;
     static bool m_benchmark;
+    static bool m_strictAffinity;
+    static CpuSet m_affinity;
     static Hashrate *m_hashrate;
     static IJobResultListener *m_listener;
+    static int m_maxThreads;
+    static int m_priority;
     static Job m_job;
     static std::atomic<int> m_paused;
+    static std::atomic<int> m_threads;
     static std::atomic<uint64_t> m_sequence;
     static std::list<JobResult> m_queue;
+    static std::vector<Checkpoint> m_checkpoints;
     static std::vector<Handle*> m_workers;
+    static std::vector<int> m_groups;
+    static std::vector<int> m_weights;
+    static std::vector<Job> m_jobs;
+    static std::vector<Topology::Slot> m_placement;
+    static ThreadControl *m_control;
     static uint64_t m_ticks;
     static uv_async_t m_async;
     static uv_mutex_t m_mutex;
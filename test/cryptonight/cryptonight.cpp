@@ -4,12 +4,9 @@
 #include <string.h>
 #include <mm_malloc.h>
 
-#include "options.h"
-#include "algo/cryptonight/cryptonight.h"
+#include "crypto/CryptoNight_x86.h"
 
-bool opt_double_hash = false;
-
-const static char input1[152] = {
+const static uint8_t input1[152] = {
     0x03, 0x05, 0xA0, 0xDB, 0xD6, 0xBF, 0x05, 0xCF, 0x16, 0xE5, 0x03, 0xF3, 0xA6, 0x6F, 0x78, 0x00,
     0x7C, 0xBF, 0x34, 0x14, 0x43, 0x32, 0xEC, 0xBF, 0xC2, 0x2E, 0xD9, 0x5C, 0x87, 0x00, 0x38, 0x3B,
     0x30, 0x9A, 0xCE, 0x19, 0x23, 0xA0, 0x96, 0x4B, 0x00, 0x00, 0x00, 0x08, 0xBA, 0x93, 0x9A, 0x62,
@@ -26,10 +23,24 @@ const static char input2[] = "This is a test";
 const static char input3[] = "Lorem ipsum dolor sit amet, consectetur adipiscing elit. Vivamus pellentesque metus.";
 
 
-void cryptonight_av1_aesni(const void* input, size_t size, void* output, struct cryptonight_ctx* ctx);
-void cryptonight_av2_aesni_double(const void* input, size_t size, void* output, struct cryptonight_ctx* ctx);
-void cryptonight_av3_softaes(const void* input, size_t size, void* output, struct cryptonight_ctx* ctx);
-void cryptonight_av4_softaes_double(const void* input, size_t size, void* output, struct cryptonight_ctx* ctx);
+static void cryptonight_av1_aesni(const void *input, size_t size, void *output, cryptonight_ctx *ctx) {
+    cryptonight_hash<0x80000, MEMORY, 0x1FFFF0, false>(input, size, output, ctx);
+}
+
+
+static void cryptonight_av2_aesni_double(const void *input, size_t size, void *output, cryptonight_ctx *ctx) {
+    cryptonight_double_hash<0x80000, MEMORY, 0x1FFFF0, false>(input, size, output, ctx);
+}
+
+
+static void cryptonight_av3_softaes(const void *input, size_t size, void *output, cryptonight_ctx *ctx) {
+    cryptonight_hash<0x80000, MEMORY, 0x1FFFF0, true>(input, size, output, ctx);
+}
+
+
+static void cryptonight_av4_softaes_double(const void *input, size_t size, void *output, cryptonight_ctx *ctx) {
+    cryptonight_double_hash<0x80000, MEMORY, 0x1FFFF0, true>(input, size, output, ctx);
+}
 
 
 static char hash[64];
@@ -41,12 +52,12 @@ static char hash[64];
 
 static char *bin2hex(const unsigned char *p, size_t len)
 {
-    char *s = malloc((len * 2) + 1);
+    char *s = static_cast<char*>(malloc((len * 2) + 1));
     if (!s) {
         return NULL;
     }
 
-    for (int i = 0; i < len; i++) {
+    for (size_t i = 0; i < len; i++) {
         sprintf(s + (i * 2), "%02x", (unsigned int) p[i]);
     }
 
@@ -71,14 +82,14 @@ static void free_ctx(struct cryptonight_ctx *ctx) {
 void test_cryptonight_av1_should_CalcHash(void) {
     struct cryptonight_ctx *ctx = (struct cryptonight_ctx*) create_ctx(1);
 
-    cryptonight_av1_aesni(input1, 76, &hash, ctx);
-    TEST_ASSERT_EQUAL_STRING(RESULT1, bin2hex(hash, 32));
+    cryptonight_av1_aesni(input1, 76, hash, ctx);
+    TEST_ASSERT_EQUAL_STRING(RESULT1, bin2hex(reinterpret_cast<const unsigned char*>(hash), 32));
 
-    cryptonight_av1_aesni(input2, strlen(input2), &hash, ctx);
-    TEST_ASSERT_EQUAL_STRING(RESULT2, bin2hex(hash, 32));
+    cryptonight_av1_aesni(input2, strlen(input2), hash, ctx);
+    TEST_ASSERT_EQUAL_STRING(RESULT2, bin2hex(reinterpret_cast<const unsigned char*>(hash), 32));
 
-    cryptonight_av1_aesni(input3, strlen(input3), &hash, ctx);
-    TEST_ASSERT_EQUAL_STRING(RESULT3, bin2hex(hash, 32));
+    cryptonight_av1_aesni(input3, strlen(input3), hash, ctx);
+    TEST_ASSERT_EQUAL_STRING(RESULT3, bin2hex(reinterpret_cast<const unsigned char*>(hash), 32));
 
     free_ctx(ctx);
 }
@@ -88,8 +99,8 @@ void test_cryptonight_av2_should_CalcHash(void)
 {
     struct cryptonight_ctx *ctx = (struct cryptonight_ctx*) create_ctx(2);
 
-    cryptonight_av2_aesni_double(input1, 76, &hash, ctx);
-    TEST_ASSERT_EQUAL_STRING(RESULT1_DOUBLE, bin2hex(hash, 64));
+    cryptonight_av2_aesni_double(input1, 76, hash, ctx);
+    TEST_ASSERT_EQUAL_STRING(RESULT1_DOUBLE, bin2hex(reinterpret_cast<const unsigned char*>(hash), 64));
 
     free_ctx(ctx);
 }
@@ -99,14 +110,14 @@ void test_cryptonight_av3_should_CalcHash(void)
 {
     struct cryptonight_ctx *ctx = (struct cryptonight_ctx*) create_ctx(1);
 
-    cryptonight_av3_softaes(input1, 76, &hash, ctx);
-    TEST_ASSERT_EQUAL_STRING(RESULT1, bin2hex(hash, 32));
+    cryptonight_av3_softaes(input1, 76, hash, ctx);
+    TEST_ASSERT_EQUAL_STRING(RESULT1, bin2hex(reinterpret_cast<const unsigned char*>(hash), 32));
 
-    cryptonight_av3_softaes(input2, strlen(input2), &hash, ctx);
-    TEST_ASSERT_EQUAL_STRING(RESULT2, bin2hex(hash, 32));
+    cryptonight_av3_softaes(input2, strlen(input2), hash, ctx);
+    TEST_ASSERT_EQUAL_STRING(RESULT2, bin2hex(reinterpret_cast<const unsigned char*>(hash), 32));
 
-    cryptonight_av3_softaes(input3, strlen(input3), &hash, ctx);
-    TEST_ASSERT_EQUAL_STRING(RESULT3, bin2hex(hash, 32));
+    cryptonight_av3_softaes(input3, strlen(input3), hash, ctx);
+    TEST_ASSERT_EQUAL_STRING(RESULT3, bin2hex(reinterpret_cast<const unsigned char*>(hash), 32));
 
     free_ctx(ctx);
 }
@@ -116,8 +127,8 @@ void test_cryptonight_av4_should_CalcHash(void)
 {
     struct cryptonight_ctx *ctx = (struct cryptonight_ctx*) create_ctx(2);
 
-    cryptonight_av4_softaes_double(input1, 76, &hash, ctx);
-    TEST_ASSERT_EQUAL_STRING(RESULT1_DOUBLE, bin2hex(hash, 64));
+    cryptonight_av4_softaes_double(input1, 76, hash, ctx);
+    TEST_ASSERT_EQUAL_STRING(RESULT1_DOUBLE, bin2hex(reinterpret_cast<const unsigned char*>(hash), 64));
 
     free_ctx(ctx);
 }
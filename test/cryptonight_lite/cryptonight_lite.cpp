@@ -4,13 +4,9 @@
 #include <string.h>
 #include <mm_malloc.h>
 
-#include "options.h"
-#include "algo/cryptonight/cryptonight.h"
+#include "crypto/CryptoNight_x86.h"
 
-bool opt_double_hash = false;
-enum mining_algo opt_algo = ALGO_CRYPTONIGHT_LITE;
-
-const static char input1[152] = {
+const static uint8_t input1[152] = {
     0x03, 0x05, 0xA0, 0xDB, 0xD6, 0xBF, 0x05, 0xCF, 0x16, 0xE5, 0x03, 0xF3, 0xA6, 0x6F, 0x78, 0x00,
     0x7C, 0xBF, 0x34, 0x14, 0x43, 0x32, 0xEC, 0xBF, 0xC2, 0x2E, 0xD9, 0x5C, 0x87, 0x00, 0x38, 0x3B,
     0x30, 0x9A, 0xCE, 0x19, 0x23, 0xA0, 0x96, 0x4B, 0x00, 0x00, 0x00, 0x08, 0xBA, 0x93, 0x9A, 0x62,
@@ -24,15 +20,24 @@ const static char input1[152] = {
 };
 
 
-void cryptonight_av1_aesni(const void* input, size_t size, void* output, struct cryptonight_ctx* ctx)          {}
-void cryptonight_av2_aesni_double(const void* input, size_t size, void* output, struct cryptonight_ctx* ctx)   {}
-void cryptonight_av3_softaes(const void* input, size_t size, void* output, struct cryptonight_ctx* ctx)        {}
-void cryptonight_av4_softaes_double(const void* input, size_t size, void* output, struct cryptonight_ctx* ctx) {}
+static void cryptonight_lite_av1_aesni(const void *input, size_t size, void *output, cryptonight_ctx *ctx) {
+    cryptonight_hash<0x40000, MEMORY_LITE, 0xFFFF0, false>(input, size, output, ctx);
+}
+
+
+static void cryptonight_lite_av2_aesni_double(const void *input, size_t size, void *output, cryptonight_ctx *ctx) {
+    cryptonight_double_hash<0x40000, MEMORY_LITE, 0xFFFF0, false>(input, size, output, ctx);
+}
+
+
+static void cryptonight_lite_av3_softaes(const void *input, size_t size, void *output, cryptonight_ctx *ctx) {
+    cryptonight_hash<0x40000, MEMORY_LITE, 0xFFFF0, true>(input, size, output, ctx);
+}
 
-void cryptonight_lite_av1_aesni(const void* input, size_t size, void* output, struct cryptonight_ctx* ctx);
-void cryptonight_lite_av2_aesni_double(const void* input, size_t size, void* output, struct cryptonight_ctx* ctx);
-void cryptonight_lite_av3_softaes(const void* input, size_t size, void* output, struct cryptonight_ctx* ctx);
-void cryptonight_lite_av4_softaes_double(const void* input, size_t size, void* output, struct cryptonight_ctx* ctx);
+
+static void cryptonight_lite_av4_softaes_double(const void *input, size_t size, void *output, cryptonight_ctx *ctx) {
+    cryptonight_double_hash<0x40000, MEMORY_LITE, 0xFFFF0, true>(input, size, output, ctx);
+}
 
 
 static char hash[64];
@@ -42,12 +47,12 @@ static char hash[64];
 
 static char *bin2hex(const unsigned char *p, size_t len)
 {
-    char *s = malloc((len * 2) + 1);
+    char *s = static_cast<char*>(malloc((len * 2) + 1));
     if (!s) {
         return NULL;
     }
 
-    for (int i = 0; i < len; i++) {
+    for (size_t i = 0; i < len; i++) {
         sprintf(s + (i * 2), "%02x", (unsigned int) p[i]);
     }
 
@@ -72,8 +77,8 @@ static void free_ctx(struct cryptonight_ctx *ctx) {
 void test_cryptonight_lite_av1_should_CalcHash(void) {
     struct cryptonight_ctx *ctx = (struct cryptonight_ctx*) create_ctx(1);
 
-    cryptonight_lite_av1_aesni(input1, 76, &hash, ctx);
-    TEST_ASSERT_EQUAL_STRING(RESULT1, bin2hex(hash, 32));
+    cryptonight_lite_av1_aesni(input1, 76, hash, ctx);
+    TEST_ASSERT_EQUAL_STRING(RESULT1, bin2hex(reinterpret_cast<const unsigned char*>(hash), 32));
 
     free_ctx(ctx);
 }
@@ -83,8 +88,8 @@ void test_cryptonight_lite_av2_should_CalcHash(void)
 {
     struct cryptonight_ctx *ctx = (struct cryptonight_ctx*) create_ctx(2);
 
-    cryptonight_lite_av2_aesni_double(input1, 76, &hash, ctx);
-    TEST_ASSERT_EQUAL_STRING(RESULT1_DOUBLE, bin2hex(hash, 64));
+    cryptonight_lite_av2_aesni_double(input1, 76, hash, ctx);
+    TEST_ASSERT_EQUAL_STRING(RESULT1_DOUBLE, bin2hex(reinterpret_cast<const unsigned char*>(hash), 64));
 
     free_ctx(ctx);
 }
@@ -93,8 +98,8 @@ void test_cryptonight_lite_av2_should_CalcHash(void)
 void test_cryptonight_lite_av3_should_CalcHash(void) {
     struct cryptonight_ctx *ctx = (struct cryptonight_ctx*) create_ctx(1);
 
-    cryptonight_lite_av3_softaes(input1, 76, &hash, ctx);
-    TEST_ASSERT_EQUAL_STRING(RESULT1, bin2hex(hash, 32));
+    cryptonight_lite_av3_softaes(input1, 76, hash, ctx);
+    TEST_ASSERT_EQUAL_STRING(RESULT1, bin2hex(reinterpret_cast<const unsigned char*>(hash), 32));
 
     free_ctx(ctx);
 }
@@ -104,8 +109,8 @@ void test_cryptonight_lite_av4_should_CalcHash(void)
 {
     struct cryptonight_ctx *ctx = (struct cryptonight_ctx*) create_ctx(2);
 
-    cryptonight_lite_av4_softaes_double(input1, 76, &hash, ctx);
-    TEST_ASSERT_EQUAL_STRING(RESULT1_DOUBLE, bin2hex(hash, 64));
+    cryptonight_lite_av4_softaes_double(input1, 76, hash, ctx);
+    TEST_ASSERT_EQUAL_STRING(RESULT1_DOUBLE, bin2hex(reinterpret_cast<const unsigned char*>(hash), 64));
 
     free_ctx(ctx);
 }
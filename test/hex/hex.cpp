@@ -0,0 +1,146 @@
+#include <unity.h>
+#include <inttypes.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "net/Hex.h"
+#include "net/SubmitTemplate.h"
+#include "rapidjson/document.h"
+
+
+static void reference(const uint8_t *in, size_t len, char *out)
+{
+    for (size_t i = 0; i < len; ++i) {
+        snprintf(out + i * 2, 3, "%02x", in[i]);
+    }
+}
+
+
+void test_encode_should_MatchReference(void)
+{
+    uint8_t data[256];
+    char expected[513];
+    char actual[513];
+
+    for (size_t i = 0; i < sizeof(data); ++i) {
+        data[i] = (uint8_t) i;
+    }
+
+    for (size_t len = 0; len <= sizeof(data); ++len) {
+        memset(actual, 0, sizeof(actual));
+        memset(expected, 0, sizeof(expected));
+
+        reference(data + sizeof(data) - len, len, expected);
+        Hex::encode(data + sizeof(data) - len, len, actual);
+
+        TEST_ASSERT_EQUAL_STRING(expected, actual);
+    }
+}
+
+
+void test_round_trip_should_RestoreInput(void)
+{
+    uint8_t data[200];
+    uint8_t decoded[200];
+    char hex[400];
+
+    srand(1);
+    for (size_t len = 0; len <= sizeof(data); ++len) {
+        for (size_t i = 0; i < len; ++i) {
+            data[i] = (uint8_t) rand();
+        }
+
+        Hex::encode(data, len, hex);
+        TEST_ASSERT_TRUE(Hex::decode(hex, len * 2, decoded));
+        if (len > 0) {
+            TEST_ASSERT_EQUAL_MEMORY(data, decoded, len);
+        }
+    }
+}
+
+
+void test_decode_should_AcceptUpperCase(void)
+{
+    const char *hex = "0123456789ABCDEFabcdefAbCdEf0123456789abcdefABCDEF00";
+    uint8_t out[26];
+    const uint8_t expected[26] = {
+        0x01, 0x23, 0x45, 0x67, 0x89, 0xab, 0xcd, 0xef, 0xab, 0xcd, 0xef, 0xab, 0xcd,
+        0xef, 0x01, 0x23, 0x45, 0x67, 0x89, 0xab, 0xcd, 0xef, 0xab, 0xcd, 0xef, 0x00
+    };
+
+    TEST_ASSERT_TRUE(Hex::decode(hex, strlen(hex), out));
+    TEST_ASSERT_EQUAL_MEMORY(expected, out, sizeof(expected));
+}
+
+
+void test_decode_should_RejectInvalidCharacter(void)
+{
+    static const char invalid[] = { '/', ':', '@', 'G', '`', 'g', ' ', '\0', '\x80', '\xff', 'x' };
+    char hex[96];
+    uint8_t out[48];
+
+    for (size_t pos = 0; pos < sizeof(hex); ++pos) {
+        for (size_t i = 0; i < sizeof(invalid); ++i) {
+            memset(hex, 'a', sizeof(hex));
+            hex[pos] = invalid[i];
+
+            TEST_ASSERT_FALSE(Hex::decode(hex, sizeof(hex), out));
+        }
+    }
+
+    TEST_ASSERT_FALSE(Hex::decode("abc", 3, out));
+}
+
+
+void test_submit_template_should_ProduceValidRequest(void)
+{
+    SubmitTemplate tpl;
+    char buf[SubmitTemplate::kMaxSize];
+    uint8_t result[32];
+
+    for (size_t i = 0; i < sizeof(result); ++i) {
+        result[i] = (uint8_t) (i * 7);
+    }
+
+    const uint64_t ids[] = { 1, 9, 10, 12345, 18446744073709551615ULL };
+    const char *jobs[]  = { "job1", "job1", "another-job", "another-job", "j" };
+
+    for (size_t n = 0; n < sizeof(ids) / sizeof(ids[0]); ++n) {
+        const uint32_t nonce = 0xdeadbeef + (uint32_t) n;
+        const size_t size    = tpl.write(buf, ids[n], "rpc-id", JobId(jobs[n]), nonce, result);
+
+        TEST_ASSERT_EQUAL(strlen(buf), size);
+        TEST_ASSERT_EQUAL('\n', buf[size - 1]);
+
+        rapidjson::Document doc;
+        doc.Parse(buf);
+        TEST_ASSERT_FALSE(doc.HasParseError());
+
+        char nonceHex[9] = { 0 };
+        char resultHex[65] = { 0 };
+        Hex::encode(reinterpret_cast<const uint8_t*>(&nonce), 4, nonceHex);
+        Hex::encode(result, 32, resultHex);
+
+        TEST_ASSERT_EQUAL_UINT64(ids[n], doc["id"].GetUint64());
+        TEST_ASSERT_EQUAL_STRING("submit", doc["method"].GetString());
+        TEST_ASSERT_EQUAL_STRING("rpc-id", doc["params"]["id"].GetString());
+        TEST_ASSERT_EQUAL_STRING(jobs[n], doc["params"]["job_id"].GetString());
+        TEST_ASSERT_EQUAL_STRING(nonceHex, doc["params"]["nonce"].GetString());
+        TEST_ASSERT_EQUAL_STRING(resultHex, doc["params"]["result"].GetString());
+    }
+}
+
+
+int main(void)
+{
+    UNITY_BEGIN();
+
+    RUN_TEST(test_encode_should_MatchReference);
+    RUN_TEST(test_round_trip_should_RestoreInput);
+    RUN_TEST(test_decode_should_AcceptUpperCase);
+    RUN_TEST(test_decode_should_RejectInvalidCharacter);
+    RUN_TEST(test_submit_template_should_ProduceValidRequest);
+
+    return UNITY_END();
+}
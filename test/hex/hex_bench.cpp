@@ -0,0 +1,93 @@
+#include <chrono>
+#include <stdint.h>
+#include <stdio.h>
+
+#include "net/Hex.h"
+
+
+static const int kIterations = 200000;
+static const size_t kSize    = 76;
+
+
+static inline unsigned char hexToBin(char c, bool &err)
+{
+    if (c >= '0' && c <= '9') {
+        return c - '0';
+    }
+    else if (c >= 'a' && c <= 'f') {
+        return c - 'a' + 0xA;
+    }
+    else if (c >= 'A' && c <= 'F') {
+        return c - 'A' + 0xA;
+    }
+
+    err = true;
+    return 0;
+}
+
+
+static inline char binToHex(unsigned char c)
+{
+    return c <= 0x9 ? '0' + c : 'a' - 0xA + c;
+}
+
+
+static bool legacyDecode(const char *in, size_t len, uint8_t *out)
+{
+    bool error = false;
+    for (size_t i = 0; i < len; i += 2) {
+        out[i / 2] = (hexToBin(in[i], error) << 4) | hexToBin(in[i + 1], error);
+
+        if (error) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+
+static void legacyEncode(const uint8_t *in, size_t len, char *out)
+{
+    for (size_t i = 0; i < len; i++) {
+        out[i * 2]     = binToHex((in[i] & 0xF0) >> 4);
+        out[i * 2 + 1] = binToHex(in[i] & 0x0F);
+    }
+}
+
+
+template<typename Func>
+static double measure(Func func)
+{
+    const auto start = std::chrono::steady_clock::now();
+
+    for (int n = 0; n < kIterations; ++n) {
+        func(n);
+    }
+
+    const auto elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start);
+    return (double) elapsed.count() / kIterations;
+}
+
+
+int main(void)
+{
+    static uint8_t blob[kSize];
+    static char hex[kSize * 2];
+    volatile unsigned sink = 0;
+
+    for (size_t i = 0; i < kSize; ++i) {
+        blob[i] = (uint8_t) (i * 31 + 7);
+    }
+
+    const double encode = measure([&](int n) { blob[0] = (uint8_t) n; Hex::encode(blob, kSize, hex); sink += hex[1]; });
+    const double legacy = measure([&](int n) { blob[0] = (uint8_t) n; legacyEncode(blob, kSize, hex); sink += hex[1]; });
+
+    const double decode        = measure([&](int n) { hex[0] = "0123456789abcdef"[n & 15]; sink += Hex::decode(hex, kSize * 2, blob) + blob[0]; });
+    const double legacyDecoded = measure([&](int n) { hex[0] = "0123456789abcdef"[n & 15]; sink += legacyDecode(hex, kSize * 2, blob) + blob[0]; });
+
+    printf("encode %zu bytes: %.1f ns (legacy %.1f ns, %.2fx, %.2f GB/s)\n", kSize, encode, legacy, legacy / encode, kSize / encode);
+    printf("decode %zu bytes: %.1f ns (legacy %.1f ns, %.2fx, %.2f GB/s)\n", kSize, decode, legacyDecoded, legacyDecoded / decode, kSize / decode);
+
+    return 0;
+}
@@ -0,0 +1,146 @@
+#include <unity.h>
+#include <algorithm>
+#include <vector>
+
+#include "api/LatencyHistogram.h"
+
+
+static uint32_t exact(std::vector<uint32_t> values, double q)
+{
+    std::sort(values.begin(), values.end());
+
+    size_t rank = (size_t) (q * values.size() + 0.999999);
+    if (rank == 0) {
+        rank = 1;
+    }
+
+    return values[rank - 1];
+}
+
+
+static void assertClose(uint32_t expected, uint32_t actual)
+{
+    const double error = expected > actual ? expected - actual : actual - expected;
+
+    TEST_ASSERT_TRUE(error <= 1.0 || error / expected <= 1.0 / (2 << LatencyHistogram::kSubBits));
+}
+
+
+void test_empty_should_ReturnZero(void)
+{
+    LatencyHistogram histogram;
+
+    TEST_ASSERT_EQUAL_UINT64(0, histogram.count());
+    TEST_ASSERT_EQUAL_UINT64(0, histogram.sum());
+    TEST_ASSERT_EQUAL_UINT32(0, histogram.quantile(0.5));
+    TEST_ASSERT_EQUAL_UINT32(0, histogram.max());
+}
+
+
+void test_index_should_BeMonotonicAndInRange(void)
+{
+    size_t prev = 0;
+
+    for (uint32_t value = 0; value <= LatencyHistogram::kMaxValue; ++value) {
+        const size_t index = LatencyHistogram::index(value);
+
+        TEST_ASSERT_TRUE(index >= prev);
+        TEST_ASSERT_TRUE(index < LatencyHistogram::kBuckets);
+        prev = index;
+    }
+
+    TEST_ASSERT_EQUAL(LatencyHistogram::kBuckets - 1, LatencyHistogram::index(0xFFFFFFFF));
+}
+
+
+void test_small_values_should_BeExact(void)
+{
+    LatencyHistogram histogram;
+    for (uint32_t value = 1; value <= 9; ++value) {
+        histogram.add(value);
+    }
+
+    TEST_ASSERT_EQUAL_UINT32(5, histogram.quantile(0.5));
+    TEST_ASSERT_EQUAL_UINT32(9, histogram.quantile(1.0));
+    TEST_ASSERT_EQUAL_UINT32(9, histogram.max());
+    TEST_ASSERT_EQUAL_UINT64(45, histogram.sum());
+}
+
+
+void test_quantiles_should_MatchExactWithinBucketError(void)
+{
+    LatencyHistogram histogram;
+    std::vector<uint32_t> values;
+
+    uint32_t seed = 12345;
+    for (int i = 0; i < 100000; ++i) {
+        seed = seed * 1103515245 + 12345;
+
+        // long tail: most responses fast, some very slow.
+        const uint32_t value = (seed >> 16) % 100 < 95 ? 20 + (seed >> 8) % 200 : 500 + (seed >> 4) % 20000;
+        histogram.add(value);
+        values.push_back(value);
+    }
+
+    assertClose(exact(values, 0.5),  histogram.quantile(0.5));
+    assertClose(exact(values, 0.9),  histogram.quantile(0.9));
+    assertClose(exact(values, 0.99), histogram.quantile(0.99));
+    TEST_ASSERT_EQUAL_UINT32(*std::max_element(values.begin(), values.end()), histogram.max());
+}
+
+
+void test_memory_should_StayBounded(void)
+{
+    LatencyHistogram histogram;
+    const size_t size = sizeof(histogram);
+
+    for (uint32_t i = 0; i < 5000000; ++i) {
+        histogram.add(i % 70000);
+    }
+
+    TEST_ASSERT_EQUAL(size, sizeof(histogram));
+    TEST_ASSERT_TRUE(sizeof(LatencyHistogram) <= 1024);
+    TEST_ASSERT_EQUAL_UINT64(5000000, histogram.count());
+    TEST_ASSERT_EQUAL_UINT32(LatencyHistogram::kMaxValue, histogram.max());
+}
+
+
+void test_merge_should_CombineSamples(void)
+{
+    LatencyHistogram a;
+    LatencyHistogram b;
+
+    for (int i = 0; i < 100; ++i) {
+        a.add(10);
+        b.add(1000);
+    }
+
+    b.add(3000);
+    a.merge(b);
+
+    TEST_ASSERT_EQUAL_UINT64(201, a.count());
+    TEST_ASSERT_EQUAL_UINT64(104000, a.sum());
+    TEST_ASSERT_EQUAL_UINT32(10, a.quantile(0.4));
+    assertClose(1000, a.quantile(0.9));
+    TEST_ASSERT_EQUAL_UINT32(3000, a.max());
+
+    a.reset();
+    TEST_ASSERT_EQUAL_UINT64(0, a.count());
+    TEST_ASSERT_EQUAL_UINT64(0, a.sum());
+    TEST_ASSERT_EQUAL_UINT32(0, a.quantile(0.99));
+}
+
+
+int main(void)
+{
+    UNITY_BEGIN();
+
+    RUN_TEST(test_empty_should_ReturnZero);
+    RUN_TEST(test_index_should_BeMonotonicAndInRange);
+    RUN_TEST(test_small_values_should_BeExact);
+    RUN_TEST(test_quantiles_should_MatchExactWithinBucketError);
+    RUN_TEST(test_memory_should_StayBounded);
+    RUN_TEST(test_merge_should_CombineSamples);
+
+    return UNITY_END();
+}
@@ -0,0 +1,146 @@
+#ifndef __HARNESS_H__
+#define __HARNESS_H__
+
+
+#include <string>
+#include <uv.h>
+#include <vector>
+
+#include "interfaces/IClientListener.h"
+#include "interfaces/IStrategy.h"
+#include "interfaces/IStrategyListener.h"
+#include "net/Client.h"
+#include "net/Job.h"
+#include "net/SubmitResult.h"
+
+
+/**
+ * Records client and strategy events with uv_hrtime() timestamps.
+ */
+class Listener : public IClientListener, public IStrategyListener
+{
+public:
+    inline Listener() : accepted(0), active(-1), closes(0), failures(0), jobs(0), logins(0), pauses(0), rejected(0), elapsed(0), activeTime(0), jobTime(0), loginTime(0), resultTime(0) {}
+
+    inline void onClose(Client *client, int failures) override
+    {
+        closes++;
+        this->failures = failures;
+
+        if (client->error()[0]) {
+            error = client->error();
+        }
+    }
+
+    inline void onJobReceived(Client *client, const Job &job) override
+    {
+        jobs++;
+        jobId   = job.id().data();
+        jobTime = uv_hrtime();
+    }
+
+    inline void onLoginSuccess(Client *client) override
+    {
+        logins++;
+        loginTime = uv_hrtime();
+    }
+
+    inline void onResultAccepted(Client *client, const SubmitResult &result, const char *error) override
+    {
+        error ? rejected++ : accepted++;
+        elapsed    = result.elapsed;
+        resultTime = uv_hrtime();
+
+        if (error) {
+            this->error = error;
+        }
+    }
+
+    inline void onActive(Client *client) override
+    {
+        active     = client->id();
+        activeTime = uv_hrtime();
+    }
+
+    inline void onJob(Client *client, const Job &job) override    { onJobReceived(client, job); }
+    inline void onPause(IStrategy *strategy) override             { pauses++; }
+    inline void onWeights(const std::vector<int> &weights) override {}
+
+    int accepted;
+    int active;
+    int closes;
+    int failures;
+    int jobs;
+    int logins;
+    int pauses;
+    int rejected;
+    std::string error;
+    std::string jobId;
+    uint64_t elapsed;
+    uint64_t activeTime;
+    uint64_t jobTime;
+    uint64_t loginTime;
+    uint64_t resultTime;
+};
+
+
+/**
+ * @brief Run default loop until condition is true or timeout in milliseconds expired.
+ *
+ * Clients and strategies have no timers for reconnect, tick() is called every millisecond
+ * as Network does every second.
+ */
+template<typename Cond>
+static bool wait(Cond cond, uint64_t timeout, const std::vector<Client*> &clients = {}, IStrategy *strategy = nullptr)
+{
+    struct Ticker
+    {
+        const std::vector<Client*> *clients;
+        IStrategy *strategy;
+    };
+
+    Ticker ticker = { &clients, strategy };
+    uv_timer_t timer;
+    uv_timer_init(uv_default_loop(), &timer);
+    timer.data = &ticker;
+
+    uv_timer_start(&timer, [](uv_timer_t *handle) {
+        const Ticker *ticker = static_cast<const Ticker*>(handle->data);
+        const uint64_t now   = uv_now(uv_default_loop());
+
+        for (Client *client : *ticker->clients) {
+            client->tick(now);
+        }
+
+        if (ticker->strategy) {
+            ticker->strategy->tick(now);
+        }
+    }, 1, 1);
+
+    const uint64_t end = uv_now(uv_default_loop()) + timeout;
+    bool result = cond();
+
+    while (!result && uv_now(uv_default_loop()) < end) {
+        uv_run(uv_default_loop(), UV_RUN_ONCE);
+        result = cond();
+    }
+
+    uv_close(reinterpret_cast<uv_handle_t*>(&timer), nullptr);
+    uv_run(uv_default_loop(), UV_RUN_NOWAIT);
+
+    return result;
+}
+
+
+/**
+ * @brief Let pending close callbacks run.
+ */
+static inline void settle()
+{
+    for (int i = 0; i < 8; ++i) {
+        uv_run(uv_default_loop(), UV_RUN_NOWAIT);
+    }
+}
+
+
+#endif /* __HARNESS_H__ */
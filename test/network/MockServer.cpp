@@ -0,0 +1,275 @@
+#include <stdio.h>
+#include <string.h>
+
+#include "MockServer.h"
+#include "rapidjson/document.h"
+
+
+static const char *kBlob = "0305a0dbd6bf05cf16e503f3a66f78007cbf34144332ecbfc22ed95c8700383b309ace1923a0964b00000000ba939a62724c0d7581fce5761e9d8a0e6a1c3f924fdd8493d1115649c05eb6";
+
+
+MockServer::MockServer() :
+    accepted(0),
+    logins(0),
+    rejected(0),
+    submits(0),
+    m_listening(false),
+    m_login(Accept),
+    m_submit(Accept),
+    m_port(0),
+    m_delay(0),
+    m_jobs(0),
+    m_sequence(0)
+{
+    memset(m_jobId, 0, sizeof(m_jobId));
+}
+
+
+MockServer::~MockServer()
+{
+}
+
+
+bool MockServer::start(uint16_t port)
+{
+    sockaddr_in addr;
+    uv_ip4_addr("127.0.0.1", port, &addr);
+
+    uv_tcp_init(uv_default_loop(), &m_server);
+    m_server.data = this;
+
+    if (uv_tcp_bind(&m_server, reinterpret_cast<const sockaddr*>(&addr), 0) != 0 ||
+        uv_listen(reinterpret_cast<uv_stream_t*>(&m_server), 16, MockServer::onConnection) != 0) {
+        uv_close(reinterpret_cast<uv_handle_t*>(&m_server), nullptr);
+        return false;
+    }
+
+    sockaddr_storage name;
+    int len = sizeof(name);
+    uv_tcp_getsockname(&m_server, reinterpret_cast<sockaddr*>(&name), &len);
+
+    m_port      = ntohs(reinterpret_cast<sockaddr_in*>(&name)->sin_port);
+    m_listening = true;
+    return true;
+}
+
+
+/**
+ * @brief Drop all client connections, server keeps listening.
+ */
+void MockServer::disconnect()
+{
+    while (!m_connections.empty()) {
+        close(m_connections.back());
+    }
+}
+
+
+/**
+ * @brief Send new job to all logged in connections.
+ */
+void MockServer::pushJob()
+{
+    const std::string params = job();
+
+    for (Connection *connection : m_connections) {
+        if (connection->logged) {
+            write(connection, "{\"jsonrpc\":\"2.0\",\"method\":\"job\",\"params\":" + params + "}\n");
+        }
+    }
+}
+
+
+void MockServer::stop()
+{
+    disconnect();
+
+    if (m_listening) {
+        m_listening = false;
+        uv_close(reinterpret_cast<uv_handle_t*>(&m_server), nullptr);
+    }
+}
+
+
+MockServer::Connection *MockServer::find(uint64_t id) const
+{
+    for (Connection *connection : m_connections) {
+        if (connection->id == id) {
+            return connection;
+        }
+    }
+
+    return nullptr;
+}
+
+
+std::string MockServer::job()
+{
+    char blob[160];
+    snprintf(blob, sizeof(blob), "%s%08x", kBlob, (unsigned) ++m_jobs);
+    snprintf(m_jobId, sizeof(m_jobId), "job%u", (unsigned) m_jobs);
+
+    return std::string("{\"blob\":\"") + blob + "\",\"job_id\":\"" + m_jobId + "\",\"target\":\"ffffff7f\"}";
+}
+
+
+void MockServer::close(Connection *connection)
+{
+    for (auto it = m_connections.begin(); it != m_connections.end(); ++it) {
+        if (*it == connection) {
+            m_connections.erase(it);
+            break;
+        }
+    }
+
+    uv_close(reinterpret_cast<uv_handle_t*>(&connection->socket), [](uv_handle_t *handle) {
+        delete static_cast<Connection*>(handle->data);
+    });
+}
+
+
+void MockServer::onLine(Connection *connection, const char *line)
+{
+    rapidjson::Document doc;
+    if (doc.Parse(line).HasParseError() || !doc.IsObject() || !doc.HasMember("id") || !doc.HasMember("method")) {
+        return;
+    }
+
+    const int64_t id     = doc["id"].GetInt64();
+    const char *method   = doc["method"].GetString();
+    const std::string rpc = "{\"id\":" + std::to_string(id) + ",\"jsonrpc\":\"2.0\",";
+
+    if (strcmp(method, "login") == 0) {
+        logins++;
+
+        if (m_login == Accept) {
+            connection->logged = true;
+            return reply(connection, rpc + "\"error\":null,\"result\":{\"id\":\"mock\",\"job\":" + job() + ",\"status\":\"OK\"}}\n");
+        }
+
+        if (m_login == Reject) {
+            return reply(connection, rpc + "\"error\":{\"code\":-1,\"message\":\"Invalid address used for login\"}}\n");
+        }
+
+        return;
+    }
+
+    if (strcmp(method, "submit") == 0) {
+        submits++;
+
+        if (m_submit == Accept) {
+            accepted++;
+            return reply(connection, rpc + "\"error\":null,\"result\":{\"status\":\"OK\"}}\n");
+        }
+
+        if (m_submit == Reject) {
+            rejected++;
+            return reply(connection, rpc + "\"error\":{\"code\":-1,\"message\":\"Low difficulty share\"}}\n");
+        }
+
+        return;
+    }
+
+    reply(connection, rpc + "\"error\":null,\"result\":{\"status\":\"KEEPALIVED\"}}\n");
+}
+
+
+void MockServer::reply(Connection *connection, const std::string &data)
+{
+    if (m_delay == 0) {
+        return write(connection, data);
+    }
+
+    Delayed *delayed = new Delayed();
+    delayed->server  = this;
+    delayed->data    = data;
+    delayed->id      = connection->id;
+
+    uv_timer_init(uv_default_loop(), &delayed->timer);
+    delayed->timer.data = delayed;
+
+    uv_timer_start(&delayed->timer, [](uv_timer_t *handle) {
+        Delayed *delayed       = static_cast<Delayed*>(handle->data);
+        Connection *connection = delayed->server->find(delayed->id);
+
+        if (connection) {
+            delayed->server->write(connection, delayed->data);
+        }
+
+        uv_close(reinterpret_cast<uv_handle_t*>(handle), [](uv_handle_t *handle) { delete static_cast<Delayed*>(handle->data); });
+    }, m_delay, 0);
+}
+
+
+void MockServer::write(Connection *connection, const std::string &data)
+{
+    uv_buf_t buf = uv_buf_init(const_cast<char*>(data.data()), (unsigned int) data.size());
+
+    // replies are small, anything not accepted by the kernel at once is a test failure anyway.
+    if (uv_try_write(reinterpret_cast<uv_stream_t*>(&connection->socket), &buf, 1) != (int) data.size()) {
+        close(connection);
+    }
+}
+
+
+void MockServer::onAlloc(uv_handle_t *handle, size_t suggested_size, uv_buf_t *buf)
+{
+    static char storage[65536];
+
+    buf->base = storage;
+    buf->len  = sizeof(storage);
+}
+
+
+void MockServer::onConnection(uv_stream_t *server, int status)
+{
+    if (status < 0) {
+        return;
+    }
+
+    MockServer *self       = static_cast<MockServer*>(server->data);
+    Connection *connection = new Connection();
+    connection->logged     = false;
+    connection->server     = self;
+    connection->id         = ++self->m_sequence;
+
+    uv_tcp_init(uv_default_loop(), &connection->socket);
+    connection->socket.data = connection;
+
+    if (uv_accept(server, reinterpret_cast<uv_stream_t*>(&connection->socket)) != 0) {
+        uv_close(reinterpret_cast<uv_handle_t*>(&connection->socket), [](uv_handle_t *handle) { delete static_cast<Connection*>(handle->data); });
+        return;
+    }
+
+    self->m_connections.push_back(connection);
+    uv_read_start(reinterpret_cast<uv_stream_t*>(&connection->socket), MockServer::onAlloc, MockServer::onRead);
+}
+
+
+void MockServer::onRead(uv_stream_t *stream, ssize_t nread, const uv_buf_t *buf)
+{
+    Connection *connection = static_cast<Connection*>(stream->data);
+    MockServer *self       = connection->server;
+
+    if (nread < 0) {
+        self->close(connection);
+        return;
+    }
+
+    connection->buf.append(buf->base, (size_t) nread);
+
+    size_t pos;
+    const uint64_t id = connection->id;
+
+    while ((pos = connection->buf.find('\n')) != std::string::npos) {
+        const std::string line = connection->buf.substr(0, pos);
+        connection->buf.erase(0, pos + 1);
+
+        self->onLine(connection, line.c_str());
+
+        // connection may be closed by failed write.
+        if (!self->find(id)) {
+            return;
+        }
+    }
+}
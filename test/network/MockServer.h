@@ -0,0 +1,88 @@
+#ifndef __MOCKSERVER_H__
+#define __MOCKSERVER_H__
+
+
+#include <stdint.h>
+#include <string>
+#include <uv.h>
+#include <vector>
+
+
+/**
+ * Scripted stratum pool on 127.0.0.1, runs on the default loop next to clients under test.
+ *
+ * Answers login and submit with configured replies after optional delay, pushes jobs
+ * and drops connections on request, counts everything it receives.
+ */
+class MockServer
+{
+public:
+    enum Reply {
+        Accept,
+        Reject,
+        Silent
+    };
+
+    MockServer();
+    ~MockServer();
+
+    bool start(uint16_t port = 0);
+    void disconnect();
+    void pushJob();
+    void stop();
+
+    inline const char *jobId() const        { return m_jobId; }
+    inline int connections() const          { return (int) m_connections.size(); }
+    inline uint16_t port() const            { return m_port; }
+    inline void setDelay(uint64_t delay)    { m_delay = delay; }
+    inline void setLogin(Reply reply)       { m_login = reply; }
+    inline void setSubmit(Reply reply)      { m_submit = reply; }
+
+    int accepted;
+    int logins;
+    int rejected;
+    int submits;
+
+private:
+    struct Connection
+    {
+        bool logged;
+        MockServer *server;
+        std::string buf;
+        uint64_t id;
+        uv_tcp_t socket;
+    };
+
+    struct Delayed
+    {
+        MockServer *server;
+        std::string data;
+        uint64_t id;
+        uv_timer_t timer;
+    };
+
+    Connection *find(uint64_t id) const;
+    std::string job();
+    void close(Connection *connection);
+    void onLine(Connection *connection, const char *line);
+    void reply(Connection *connection, const std::string &data);
+    void write(Connection *connection, const std::string &data);
+
+    static void onAlloc(uv_handle_t *handle, size_t suggested_size, uv_buf_t *buf);
+    static void onConnection(uv_stream_t *server, int status);
+    static void onRead(uv_stream_t *stream, ssize_t nread, const uv_buf_t *buf);
+
+    bool m_listening;
+    char m_jobId[32];
+    Reply m_login;
+    Reply m_submit;
+    std::vector<Connection*> m_connections;
+    uint16_t m_port;
+    uint64_t m_delay;
+    uint64_t m_jobs;
+    uint64_t m_sequence;
+    uv_tcp_t m_server;
+};
+
+
+#endif /* __MOCKSERVER_H__ */
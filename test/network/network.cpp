@@ -0,0 +1,299 @@
+#include <unity.h>
+#include <getopt.h>
+#include <string.h>
+
+#include "Harness.h"
+#include "log/Log.h"
+#include "MockServer.h"
+#include "net/JobResult.h"
+#include "net/strategies/FailoverStrategy.h"
+#include "net/Url.h"
+#include "Options.h"
+
+
+static const uint8_t result[32] = {
+    0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11,
+    0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11
+};
+
+
+static void parseOptions(const char *standby)
+{
+    const char *args[] = { "xmrig", "-o", "127.0.0.1:3333", "--retries=1", "--retry-pause=1", "--donate-level=1", "-t", "1", "--av=1", standby };
+
+    optind = 0;
+    Options::release();
+    Options::parse(sizeof(args) / sizeof(args[0]), const_cast<char**>(args));
+}
+
+
+static Client *create(int id, Listener &listener, const MockServer &server)
+{
+    Url url("127.0.0.1", server.port());
+
+    Client *client = new Client(id, "test", &listener);
+    client->setQuiet(true);
+    client->setRetryPause(50);
+    client->connect(&url);
+
+    return client;
+}
+
+
+static void destroy(Client *client)
+{
+    client->disconnect();
+    wait([&]() { return client->state() == Client::UnconnectedState; }, 1000);
+    settle();
+}
+
+
+void test_login_should_DeliverFirstJob(void)
+{
+    MockServer server;
+    TEST_ASSERT_TRUE(server.start());
+
+    Listener listener;
+    Client *client = create(0, listener, server);
+
+    TEST_ASSERT_TRUE(wait([&]() { return listener.jobs == 1; }, 2000, { client }));
+    TEST_ASSERT_EQUAL(1, listener.logins);
+    TEST_ASSERT_EQUAL(1, server.logins);
+    TEST_ASSERT_EQUAL_STRING(server.jobId(), listener.jobId.c_str());
+    TEST_ASSERT_TRUE(client->isReady());
+
+    destroy(client);
+    server.stop();
+    settle();
+}
+
+
+void test_push_should_SwitchJob(void)
+{
+    MockServer server;
+    TEST_ASSERT_TRUE(server.start());
+
+    Listener listener;
+    Client *client = create(0, listener, server);
+    TEST_ASSERT_TRUE(wait([&]() { return listener.jobs == 1; }, 2000, { client }));
+
+    for (int i = 2; i <= 5; ++i) {
+        server.pushJob();
+        TEST_ASSERT_TRUE(wait([&]() { return listener.jobs == i; }, 2000, { client }));
+        TEST_ASSERT_EQUAL_STRING(server.jobId(), client->job().id().data());
+    }
+
+    destroy(client);
+    server.stop();
+    settle();
+}
+
+
+void test_submit_should_ReportAcceptedAndRejected(void)
+{
+    MockServer server;
+    TEST_ASSERT_TRUE(server.start());
+
+    Listener listener;
+    Client *client = create(0, listener, server);
+    TEST_ASSERT_TRUE(wait([&]() { return listener.jobs == 1; }, 2000, { client }));
+
+    TEST_ASSERT_TRUE(client->submit(JobResult(0, client->job().id(), 1, result, 1000)) > 0);
+    TEST_ASSERT_TRUE(wait([&]() { return listener.accepted == 1; }, 2000, { client }));
+
+    server.setSubmit(MockServer::Reject);
+    TEST_ASSERT_TRUE(client->submit(JobResult(0, client->job().id(), 2, result, 1000)) > 0);
+    TEST_ASSERT_TRUE(wait([&]() { return listener.rejected == 1; }, 2000, { client }));
+    TEST_ASSERT_EQUAL_STRING("Low difficulty share", listener.error.c_str());
+
+    TEST_ASSERT_EQUAL(2, server.submits);
+    TEST_ASSERT_TRUE(client->isReady());
+
+    destroy(client);
+    server.stop();
+    settle();
+}
+
+
+void test_slow_response_should_BeMeasured(void)
+{
+    MockServer server;
+    TEST_ASSERT_TRUE(server.start());
+
+    Listener listener;
+    Client *client = create(0, listener, server);
+    TEST_ASSERT_TRUE(wait([&]() { return listener.jobs == 1; }, 2000, { client }));
+
+    server.setDelay(200);
+    client->submit(JobResult(0, client->job().id(), 1, result, 1000));
+
+    TEST_ASSERT_FALSE(wait([&]() { return listener.accepted == 1; }, 100, { client }));
+    TEST_ASSERT_TRUE(wait([&]() { return listener.accepted == 1; }, 2000, { client }));
+    TEST_ASSERT_TRUE(listener.elapsed >= 190);
+
+    destroy(client);
+    server.stop();
+    settle();
+}
+
+
+void test_login_error_should_CloseConnection(void)
+{
+    MockServer server;
+    TEST_ASSERT_TRUE(server.start());
+    server.setLogin(MockServer::Reject);
+
+    Listener listener;
+    Client *client = create(0, listener, server);
+
+    TEST_ASSERT_TRUE(wait([&]() { return listener.closes >= 1; }, 2000, { client }));
+    TEST_ASSERT_EQUAL(0, listener.logins);
+    TEST_ASSERT_EQUAL_STRING("Invalid address used for login", listener.error.c_str());
+    TEST_ASSERT_FALSE(client->isReady());
+
+    destroy(client);
+    server.stop();
+    settle();
+}
+
+
+void test_disconnect_should_Reconnect(void)
+{
+    MockServer server;
+    TEST_ASSERT_TRUE(server.start());
+
+    Listener listener;
+    Client *client = create(0, listener, server);
+    TEST_ASSERT_TRUE(wait([&]() { return listener.logins == 1; }, 2000, { client }));
+
+    server.disconnect();
+    TEST_ASSERT_TRUE(wait([&]() { return listener.closes == 1; }, 2000, { client }));
+    TEST_ASSERT_TRUE(wait([&]() { return listener.logins == 2; }, 2000, { client }));
+    TEST_ASSERT_EQUAL(2, server.logins);
+    TEST_ASSERT_TRUE(client->isReady());
+
+    destroy(client);
+    server.stop();
+    settle();
+}
+
+
+void test_refused_should_RetryUntilServerIsBack(void)
+{
+    MockServer server;
+    TEST_ASSERT_TRUE(server.start());
+    const uint16_t port = server.port();
+    server.stop();
+    settle();
+
+    Listener listener;
+    Client *client = create(0, listener, server);
+    TEST_ASSERT_TRUE(wait([&]() { return listener.failures >= 2; }, 2000, { client }));
+
+    TEST_ASSERT_TRUE(server.start(port));
+    TEST_ASSERT_TRUE(wait([&]() { return listener.logins == 1; }, 2000, { client }));
+
+    destroy(client);
+    server.stop();
+    settle();
+}
+
+
+void test_failover_should_SwitchToBackupAndBack(void)
+{
+    MockServer primary;
+    MockServer backup;
+    TEST_ASSERT_TRUE(primary.start());
+    TEST_ASSERT_TRUE(backup.start());
+
+    const uint16_t port = primary.port();
+    std::vector<Url*> urls = { new Url("127.0.0.1", primary.port()), new Url("127.0.0.1", backup.port()) };
+
+    Listener listener;
+    FailoverStrategy strategy(urls, "test", &listener);
+    strategy.connect();
+
+    TEST_ASSERT_TRUE(wait([&]() { return listener.active == 0 && listener.jobs == 1; }, 2000, {}, &strategy));
+
+    primary.stop();
+    TEST_ASSERT_TRUE(wait([&]() { return listener.active == 1; }, 5000, {}, &strategy));
+    TEST_ASSERT_EQUAL_STRING(backup.jobId(), listener.jobId.c_str());
+
+    TEST_ASSERT_TRUE(primary.start(port));
+    TEST_ASSERT_TRUE(wait([&]() { return listener.active == 0; }, 5000, {}, &strategy));
+
+    strategy.stop();
+    settle();
+    primary.stop();
+    backup.stop();
+    settle();
+
+    for (Url *url : urls) {
+        delete url;
+    }
+}
+
+
+void test_standby_should_SwitchWithoutReconnect(void)
+{
+    parseOptions("--standby=1");
+
+    MockServer primary;
+    MockServer backup;
+    TEST_ASSERT_TRUE(primary.start());
+    TEST_ASSERT_TRUE(backup.start());
+
+    const uint16_t port = primary.port();
+    std::vector<Url*> urls = { new Url("127.0.0.1", primary.port()), new Url("127.0.0.1", backup.port()) };
+
+    Listener listener;
+    FailoverStrategy strategy(urls, "test", &listener);
+    strategy.connect();
+
+    // backup logged in and holds its job while primary is active.
+    TEST_ASSERT_TRUE(wait([&]() { return listener.active == 0 && backup.logins == 1; }, 2000, {}, &strategy));
+    TEST_ASSERT_EQUAL(1, backup.connections());
+
+    primary.stop();
+    TEST_ASSERT_TRUE(wait([&]() { return listener.active == 1; }, 2000, {}, &strategy));
+    TEST_ASSERT_EQUAL_STRING(backup.jobId(), listener.jobId.c_str());
+    TEST_ASSERT_EQUAL(1, backup.logins);
+
+    TEST_ASSERT_TRUE(primary.start(port));
+    TEST_ASSERT_TRUE(wait([&]() { return listener.active == 0; }, 5000, {}, &strategy));
+    TEST_ASSERT_EQUAL(1, backup.logins);
+    TEST_ASSERT_EQUAL(1, backup.connections());
+
+    strategy.stop();
+    settle();
+    primary.stop();
+    backup.stop();
+    settle();
+
+    for (Url *url : urls) {
+        delete url;
+    }
+
+    parseOptions("--standby=0");
+}
+
+
+int main(int argc, char **argv)
+{
+    parseOptions("--standby=0");
+    Log::init();
+
+    UNITY_BEGIN();
+
+    RUN_TEST(test_login_should_DeliverFirstJob);
+    RUN_TEST(test_push_should_SwitchJob);
+    RUN_TEST(test_submit_should_ReportAcceptedAndRejected);
+    RUN_TEST(test_slow_response_should_BeMeasured);
+    RUN_TEST(test_login_error_should_CloseConnection);
+    RUN_TEST(test_disconnect_should_Reconnect);
+    RUN_TEST(test_refused_should_RetryUntilServerIsBack);
+    RUN_TEST(test_failover_should_SwitchToBackupAndBack);
+    RUN_TEST(test_standby_should_SwitchWithoutReconnect);
+
+    return UNITY_END();
+}
@@ -0,0 +1,202 @@
+#include <algorithm>
+#include <getopt.h>
+#include <stdio.h>
+
+#include "Harness.h"
+#include "log/Log.h"
+#include "MockServer.h"
+#include "net/JobResult.h"
+#include "net/strategies/FailoverStrategy.h"
+#include "net/Url.h"
+#include "Options.h"
+
+
+static const int kJobs        = 1000;
+static const int kReconnects  = 100;
+static const int kSubmits     = 20000;
+static const int kFailovers   = 5;
+
+
+static const uint8_t result[32] = {
+    0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11,
+    0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11
+};
+
+
+static void report(const char *name, std::vector<double> &samples)
+{
+    std::sort(samples.begin(), samples.end());
+
+    double sum = 0;
+    for (double sample : samples) {
+        sum += sample;
+    }
+
+    printf("%-22s avg %8.1f us  p50 %8.1f us  p99 %8.1f us  max %8.1f us  (%u samples)\n", name,
+           sum / samples.size(), samples[samples.size() / 2], samples[samples.size() * 99 / 100], samples.back(), (unsigned) samples.size());
+}
+
+
+static Client *login(Listener &listener, MockServer &server)
+{
+    Url url("127.0.0.1", server.port());
+
+    Client *client = new Client(0, "bench", &listener);
+    client->setQuiet(true);
+    client->setRetryPause(1);
+    client->connect(&url);
+
+    wait([&]() { return listener.jobs == 1; }, 2000, { client });
+    return client;
+}
+
+
+/**
+ * @brief Time from job notification sent by pool to onJobReceived.
+ */
+static void jobSwitch()
+{
+    MockServer server;
+    server.start();
+
+    Listener listener;
+    Client *client = login(listener, server);
+
+    std::vector<double> samples;
+    for (int i = 0; i < kJobs; ++i) {
+        const int jobs       = listener.jobs;
+        const uint64_t start = uv_hrtime();
+
+        server.pushJob();
+        wait([&]() { return listener.jobs > jobs; }, 1000, { client });
+        samples.push_back((listener.jobTime - start) / 1000.0);
+    }
+
+    report("job switch", samples);
+
+    client->disconnect();
+    server.stop();
+    settle();
+}
+
+
+/**
+ * @brief Time from connection drop by pool to next successful login, retry pause is 1 ms.
+ */
+static void reconnect()
+{
+    MockServer server;
+    server.start();
+
+    Listener listener;
+    Client *client = login(listener, server);
+
+    std::vector<double> samples;
+    for (int i = 0; i < kReconnects; ++i) {
+        const int logins     = listener.logins;
+        const uint64_t start = uv_hrtime();
+
+        server.disconnect();
+        wait([&]() { return listener.logins > logins; }, 2000, { client });
+        samples.push_back((listener.loginTime - start) / 1000.0);
+    }
+
+    report("reconnect", samples);
+
+    client->disconnect();
+    server.stop();
+    settle();
+}
+
+
+/**
+ * @brief Pipelined submits, time until all results confirmed.
+ */
+static void submits()
+{
+    MockServer server;
+    server.start();
+
+    Listener listener;
+    Client *client = login(listener, server);
+
+    const uint64_t start = uv_hrtime();
+    int sent = 0;
+
+    while (listener.accepted < kSubmits) {
+        while (sent < kSubmits && sent - listener.accepted < 256) {
+            client->submit(JobResult(0, client->job().id(), sent++, result, 1000));
+        }
+
+        uv_run(uv_default_loop(), UV_RUN_ONCE);
+    }
+
+    const double elapsed = (uv_hrtime() - start) / 1e9;
+    printf("%-22s %8.0f submits/s  (%d submits, %.2f s)\n", "submit throughput", kSubmits / elapsed, kSubmits, elapsed);
+
+    client->disconnect();
+    server.stop();
+    settle();
+}
+
+
+/**
+ * @brief Time from primary pool loss to job from backup pool.
+ */
+static void failover(int standby)
+{
+    char arg[32];
+    snprintf(arg, sizeof(arg), "--standby=%d", standby);
+
+    const char *args[] = { "xmrig", "-o", "127.0.0.1:3333", "--retries=1", "--retry-pause=1", "--donate-level=1", "-t", "1", "--av=1", arg };
+
+    // options are parsed again with different standby value, getopt must restart.
+    optind = 0;
+    Options::parse(sizeof(args) / sizeof(args[0]), const_cast<char**>(args));
+
+    std::vector<double> samples;
+    for (int i = 0; i < kFailovers; ++i) {
+        MockServer primary;
+        MockServer backup;
+        primary.start();
+        backup.start();
+
+        std::vector<Url*> urls = { new Url("127.0.0.1", primary.port()), new Url("127.0.0.1", backup.port()) };
+
+        Listener listener;
+        FailoverStrategy strategy(urls, "bench", &listener);
+        strategy.connect();
+
+        wait([&]() { return listener.active == 0; }, 2000, {}, &strategy);
+        wait([&]() { return standby == 0 || backup.logins == 1; }, 2000, {}, &strategy);
+
+        const uint64_t start = uv_hrtime();
+        primary.stop();
+        wait([&]() { return listener.active == 1; }, 10000, {}, &strategy);
+        samples.push_back((listener.activeTime - start) / 1000.0);
+
+        strategy.stop();
+        backup.stop();
+        settle();
+
+        for (Url *url : urls) {
+            delete url;
+        }
+    }
+
+    report(standby ? "failover (standby=1)" : "failover (standby=0)", samples);
+}
+
+
+int main(int argc, char **argv)
+{
+    Log::init();
+
+    jobSwitch();
+    reconnect();
+    submits();
+    failover(0);
+    failover(1);
+
+    return 0;
+}
@@ -0,0 +1,125 @@
+#include <unity.h>
+#include <string.h>
+
+#include "net/PoolSelector.h"
+
+
+static const uint8_t blob[] = {
+    0x03, 0x05, 0xa0, 0xdb, 0xd6, 0xbf, 0x05, 0xcf, 0x16, 0xe5, 0x03, 0xf3, 0xa6, 0x6f, 0x78, 0x00,
+    0x7c, 0xbf, 0x34, 0x14, 0x43, 0x32, 0xec, 0xbf, 0xc2, 0x2e, 0xd9, 0x5c, 0x87, 0x00, 0x38, 0x3b,
+    0x30, 0x9a, 0xce, 0x19, 0x23, 0xa0, 0x96, 0x4b, 0x00, 0x00, 0x00, 0x00
+};
+
+
+static const uint64_t kMinute = 60 * 1000;
+
+
+static void results(PoolSelector &selector, size_t index, uint64_t elapsed, int count)
+{
+    for (int i = 0; i < count; ++i) {
+        selector.onResult(index, elapsed, false);
+    }
+}
+
+
+void test_prev_hash_should_SkipVarints(void)
+{
+    uint8_t hash[32];
+
+    TEST_ASSERT_TRUE(PoolSelector::prevHash(blob, sizeof(blob), hash));
+    TEST_ASSERT_EQUAL_MEMORY(blob + 7, hash, 32);
+
+    TEST_ASSERT_FALSE(PoolSelector::prevHash(blob, 38, hash));
+}
+
+
+void test_select_should_PickCheapestReadyPool(void)
+{
+    PoolSelector selector(3);
+    selector.onLogin(0, 300);
+    selector.onLogin(1, 50);
+    selector.onLogin(2, 10);
+
+    TEST_ASSERT_EQUAL(1, selector.select(-1, { true, true, false }, 0));
+    TEST_ASSERT_EQUAL(-1, selector.select(-1, { false, false, false }, 0));
+}
+
+
+void test_select_should_SwitchImmediatelyFromLostPool(void)
+{
+    PoolSelector selector(2);
+    selector.onLogin(0, 10);
+    selector.onLogin(1, 500);
+
+    TEST_ASSERT_EQUAL(1, selector.select(0, { false, true }, 0));
+}
+
+
+void test_select_should_ApplyHysteresis(void)
+{
+    PoolSelector selector(2);
+    selector.onLogin(0, 100);
+    selector.onLogin(1, 90);
+    selector.onSwitch(0);
+
+    TEST_ASSERT_EQUAL(0, selector.select(0, { true, true }, 10 * kMinute));
+}
+
+
+void test_select_should_HoldCandidateAndRespectDwell(void)
+{
+    PoolSelector selector(2);
+    selector.onLogin(1, 40);
+    results(selector, 0, 200, 10);
+    selector.onSwitch(0);
+
+    TEST_ASSERT_EQUAL(0, selector.select(0, { true, true }, 1 * kMinute));
+    TEST_ASSERT_EQUAL(0, selector.select(0, { true, true }, 2 * kMinute + 1));
+    TEST_ASSERT_EQUAL(0, selector.select(0, { true, true }, 4 * kMinute));
+    TEST_ASSERT_EQUAL(1, selector.select(0, { true, true }, 5 * kMinute));
+}
+
+
+void test_lag_should_MeasureLateBlockNotification(void)
+{
+    PoolSelector selector(2);
+
+    selector.onJob(0, blob, sizeof(blob), 1000);
+    selector.onJob(1, blob, sizeof(blob), 1300);
+    selector.onJob(1, blob, sizeof(blob), 5000);
+
+    TEST_ASSERT_EQUAL(0, (int) selector.metrics(0).lag);
+    TEST_ASSERT_EQUAL(300, (int) selector.metrics(1).lag);
+}
+
+
+void test_rejects_should_RaiseCost(void)
+{
+    PoolSelector selector(2);
+    results(selector, 0, 50, 10);
+    results(selector, 1, 100, 10);
+
+    for (int i = 0; i < 5; ++i) {
+        selector.onResult(0, 50, true);
+    }
+
+    TEST_ASSERT_TRUE(selector.metrics(0).rejects > 0.05);
+    TEST_ASSERT_TRUE(selector.metrics(0).cost() > selector.metrics(1).cost());
+    TEST_ASSERT_EQUAL(1, selector.select(-1, { true, true }, 0));
+}
+
+
+int main(void)
+{
+    UNITY_BEGIN();
+
+    RUN_TEST(test_prev_hash_should_SkipVarints);
+    RUN_TEST(test_select_should_PickCheapestReadyPool);
+    RUN_TEST(test_select_should_SwitchImmediatelyFromLostPool);
+    RUN_TEST(test_select_should_ApplyHysteresis);
+    RUN_TEST(test_select_should_HoldCandidateAndRespectDwell);
+    RUN_TEST(test_lag_should_MeasureLateBlockNotification);
+    RUN_TEST(test_rejects_should_RaiseCost);
+
+    return UNITY_END();
+}
@@ -0,0 +1,138 @@
+#include <unity.h>
+#include <algorithm>
+#include <stdlib.h>
+#include <string.h>
+#include <string>
+#include <vector>
+
+#include "net/RecvBuffer.h"
+
+
+/**
+ * Same steps as Client::onAllocBuffer and Client::onRead, the socket returns at most chunk bytes per read.
+ */
+static size_t feed(RecvBuffer &buffer, const char *data, size_t size, std::vector<std::string> &lines)
+{
+    size_t space = 0;
+    char *dst    = buffer.reserve(space);
+    if (space == 0) {
+        return 0;
+    }
+
+    if (size > space) {
+        size = space;
+    }
+
+    memcpy(dst, data, size);
+    buffer.commit(size);
+
+    char *line;
+    size_t len;
+
+    while ((line = buffer.next(len)) != nullptr) {
+        lines.push_back(std::string(line, len));
+    }
+
+    return size;
+}
+
+
+static std::string message(size_t size, unsigned seed)
+{
+    std::string line = "{\"id\":" + std::to_string(seed) + ",\"blob\":\"";
+    while (line.size() + 3 < size) {
+        line += "0123456789abcdef"[(seed + line.size()) & 15];
+    }
+
+    return line + "\"}\n";
+}
+
+
+void test_fragmented_and_coalesced_frames_should_ProduceSameLines(void)
+{
+    srand(42);
+
+    for (int round = 0; round < 200; ++round) {
+        RecvBuffer buffer(64 * 1024);
+        std::vector<std::string> expected;
+        std::vector<std::string> actual;
+        std::string stream;
+
+        for (int i = 0; i < 50; ++i) {
+            const size_t size = (rand() % 8 == 0) ? 4000 + rand() % 30000 : 16 + rand() % 600;
+            expected.push_back(message(size, (unsigned) rand()));
+            stream += expected.back();
+        }
+
+        size_t pos = 0;
+        while (pos < stream.size()) {
+            const int kind     = rand() % 3;
+            const size_t chunk = kind == 0 ? 1 + rand() % 8 : (kind == 1 ? 1 + rand() % 1500 : 1 + rand() % 65536);
+            const size_t written = feed(buffer, stream.data() + pos, std::min(chunk, stream.size() - pos), actual);
+
+            TEST_ASSERT_TRUE(written > 0);
+            pos += written;
+        }
+
+        TEST_ASSERT_EQUAL(0, buffer.size());
+        TEST_ASSERT_EQUAL(expected.size(), actual.size());
+
+        for (size_t i = 0; i < expected.size(); ++i) {
+            TEST_ASSERT_TRUE(expected[i] == actual[i]);
+        }
+
+        TEST_ASSERT_TRUE(buffer.capacity() <= buffer.maxSize());
+    }
+}
+
+
+void test_oversized_line_should_Overflow(void)
+{
+    RecvBuffer buffer(8 * 1024);
+    std::vector<std::string> lines;
+    const std::string line = message(9000, 1);
+
+    size_t pos = 0;
+    size_t written;
+    while (pos < line.size() && (written = feed(buffer, line.data() + pos, line.size() - pos, lines)) > 0) {
+        pos += written;
+    }
+
+    TEST_ASSERT_EQUAL(8 * 1024, buffer.size());
+    TEST_ASSERT_EQUAL(0, lines.size());
+
+    buffer.reset();
+    TEST_ASSERT_EQUAL(3, feed(buffer, "{}\n", 3, lines));
+    TEST_ASSERT_EQUAL(1, lines.size());
+}
+
+
+void test_line_at_max_size_should_Fit(void)
+{
+    RecvBuffer buffer(8 * 1024);
+    std::vector<std::string> lines;
+    const std::string line = message(8 * 1024, 2);
+
+    size_t pos = 0;
+    while (pos < line.size()) {
+        const size_t written = feed(buffer, line.data() + pos, std::min<size_t>(100, line.size() - pos), lines);
+
+        TEST_ASSERT_TRUE(written > 0);
+        pos += written;
+    }
+
+    TEST_ASSERT_EQUAL(1, lines.size());
+    TEST_ASSERT_TRUE(line == lines[0]);
+}
+
+
+int main(void)
+{
+    UNITY_BEGIN();
+
+    RUN_TEST(test_fragmented_and_coalesced_frames_should_ProduceSameLines);
+    RUN_TEST(test_oversized_line_should_Overflow);
+    RUN_TEST(test_line_at_max_size_should_Fit);
+
+    return UNITY_END();
+}
@@ -0,0 +1,125 @@
+#include <unity.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "log/Log.h"
+#include "State.h"
+
+
+static const char *kFileName = "state_test.json";
+
+
+void setUp(void)
+{
+    remove(kFileName);
+}
+
+
+void test_load_should_FailWithoutFile(void)
+{
+    State::Data data;
+
+    TEST_ASSERT_FALSE(State::load(kFileName, data));
+    TEST_ASSERT_EQUAL_UINT64(0, data.accepted);
+}
+
+
+void test_save_should_RoundTrip(void)
+{
+    State::Data data;
+    snprintf(data.build, sizeof(data.build), "0123456789abcdef");
+    snprintf(data.cpu, sizeof(data.cpu), "Test CPU");
+    snprintf(data.pool, sizeof(data.pool), "pool.example.com:3333");
+    data.algo         = 1;
+    data.av           = 1;
+    data.threads      = 4;
+    data.tunedAv      = 3;
+    data.tunedThreads = 3;
+    data.highest      = 512.5;
+    data.average      = 480.25;
+    data.accepted     = 1000;
+    data.rejected     = 7;
+    data.total        = 5000000;
+    data.failures     = 2;
+    data.jobs         = 300;
+    data.topDiff[0]   = 900000;
+    data.topDiff[9]   = 1;
+    data.verified     = 0x55;
+
+    TEST_ASSERT_TRUE(State::save(kFileName, data));
+
+    State::Data loaded;
+    TEST_ASSERT_TRUE(State::load(kFileName, loaded));
+
+    TEST_ASSERT_EQUAL_STRING("Test CPU", loaded.cpu);
+    TEST_ASSERT_EQUAL_STRING("pool.example.com:3333", loaded.pool);
+    TEST_ASSERT_EQUAL(3, loaded.tunedAv);
+    TEST_ASSERT_EQUAL(3, loaded.tunedThreads);
+    TEST_ASSERT_EQUAL_FLOAT(512.5, loaded.highest);
+    TEST_ASSERT_EQUAL_FLOAT(480.25, loaded.average);
+    TEST_ASSERT_EQUAL_UINT64(1000, loaded.accepted);
+    TEST_ASSERT_EQUAL_UINT64(7, loaded.rejected);
+    TEST_ASSERT_EQUAL_UINT64(5000000, loaded.total);
+    TEST_ASSERT_EQUAL_UINT64(2, loaded.failures);
+    TEST_ASSERT_EQUAL_UINT64(300, loaded.jobs);
+    TEST_ASSERT_EQUAL_UINT64(900000, loaded.topDiff[0]);
+    TEST_ASSERT_EQUAL_UINT64(1, loaded.topDiff[9]);
+    TEST_ASSERT_EQUAL_STRING("0123456789abcdef", loaded.build);
+    TEST_ASSERT_EQUAL_HEX32(0x55, loaded.verified);
+}
+
+
+void test_isTuned_should_RequireSameEnvironment(void)
+{
+    State::Data data;
+    snprintf(data.cpu, sizeof(data.cpu), "Test CPU");
+    data.algo         = 0;
+    data.av           = 1;
+    data.threads      = 4;
+    data.tunedAv      = 3;
+    data.tunedThreads = 2;
+
+    TEST_ASSERT_TRUE(data.isTuned(0, "Test CPU", 1, 4));
+    TEST_ASSERT_FALSE(data.isTuned(1, "Test CPU", 1, 4));
+    TEST_ASSERT_FALSE(data.isTuned(0, "Other CPU", 1, 4));
+    TEST_ASSERT_FALSE(data.isTuned(0, "Test CPU", 2, 4));
+    TEST_ASSERT_FALSE(data.isTuned(0, "Test CPU", 1, 8));
+
+    data.tunedThreads = 0;
+    TEST_ASSERT_FALSE(data.isTuned(0, "Test CPU", 1, 4));
+}
+
+
+void test_load_should_IgnoreCorruptFile(void)
+{
+    FILE *fp = fopen(kFileName, "wb");
+    fputs("{\"version\": 1, \"results\": {\"accepted\": 5", fp);
+    fclose(fp);
+
+    State::Data data;
+    TEST_ASSERT_FALSE(State::load(kFileName, data));
+
+    fp = fopen(kFileName, "wb");
+    fputs("{\"version\": 99, \"results\": {\"accepted\": 5}}", fp);
+    fclose(fp);
+
+    TEST_ASSERT_FALSE(State::load(kFileName, data));
+    TEST_ASSERT_EQUAL_UINT64(0, data.accepted);
+}
+
+
+int main(void)
+{
+    Log::init();
+
+    UNITY_BEGIN();
+
+    RUN_TEST(test_load_should_FailWithoutFile);
+    RUN_TEST(test_save_should_RoundTrip);
+    RUN_TEST(test_isTuned_should_RequireSameEnvironment);
+    RUN_TEST(test_load_should_IgnoreCorruptFile);
+
+    remove(kFileName);
+
+    return UNITY_END();
+}
@@ -0,0 +1,163 @@
+#include <unity.h>
+#include <string.h>
+
+#include "net/StratumParser.h"
+#include "rapidjson/document.h"
+#include "traffic.h"
+
+
+static char buf[4096];
+
+
+static char *copy(const char *line)
+{
+    strncpy(buf, line, sizeof(buf) - 1);
+    return buf;
+}
+
+
+void test_job_notification_should_ExtractFields(void)
+{
+    char *line = copy("{\"jsonrpc\":\"2.0\",\"method\":\"job\",\"params\":{\"blob\":\"0505\",\"job_id\":\"abc\",\"target\":\"b88d0600\"}}");
+    StratumMessage message;
+
+    TEST_ASSERT_TRUE(StratumParser::parse(line, strlen(line), message));
+    TEST_ASSERT_FALSE(message.hasId);
+    TEST_ASSERT_TRUE(message.job.valid);
+    TEST_ASSERT_EQUAL_STRING("job", message.method);
+    TEST_ASSERT_EQUAL_STRING("0505", message.job.blob);
+    TEST_ASSERT_EQUAL_STRING("abc", message.job.id);
+    TEST_ASSERT_EQUAL_STRING("b88d0600", message.job.target);
+}
+
+
+void test_login_result_should_ExtractJob(void)
+{
+    char *line = copy(traffic[0]);
+    StratumMessage message;
+
+    TEST_ASSERT_TRUE(StratumParser::parse(line, strlen(line), message));
+    TEST_ASSERT_TRUE(message.hasId);
+    TEST_ASSERT_EQUAL_INT(1, (int) message.id);
+    TEST_ASSERT_TRUE(message.hasResult);
+    TEST_ASSERT_FALSE(message.hasError);
+    TEST_ASSERT_EQUAL_STRING("e8b6b6f0-7b5a-4f0e-8cbb-43b3c2d1a8e1", message.loginId);
+    TEST_ASSERT_EQUAL_STRING("OK", message.status);
+    TEST_ASSERT_TRUE(message.job.valid);
+    TEST_ASSERT_EQUAL_INT(152, (int) strlen(message.job.blob));
+    TEST_ASSERT_EQUAL_STRING("b88d0600", message.job.target);
+}
+
+
+void test_error_response_should_ExtractCodeAndMessage(void)
+{
+    char *line = copy("{\"id\":3,\"jsonrpc\":\"2.0\",\"error\":{\"code\":-1,\"message\":\"Low difficulty share\"}}");
+    StratumMessage message;
+
+    TEST_ASSERT_TRUE(StratumParser::parse(line, strlen(line), message));
+    TEST_ASSERT_TRUE(message.hasId);
+    TEST_ASSERT_EQUAL_INT(3, (int) message.id);
+    TEST_ASSERT_TRUE(message.hasError);
+    TEST_ASSERT_FALSE(message.hasResult);
+    TEST_ASSERT_EQUAL_INT(-1, message.errorCode);
+    TEST_ASSERT_EQUAL_STRING("Low difficulty share", message.errorMessage);
+}
+
+
+void test_escaped_string_should_FallBackWithBufferIntact(void)
+{
+    const char *source = "{\"id\":5,\"error\":{\"code\":-1,\"message\":\"bad \\\"nonce\\\"\"}}";
+    char *line = copy(source);
+    StratumMessage message;
+
+    TEST_ASSERT_FALSE(StratumParser::parse(line, strlen(line), message));
+    TEST_ASSERT_EQUAL_STRING(source, line);
+
+    rapidjson::Document doc;
+    TEST_ASSERT_FALSE(doc.ParseInsitu(line).HasParseError());
+
+    StratumParser::parse(doc, message);
+    TEST_ASSERT_TRUE(message.hasError);
+    TEST_ASSERT_EQUAL_STRING("bad \"nonce\"", message.errorMessage);
+}
+
+
+void test_malformed_line_should_FallBack(void)
+{
+    const char *lines[] = {
+        "{\"id\":1,\"result\":{\"status\":\"OK\"}",
+        "{\"id\":\"1\",\"result\":null}",
+        "{\"id\":1.5}",
+        "[1,2,3]",
+        "{\"id\":1} trailing",
+        ""
+    };
+
+    for (const char *source : lines) {
+        char *line = copy(source);
+        StratumMessage message;
+
+        TEST_ASSERT_FALSE(StratumParser::parse(line, strlen(line), message));
+        TEST_ASSERT_EQUAL_STRING(source, line);
+    }
+}
+
+
+void test_traffic_should_MatchDom(void)
+{
+    static char dom[4096];
+
+    for (const char *source : traffic) {
+        StratumMessage fast;
+        StratumMessage slow;
+
+        char *line = copy(source);
+        TEST_ASSERT_TRUE(StratumParser::parse(line, strlen(line), fast));
+
+        strncpy(dom, source, sizeof(dom) - 1);
+        rapidjson::Document doc;
+        TEST_ASSERT_FALSE(doc.ParseInsitu(dom).HasParseError());
+        StratumParser::parse(doc, slow);
+
+        TEST_ASSERT_EQUAL(slow.hasId, fast.hasId);
+        TEST_ASSERT_EQUAL(slow.hasError, fast.hasError);
+        TEST_ASSERT_EQUAL(slow.hasResult, fast.hasResult);
+        TEST_ASSERT_EQUAL(slow.job.valid, fast.job.valid);
+        TEST_ASSERT_EQUAL_INT((int) slow.id, (int) fast.id);
+        TEST_ASSERT_EQUAL_INT(slow.errorCode, fast.errorCode);
+
+        const char *fields[][2] = {
+            { slow.method, fast.method },
+            { slow.loginId, fast.loginId },
+            { slow.status, fast.status },
+            { slow.errorMessage, fast.errorMessage },
+            { slow.job.id, fast.job.id },
+            { slow.job.blob, fast.job.blob },
+            { slow.job.target, fast.job.target }
+        };
+
+        for (const auto &field : fields) {
+            if (!field[0] || !field[1]) {
+                TEST_ASSERT_TRUE(field[0] == field[1]);
+                continue;
+            }
+
+            TEST_ASSERT_EQUAL_STRING(field[0], field[1]);
+        }
+    }
+}
+
+
+int main(void)
+{
+    UNITY_BEGIN();
+
+    RUN_TEST(test_job_notification_should_ExtractFields);
+    RUN_TEST(test_login_result_should_ExtractJob);
+    RUN_TEST(test_error_response_should_ExtractCodeAndMessage);
+    RUN_TEST(test_escaped_string_should_FallBackWithBufferIntact);
+    RUN_TEST(test_malformed_line_should_FallBack);
+    RUN_TEST(test_traffic_should_MatchDom);
+
+    return UNITY_END();
+}
@@ -0,0 +1,58 @@
+#include <chrono>
+#include <stdio.h>
+#include <string.h>
+
+#include "net/StratumParser.h"
+#include "rapidjson/document.h"
+#include "traffic.h"
+
+
+static const int kIterations = 200000;
+
+
+template<typename Parse>
+static double measure(Parse parse)
+{
+    static char buf[4096];
+    const size_t count = sizeof(traffic) / sizeof(traffic[0]);
+    size_t len[count];
+
+    for (size_t i = 0; i < count; ++i) {
+        len[i] = strlen(traffic[i]);
+    }
+
+    const auto start = std::chrono::steady_clock::now();
+
+    for (int n = 0; n < kIterations; ++n) {
+        const size_t i = n % count;
+        memcpy(buf, traffic[i], len[i] + 1);
+        parse(buf, len[i]);
+    }
+
+    const auto elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start);
+    return (double) elapsed.count() / kIterations;
+}
+
+
+int main(void)
+{
+    StratumMessage message;
+
+    const double copy = measure([](char *, size_t) {});
+
+    const double fast = measure([&message](char *line, size_t len) {
+        StratumParser::parse(line, len, message);
+    });
+
+    const double dom = measure([&message](char *line, size_t) {
+        rapidjson::Document doc;
+        doc.ParseInsitu(line);
+        StratumParser::parse(doc, message);
+    });
+
+    printf("stratum parser: %.1f ns/line\n", fast - copy);
+    printf("rapidjson DOM:  %.1f ns/line\n", dom - copy);
+    printf("speedup:        %.2fx\n", (dom - copy) / (fast - copy));
+
+    return 0;
+}
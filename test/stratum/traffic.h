@@ -0,0 +1,19 @@
+#ifndef __TRAFFIC_H__
+#define __TRAFFIC_H__
+
+
+/* Pool and proxy traffic: login, job notifications, submit responses, error and job with extra fields. */
+static const char *traffic[] = {
+    "{\"id\":1,\"jsonrpc\":\"2.0\",\"error\":null,\"result\":{\"id\":\"e8b6b6f0-7b5a-4f0e-8cbb-43b3c2d1a8e1\",\"job\":{\"blob\":\"0305a0dbd6bf05cf16e503f3a66f78007cbf34144332ecbfc22ed95c8700383b309ace1923a0964b000000a4c123b1612dd272d1371c17149d439536b3216fdaeeb975729fae923d5a4fd101\",\"job_id\":\"9EHI+W8byY87DVANI2XJle+7rAgvOO+a\",\"target\":\"b88d0600\"},\"status\":\"OK\"}}",
+    "{\"jsonrpc\":\"2.0\",\"method\":\"job\",\"params\":{\"blob\":\"0305a0dbd6bf05cf16e503f3a66f78007cbf34144332ecbfc22ed95c8700383b309ace1923a0964b0000005ec84d8dbc74254770f58904dba41ecccc3fc1626e53a13043b026c48bbf33fe01\",\"job_id\":\"ZZDaidHxZk2qKi3CbxKlJsGsouPtp+J3\",\"target\":\"b88d0600\"}}",
+    "{\"jsonrpc\":\"2.0\",\"method\":\"job\",\"params\":{\"blob\":\"0305a0dbd6bf05cf16e503f3a66f78007cbf34144332ecbfc22ed95c8700383b309ace1923a0964b00000008f86bebb2737f6a6f0fb23c6f5da2cec255404e4fb440034d6608697a8d41be01\",\"job_id\":\"Rgj2Un0jmiYf7FZd7voz5cV38UFpzVZv\",\"target\":\"711b0d00\"}}",
+    "{\"jsonrpc\":\"2.0\",\"method\":\"job\",\"params\":{\"blob\":\"0305a0dbd6bf05cf16e503f3a66f78007cbf34144332ecbfc22ed95c8700383b309ace1923a0964b00000086e4d3cea27d26934b484e73cf575dcad6ba2b0aee0ca923732881584d8c4fa201\",\"job_id\":\"z7nS9y2bxas8xfW1HRyg5uekx6npDDqB\",\"target\":\"b88d0600\"}}",
+    "{\"jsonrpc\":\"2.0\",\"method\":\"job\",\"params\":{\"blob\":\"0305a0dbd6bf05cf16e503f3a66f78007cbf34144332ecbfc22ed95c8700383b309ace1923a0964b000000e58b081006f7e3dfc967a64cb14028d512c9791e558e08baa7196b50ac2f867001\",\"job_id\":\"bxbiP5O2CCtajNF+jAi5Sh2ta35hKdMV\",\"target\":\"e4a63d00\"}}",
+    "{\"id\":2,\"jsonrpc\":\"2.0\",\"error\":null,\"result\":{\"status\":\"OK\"}}",
+    "{\"id\":3,\"jsonrpc\":\"2.0\",\"error\":{\"code\":-1,\"message\":\"Low difficulty share\"}}",
+    "{\"id\":4,\"jsonrpc\":\"2.0\",\"error\":null,\"result\":{\"status\":\"KEEPALIVED\"}}",
+    "{\"jsonrpc\":\"2.0\",\"method\":\"job\",\"params\":{\"blob\":\"0305a0dbd6bf05cf16e503f3a66f78007cbf34144332ecbfc22ed95c8700383b309ace1923a0964b000000107f80e222f828767efc2f91624a8940f1f836f99eee3692f09e2e8c662248b401\",\"job_id\":\"zeKt+/O3k0/VPCiRIMEfG0FHOfp1BwL8\",\"target\":\"b88d0600\",\"algo\":\"cn\",\"variant\":1,\"height\":1512345,\"extra\":{\"nonces\":[0,1,2]}}}"
+};
+
+
+#endif /* __TRAFFIC_H__ */
@@ -0,0 +1,84 @@
+#include <unity.h>
+
+#include "workers/ThreadGroups.h"
+
+
+static int count(const std::vector<int> &groups, int group)
+{
+    int result = 0;
+    for (int g : groups) {
+        result += g == group ? 1 : 0;
+    }
+
+    return result;
+}
+
+
+void test_assign_should_SplitByWeight(void)
+{
+    std::vector<int> groups;
+    ThreadGroups::assign({ 3, 1 }, 8, groups);
+
+    TEST_ASSERT_EQUAL(8, groups.size());
+    TEST_ASSERT_EQUAL(6, count(groups, 0));
+    TEST_ASSERT_EQUAL(2, count(groups, 1));
+}
+
+
+void test_assign_should_KeepGroupsContiguous(void)
+{
+    std::vector<int> groups;
+    ThreadGroups::assign({ 1, 1, 1 }, 6, groups);
+
+    const int expected[] = { 0, 0, 1, 1, 2, 2 };
+    TEST_ASSERT_EQUAL_INT_ARRAY(expected, groups.data(), 6);
+}
+
+
+void test_assign_should_GiveEachWeightedGroupAThread(void)
+{
+    std::vector<int> groups;
+    ThreadGroups::assign({ 100, 1, 0, 1 }, 4, groups);
+
+    TEST_ASSERT_EQUAL(2, count(groups, 0));
+    TEST_ASSERT_EQUAL(1, count(groups, 1));
+    TEST_ASSERT_EQUAL(0, count(groups, 2));
+    TEST_ASSERT_EQUAL(1, count(groups, 3));
+}
+
+
+void test_assign_should_PreferHeavierGroupsWhenThreadsAreFew(void)
+{
+    std::vector<int> groups;
+    ThreadGroups::assign({ 1, 5, 2 }, 2, groups);
+
+    TEST_ASSERT_EQUAL(0, count(groups, 0));
+    TEST_ASSERT_EQUAL(1, count(groups, 1));
+    TEST_ASSERT_EQUAL(1, count(groups, 2));
+}
+
+
+void test_assign_should_ReturnNoGroupForZeroWeights(void)
+{
+    std::vector<int> groups;
+    ThreadGroups::assign({ 0, 0 }, 3, groups);
+
+    TEST_ASSERT_EQUAL(3, count(groups, -1));
+
+    ThreadGroups::assign({}, 2, groups);
+    TEST_ASSERT_EQUAL(2, count(groups, -1));
+}
+
+
+int main(void)
+{
+    UNITY_BEGIN();
+
+    RUN_TEST(test_assign_should_SplitByWeight);
+    RUN_TEST(test_assign_should_KeepGroupsContiguous);
+    RUN_TEST(test_assign_should_GiveEachWeightedGroupAThread);
+    RUN_TEST(test_assign_should_PreferHeavierGroupsWhenThreadsAreFew);
+    RUN_TEST(test_assign_should_ReturnNoGroupForZeroWeights);
+
+    return UNITY_END();
+}